@@ -0,0 +1,186 @@
+//
+// bench/bench_arithmetic.c
+//
+// This file measures sbfp16_add_n, sbfp16_sub_n and sbfp16_mul_n against loops over the
+// scalar sbfp_add, sbfp_sub and sbfp_mul, with whichever backend is in use (see
+// sbfp_backend). The operands are contiguous normal values from 2^-7 to 2^7, and the arrays
+// stay in the L1 cache. The SBFP_BACKEND environment variable selects the backend to
+// measure.
+//
+// Build and run from the repository root:
+//
+//     cc -O2 -I. bench/bench_arithmetic.c sbfp_lib.c sbfp_fp8.c sbfp_bf16.c sbfp_x86.c -lm -o bench_arithmetic
+//     SBFP_BACKEND=avx2 ./bench_arithmetic
+//
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2021 Luke Andrews.  All Rights Reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify, merge,
+// publish, distribute, sub-license, and/or sell copies of the Software, and to permit persons
+// to whom the Software is furnished to do so, subject to the following conditions:
+//
+// * The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+// PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+#include "sbfp_const.h"
+#include "sbfp_lib.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+// Elements per array, passes over the arrays per timing, and timings per measurement:
+#define BENCH_COUNT  4096
+#define BENCH_PASSES 200
+#define BENCH_REPEAT 15
+
+static sbfp16_t benchValues1[BENCH_COUNT];
+static sbfp16_t benchValues2[BENCH_COUNT];
+static sbfp16_t benchResults[BENCH_COUNT];
+
+//
+// Gives the current time.
+//
+// Returns the time in seconds.
+//
+static double seconds(void)
+{
+	struct timespec time;
+
+	timespec_get(&time, TIME_UTC);
+
+	return (double)time.tv_sec + (double)time.tv_nsec * 1e-9;
+}
+
+//
+// Measures one pass over the arrays, as the best of BENCH_REPEAT timings.
+//
+// [in] pass - the pass
+//
+// Returns the time per element in nanoseconds.
+//
+static double measure(void (*pass)(void))
+{
+	double best = 1e30;
+
+	for (int repeat = 0; repeat < BENCH_REPEAT; ++repeat)
+	{
+		double start = seconds();
+
+		for (int count = 0; count < BENCH_PASSES; ++count)
+		{
+			pass();
+		}
+
+		double elapsed = (seconds() - start) / ((double)BENCH_PASSES * BENCH_COUNT) * 1e9;
+
+		if (elapsed < best)
+		{
+			best = elapsed;
+		}
+	}
+
+	return best;
+}
+
+//
+// The passes, each operating on the arrays once with a scalar loop or a bulk function:
+//
+static void scalar_add(void)
+{
+	for (size_t index = 0; index < BENCH_COUNT; ++index)
+	{
+		benchResults[index] = (sbfp16_t)sbfp_add(benchValues1[index], benchValues2[index]);
+	}
+}
+
+static void bulk_add(void)
+{
+	sbfp16_add_n(benchValues1, 1, benchValues2, 1, benchResults, 1, BENCH_COUNT);
+}
+
+static void scalar_sub(void)
+{
+	for (size_t index = 0; index < BENCH_COUNT; ++index)
+	{
+		benchResults[index] = (sbfp16_t)sbfp_sub(benchValues1[index], benchValues2[index]);
+	}
+}
+
+static void bulk_sub(void)
+{
+	sbfp16_sub_n(benchValues1, 1, benchValues2, 1, benchResults, 1, BENCH_COUNT);
+}
+
+static void scalar_mul(void)
+{
+	for (size_t index = 0; index < BENCH_COUNT; ++index)
+	{
+		benchResults[index] = (sbfp16_t)sbfp_mul(benchValues1[index], benchValues2[index]);
+	}
+}
+
+static void bulk_mul(void)
+{
+	sbfp16_mul_n(benchValues1, 1, benchValues2, 1, benchResults, 1, BENCH_COUNT);
+}
+
+int main(void)
+{
+	static const struct
+	{
+		const char *name;
+		void (*scalar)(void);
+		void (*bulk)(void);
+	}
+	operations[] =
+	{
+		{ "add", scalar_add, bulk_add },
+		{ "sub", scalar_sub, bulk_sub },
+		{ "mul", scalar_mul, bulk_mul }
+	};
+
+	//
+	// Normal values with random signs and fracs, and expos from 2^-7 to 2^7:
+	//
+	uint64_t random = 1;
+
+	for (size_t index = 0; index < BENCH_COUNT; ++index)
+	{
+		sbfp16_t *values[] = { &benchValues1[index], &benchValues2[index] };
+
+		for (int operand = 0; operand < 2; ++operand)
+		{
+			random = random * 6364136223846793005ULL + 1442695040888963407ULL;
+
+			int sign = (int)(random >> 63);
+			int expo = SBFP_BIAS - 7 + (int)((random >> 32) % 15);
+			int frac = (int)(random >> 40) & SBFP_FRAC_MASK;
+
+			*values[operand] = (sbfp16_t)((sign << (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC)) | (expo << SBFP_BIT_COUNT_FRAC) | frac);
+		}
+	}
+
+	printf("backend %s, ns per element\n", sbfp_backend());
+	printf("%-9s %8s %8s %8s\n", "operation", "scalar", "bulk", "speedup");
+
+	for (size_t operation = 0; operation < sizeof(operations) / sizeof(operations[0]); ++operation)
+	{
+		double scalar = measure(operations[operation].scalar);
+		double bulk   = measure(operations[operation].bulk);
+
+		printf("%-9s %8.3f %8.3f %7.1fx\n", operations[operation].name, scalar, bulk, scalar / bulk);
+	}
+
+	return 0;
+}
@@ -0,0 +1,222 @@
+//
+// bench/bench_conversions.c
+//
+// This file measures the bulk conversions between double, float and sbfp against loops
+// over the scalar conversions, with whichever backend is in use (see sbfp_backend). The
+// arrays stay in the L1 cache, so the numbers are the cost of the conversions alone. The
+// SBFP_BACKEND environment variable selects the backend to measure.
+//
+// Build and run from the repository root:
+//
+//     cc -O2 -I. bench/bench_conversions.c sbfp_lib.c sbfp_fp8.c sbfp_bf16.c sbfp_x86.c -lm -o bench_conversions
+//     SBFP_BACKEND=avx2 ./bench_conversions
+//
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2021 Luke Andrews.  All Rights Reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify, merge,
+// publish, distribute, sub-license, and/or sell copies of the Software, and to permit persons
+// to whom the Software is furnished to do so, subject to the following conditions:
+//
+// * The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+// PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+#include "sbfp_lib.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+// Elements per array, passes over the arrays per timing, and timings per measurement:
+#define BENCH_COUNT  4096
+#define BENCH_PASSES 200
+#define BENCH_REPEAT 15
+
+static double   benchDoubles[BENCH_COUNT];
+static float    benchFloats[BENCH_COUNT];
+static sbfp_t   benchValues[BENCH_COUNT];
+static sbfp16_t benchValues16[BENCH_COUNT];
+
+//
+// Gives the current time.
+//
+// Returns the time in seconds.
+//
+static double seconds(void)
+{
+	struct timespec time;
+
+	timespec_get(&time, TIME_UTC);
+
+	return (double)time.tv_sec + (double)time.tv_nsec * 1e-9;
+}
+
+//
+// Measures one pass over the arrays, as the best of BENCH_REPEAT timings.
+//
+// [in] pass - the pass
+//
+// Returns the time per element in nanoseconds.
+//
+static double measure(void (*pass)(void))
+{
+	double best = 1e30;
+
+	for (int repeat = 0; repeat < BENCH_REPEAT; ++repeat)
+	{
+		double start = seconds();
+
+		for (int count = 0; count < BENCH_PASSES; ++count)
+		{
+			pass();
+		}
+
+		double elapsed = (seconds() - start) / ((double)BENCH_PASSES * BENCH_COUNT) * 1e9;
+
+		if (elapsed < best)
+		{
+			best = elapsed;
+		}
+	}
+
+	return best;
+}
+
+//
+// The passes, each converting the arrays once with a scalar loop or a bulk function:
+//
+static void scalar_double_to_sbfp(void)
+{
+	for (size_t index = 0; index < BENCH_COUNT; ++index)
+	{
+		benchValues[index] = double_to_sbfp(benchDoubles[index]);
+	}
+}
+
+static void bulk_double_to_sbfp(void)
+{
+	double_to_sbfp_n(benchDoubles, 1, benchValues, 1, BENCH_COUNT);
+}
+
+static void scalar_float_to_sbfp(void)
+{
+	for (size_t index = 0; index < BENCH_COUNT; ++index)
+	{
+		benchValues[index] = float_to_sbfp(benchFloats[index]);
+	}
+}
+
+static void bulk_float_to_sbfp(void)
+{
+	float_to_sbfp_n(benchFloats, 1, benchValues, 1, BENCH_COUNT);
+}
+
+static void scalar_double_to_sbfp16(void)
+{
+	for (size_t index = 0; index < BENCH_COUNT; ++index)
+	{
+		benchValues16[index] = (sbfp16_t)double_to_sbfp(benchDoubles[index]);
+	}
+}
+
+static void bulk_double_to_sbfp16(void)
+{
+	double_to_sbfp16_n(benchDoubles, 1, benchValues16, 1, BENCH_COUNT);
+}
+
+static void scalar_float_to_sbfp16(void)
+{
+	for (size_t index = 0; index < BENCH_COUNT; ++index)
+	{
+		benchValues16[index] = (sbfp16_t)float_to_sbfp(benchFloats[index]);
+	}
+}
+
+static void bulk_float_to_sbfp16(void)
+{
+	float_to_sbfp16_n(benchFloats, 1, benchValues16, 1, BENCH_COUNT);
+}
+
+static void scalar_sbfp_to_double(void)
+{
+	for (size_t index = 0; index < BENCH_COUNT; ++index)
+	{
+		benchDoubles[index] = sbfp_to_double(benchValues[index]);
+	}
+}
+
+static void bulk_sbfp_to_double(void)
+{
+	sbfp_to_double_n(benchValues, 1, benchDoubles, 1, BENCH_COUNT);
+}
+
+static void scalar_sbfp_to_float(void)
+{
+	for (size_t index = 0; index < BENCH_COUNT; ++index)
+	{
+		benchFloats[index] = sbfp_to_float(benchValues[index]);
+	}
+}
+
+static void bulk_sbfp_to_float(void)
+{
+	sbfp_to_float_n(benchValues, 1, benchFloats, 1, BENCH_COUNT);
+}
+
+int main(void)
+{
+	static const struct
+	{
+		const char *name;
+		void (*scalar)(void);
+		void (*bulk)(void);
+	}
+	conversions[] =
+	{
+		{ "double to sbfp",   scalar_double_to_sbfp,   bulk_double_to_sbfp },
+		{ "float to sbfp",    scalar_float_to_sbfp,    bulk_float_to_sbfp },
+		{ "double to sbfp16", scalar_double_to_sbfp16, bulk_double_to_sbfp16 },
+		{ "float to sbfp16",  scalar_float_to_sbfp16,  bulk_float_to_sbfp16 },
+		{ "sbfp to double",   scalar_sbfp_to_double,   bulk_sbfp_to_double },
+		{ "sbfp to float",    scalar_sbfp_to_float,    bulk_sbfp_to_float }
+	};
+
+	//
+	// Values across the sbfp range, with some subnormal and some below it:
+	//
+	uint64_t random = 1;
+
+	for (size_t index = 0; index < BENCH_COUNT; ++index)
+	{
+		random = random * 6364136223846793005ULL + 1442695040888963407ULL;
+
+		benchDoubles[index] = ldexp((double)(int32_t)(random >> 32), -16 - (int)((random >> 24) % 36));
+		benchFloats[index]  = (float)benchDoubles[index];
+	}
+
+	double_to_sbfp_n(benchDoubles, 1, benchValues, 1, BENCH_COUNT);
+
+	printf("backend %s, ns per element\n", sbfp_backend());
+	printf("%-18s %8s %8s %8s\n", "conversion", "scalar", "bulk", "speedup");
+
+	for (size_t conversion = 0; conversion < sizeof(conversions) / sizeof(conversions[0]); ++conversion)
+	{
+		double scalar = measure(conversions[conversion].scalar);
+		double bulk   = measure(conversions[conversion].bulk);
+
+		printf("%-18s %8.3f %8.3f %7.1fx\n", conversions[conversion].name, scalar, bulk, scalar / bulk);
+	}
+
+	return 0;
+}
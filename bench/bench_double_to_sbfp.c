@@ -0,0 +1,300 @@
+//
+// bench/bench_double_to_sbfp.c
+//
+// This file measures the scalar double_to_sbfp against the original one, which halved the
+// value until it lay in [1, 2) and extracted the fraction bit by bit. The original code is
+// kept here unchanged, apart from its name. It truncated, so it is checked to give the
+// same bits as double_to_sbfp_round with SBFP_ROUND_TRUNCATE for every input, and both are
+// timed, as is the default double_to_sbfp, which rounds to nearest even. The inputs lie
+// in [1, 4001), where the original code terminates.
+//
+// Build and run from the repository root:
+//
+//     cc -O2 -I. bench/bench_double_to_sbfp.c sbfp_lib.c sbfp_fp8.c sbfp_bf16.c sbfp_x86.c -lm -o bench_double_to_sbfp
+//     ./bench_double_to_sbfp
+//
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2021 Luke Andrews.  All Rights Reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify, merge,
+// publish, distribute, sub-license, and/or sell copies of the Software, and to permit persons
+// to whom the Software is furnished to do so, subject to the following conditions:
+//
+// * The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+// PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+#include "sbfp_const.h"
+#include "sbfp_lib.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+// Elements per array, passes over the array per timing, and timings per measurement:
+#define BENCH_COUNT  4096
+#define BENCH_PASSES 200
+#define BENCH_REPEAT 15
+
+// The results are volatile, so that the passes over the original code are not optimized away:
+static double          benchDoubles[BENCH_COUNT];
+static volatile sbfp_t benchValues[BENCH_COUNT];
+
+//
+// Extracts the fraction of a given double value and stores it as an integer.
+//
+// [in] value - the double value whose fraction to extract
+//
+// Returns the extracted fraction as an integer.
+//
+static int old_extract_frac(double value)
+{
+	double fracDbl = value - (long)value;
+	int    fracInt = 0;
+
+	for (int count = 0; count < SBFP_BIT_COUNT_FRAC; ++count)
+	{
+		fracInt <<= 1;
+
+		double temp = fracDbl * 2;
+
+		if (temp >= 1.0)
+		{
+			fracInt += 1;
+
+			fracDbl = temp - (long)temp;
+		}
+		else
+		{
+			fracDbl = temp;
+		}
+	}
+
+	return fracInt;
+}
+
+//
+// Converts a given double value to the sbfp_t type.
+//
+// [in] value - the double value to be converted
+//
+// Returns the converted value.
+//
+static sbfp_t old_double_to_sbfp(double dblValue)
+{
+	int status = 0;
+
+	sbfp_t sbfpValue = 0;
+	int    sbfpSign  = 0;
+	int    sbfpExpo  = 0;
+	int    sbfpFrac  =  0;
+
+	//
+	// Extract sign (treating 0 as positive):
+	//
+	if (status == 0)
+	{
+		if (dblValue < 0.0)
+		{
+			sbfpSign = 1; // negative
+			dblValue *= -1.0;
+		}
+		else
+		{
+			sbfpSign = 0; // positive
+		}
+	}
+
+	//
+	// Determine infinity:
+	//
+	unsigned long long dblValueWhole = (unsigned long long)dblValue;
+
+	if (status == 0)
+	{
+		if (dblValueWhole >= (1 << (SBFP_BIAS + 1)))
+		{
+			if (sbfpSign == 1)
+			{
+				sbfpValue = SBFP_NEG_INF;
+			}
+			else
+			{
+				sbfpValue = SBFP_POS_INF;
+			}
+
+			status = 1;
+		}
+	}
+
+	//
+	// Determine if value needs to be denormalized:
+	//
+	bool denormalize  = false;
+
+	if (status == 0)
+	{
+		if (dblValueWhole == 0 &&
+			(dblValue - (long)dblValue) < (((double)((1 << 10) + 1) / (1 << 10)) / (1 << (SBFP_BIAS - 1))))
+		{
+			denormalize = true;
+		}
+	}
+
+	//
+	// Extract expo and frac:
+	//
+	if (status == 0)
+	{
+		if (denormalize)
+		{
+			sbfpExpo = 0;
+			sbfpFrac = old_extract_frac(dblValue * (1 << (SBFP_BIAS - 1)));
+		}
+		else
+		{
+			int E = 0;
+
+			while (!(dblValue < 2 && dblValue >= 1))
+			{
+				dblValue /= 2;
+				++E;
+			}
+
+			sbfpExpo = E + SBFP_BIAS;
+
+			sbfpFrac = old_extract_frac(dblValue);
+		}
+	}
+
+	//
+	// Concatenate sign, expo and frac to the sbfp value, and return:
+	//
+	if (status == 0)
+	{
+		sbfpValue += sbfpSign;
+
+		sbfpValue <<= SBFP_BIT_COUNT_EXPO;
+		sbfpValue += sbfpExpo;
+
+		sbfpValue <<= SBFP_BIT_COUNT_FRAC;
+		sbfpValue += sbfpFrac;
+	}
+
+	return sbfpValue;
+}
+
+//
+// Gives the current time.
+//
+// Returns the time in seconds.
+//
+static double seconds(void)
+{
+	struct timespec time;
+
+	timespec_get(&time, TIME_UTC);
+
+	return (double)time.tv_sec + (double)time.tv_nsec * 1e-9;
+}
+
+//
+// Measures one pass over the array, as the best of BENCH_REPEAT timings.
+//
+// [in] pass - the pass
+//
+// Returns the time per conversion in nanoseconds.
+//
+static double measure(void (*pass)(void))
+{
+	double best = 1e30;
+
+	for (int repeat = 0; repeat < BENCH_REPEAT; ++repeat)
+	{
+		double start = seconds();
+
+		for (int count = 0; count < BENCH_PASSES; ++count)
+		{
+			pass();
+		}
+
+		double elapsed = (seconds() - start) / ((double)BENCH_PASSES * BENCH_COUNT) * 1e9;
+
+		if (elapsed < best)
+		{
+			best = elapsed;
+		}
+	}
+
+	return best;
+}
+
+//
+// The passes, each converting the array once:
+//
+static void pass_old(void)
+{
+	for (size_t index = 0; index < BENCH_COUNT; ++index)
+	{
+		benchValues[index] = old_double_to_sbfp(benchDoubles[index]);
+	}
+}
+
+static void pass_truncate(void)
+{
+	for (size_t index = 0; index < BENCH_COUNT; ++index)
+	{
+		benchValues[index] = double_to_sbfp_round(SBFP_ROUND_TRUNCATE, benchDoubles[index]);
+	}
+}
+
+static void pass_default(void)
+{
+	for (size_t index = 0; index < BENCH_COUNT; ++index)
+	{
+		benchValues[index] = double_to_sbfp(benchDoubles[index]);
+	}
+}
+
+int main(void)
+{
+	//
+	// Values in [1, 4001), with random fractions, and a check that the old and new
+	// truncations agree on them:
+	//
+	uint64_t random = 1;
+	long     failures = 0;
+
+	for (size_t index = 0; index < BENCH_COUNT; ++index)
+	{
+		random = random * 6364136223846793005ULL + 1442695040888963407ULL;
+
+		benchDoubles[index] = 1.0 + (double)(random >> 11) / (double)(1ULL << 53) * 4000.0;
+
+		sbfp_t oldValue = old_double_to_sbfp(benchDoubles[index]);
+		sbfp_t newValue = double_to_sbfp_round(SBFP_ROUND_TRUNCATE, benchDoubles[index]);
+
+		if (oldValue != newValue && failures++ < 20)
+		{
+			printf("%.17g: old 0x%04X, new 0x%04X\n", benchDoubles[index], (unsigned)oldValue, (unsigned)newValue);
+		}
+	}
+
+	printf("ns per conversion\n");
+	printf("original double_to_sbfp          %8.3f\n", measure(pass_old));
+	printf("double_to_sbfp_round, truncating %8.3f\n", measure(pass_truncate));
+	printf("double_to_sbfp, nearest even     %8.3f\n", measure(pass_default));
+	printf("%ld mismatch(es)\n", failures);
+
+	return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,194 @@
+//
+// bench/bench_fma.c
+//
+// This file measures sbfp_fma, which rounds once, against a multiplication followed by an
+// addition, which round twice. Each is timed as a loop over the scalar functions and as the
+// bulk functions, for sbfp_t and for sbfp16_t arrays, with whichever backend is in use (see
+// sbfp_backend). The operands are normal values whose products and sums stay in range, and
+// the arrays stay in the L1 cache. The SBFP_BACKEND environment variable selects the backend
+// to measure.
+//
+// Build and run from the repository root:
+//
+//     cc -O2 -I. bench/bench_fma.c sbfp_lib.c sbfp_fp8.c sbfp_bf16.c sbfp_x86.c -lm -o bench_fma
+//     SBFP_BACKEND=avx2 ./bench_fma
+//
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2021 Luke Andrews.  All Rights Reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify, merge,
+// publish, distribute, sub-license, and/or sell copies of the Software, and to permit persons
+// to whom the Software is furnished to do so, subject to the following conditions:
+//
+// * The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+// PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+#include "sbfp_lib.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+// Elements per array, passes over the arrays per timing, and timings per measurement:
+#define BENCH_COUNT  4096
+#define BENCH_PASSES 200
+#define BENCH_REPEAT 15
+
+static sbfp_t   benchValues1[BENCH_COUNT];
+static sbfp_t   benchValues2[BENCH_COUNT];
+static sbfp_t   benchValues3[BENCH_COUNT];
+static sbfp_t   benchResults[BENCH_COUNT];
+static sbfp16_t benchValues16_1[BENCH_COUNT];
+static sbfp16_t benchValues16_2[BENCH_COUNT];
+static sbfp16_t benchValues16_3[BENCH_COUNT];
+static sbfp16_t benchResults16[BENCH_COUNT];
+
+//
+// Gives the current time.
+//
+// Returns the time in seconds.
+//
+static double seconds(void)
+{
+	struct timespec time;
+
+	timespec_get(&time, TIME_UTC);
+
+	return (double)time.tv_sec + (double)time.tv_nsec * 1e-9;
+}
+
+//
+// Measures one pass over the arrays, as the best of BENCH_REPEAT timings.
+//
+// [in] pass - the pass
+//
+// Returns the time per element in nanoseconds.
+//
+static double measure(void (*pass)(void))
+{
+	double best = 1e30;
+
+	for (int repeat = 0; repeat < BENCH_REPEAT; ++repeat)
+	{
+		double start = seconds();
+
+		for (int count = 0; count < BENCH_PASSES; ++count)
+		{
+			pass();
+		}
+
+		double elapsed = (seconds() - start) / ((double)BENCH_PASSES * BENCH_COUNT) * 1e9;
+
+		if (elapsed < best)
+		{
+			best = elapsed;
+		}
+	}
+
+	return best;
+}
+
+//
+// The passes, each computing value1 * value2 + value3 for the arrays once:
+//
+static void scalar_fma(void)
+{
+	for (size_t index = 0; index < BENCH_COUNT; ++index)
+	{
+		benchResults[index] = sbfp_fma(benchValues1[index], benchValues2[index], benchValues3[index]);
+	}
+}
+
+static void scalar_mul_add(void)
+{
+	for (size_t index = 0; index < BENCH_COUNT; ++index)
+	{
+		benchResults[index] = sbfp_add(sbfp_mul(benchValues1[index], benchValues2[index]), benchValues3[index]);
+	}
+}
+
+static void bulk_fma(void)
+{
+	sbfp_fma_n(benchValues1, 1, benchValues2, 1, benchValues3, 1, benchResults, 1, BENCH_COUNT);
+}
+
+static void bulk_mul_add(void)
+{
+	sbfp_mul_n(benchValues1, 1, benchValues2, 1, benchResults, 1, BENCH_COUNT);
+	sbfp_add_n(benchResults, 1, benchValues3, 1, benchResults, 1, BENCH_COUNT);
+}
+
+static void bulk16_fma(void)
+{
+	sbfp16_fma_n(benchValues16_1, 1, benchValues16_2, 1, benchValues16_3, 1, benchResults16, 1, BENCH_COUNT);
+}
+
+static void bulk16_mul_add(void)
+{
+	sbfp16_mul_n(benchValues16_1, 1, benchValues16_2, 1, benchResults16, 1, BENCH_COUNT);
+	sbfp16_add_n(benchResults16, 1, benchValues16_3, 1, benchResults16, 1, BENCH_COUNT);
+}
+
+int main(void)
+{
+	static const struct
+	{
+		const char *name;
+		void (*fma)(void);
+		void (*mulAdd)(void);
+	}
+	forms[] =
+	{
+		{ "scalar loop",   scalar_fma, scalar_mul_add },
+		{ "sbfp_t bulk",   bulk_fma,   bulk_mul_add },
+		{ "sbfp16_t bulk", bulk16_fma, bulk16_mul_add }
+	};
+
+	//
+	// Normal values with random signs and fracs, and expos from 2^-6 to 2^6:
+	//
+	uint64_t random = 1;
+
+	for (size_t index = 0; index < BENCH_COUNT; ++index)
+	{
+		sbfp_t *values[] = { &benchValues1[index], &benchValues2[index], &benchValues3[index] };
+
+		for (int operand = 0; operand < 3; ++operand)
+		{
+			random = random * 6364136223846793005ULL + 1442695040888963407ULL;
+
+			int sign = (int)(random >> 63);
+			int expo = 9 + (int)((random >> 32) % 13);
+			int frac = (int)(random >> 40) & 0x3FF;
+
+			*values[operand] = (sign << 15) | (expo << 10) | frac;
+		}
+	}
+
+	sbfp_to_sbfp16_n(benchValues1, 1, benchValues16_1, 1, BENCH_COUNT);
+	sbfp_to_sbfp16_n(benchValues2, 1, benchValues16_2, 1, BENCH_COUNT);
+	sbfp_to_sbfp16_n(benchValues3, 1, benchValues16_3, 1, BENCH_COUNT);
+
+	printf("backend %s, ns per element\n", sbfp_backend());
+	printf("%-14s %8s %8s %8s\n", "form", "fma", "mul+add", "ratio");
+
+	for (size_t form = 0; form < sizeof(forms) / sizeof(forms[0]); ++form)
+	{
+		double fma    = measure(forms[form].fma);
+		double mulAdd = measure(forms[form].mulAdd);
+
+		printf("%-14s %8.3f %8.3f %7.2fx\n", forms[form].name, fma, mulAdd, fma / mulAdd);
+	}
+
+	return 0;
+}
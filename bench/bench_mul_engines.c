@@ -0,0 +1,232 @@
+//
+// bench/bench_mul_engines.c
+//
+// This file measures sbfp_mul with each multiplication engine (see sbfp_mul_init) on four
+// workloads: 4096 products of 64 distinct operand pairs, 4096 products of random operands,
+// 32M products of random operands streamed from memory, and a chain of 4096 products in
+// which each multiplicand depends on the previous product. The operands are normal values
+// whose products are normal too, which the table engine looks up.
+//
+// Build and run from the repository root:
+//
+//     cc -O2 -I. bench/bench_mul_engines.c sbfp_lib.c sbfp_fp8.c sbfp_bf16.c sbfp_x86.c -lm -o bench_mul_engines
+//     ./bench_mul_engines
+//
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2021 Luke Andrews.  All Rights Reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify, merge,
+// publish, distribute, sub-license, and/or sell copies of the Software, and to permit persons
+// to whom the Software is furnished to do so, subject to the following conditions:
+//
+// * The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+// PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+#include "sbfp_const.h"
+#include "sbfp_lib.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Elements of the small and the streamed arrays, and timings per measurement:
+#define BENCH_COUNT        4096
+#define BENCH_STREAM_COUNT (32 << 20)
+#define BENCH_REPEAT       15
+
+static sbfp_t   benchRepeated1[BENCH_COUNT];
+static sbfp_t   benchRepeated2[BENCH_COUNT];
+static sbfp_t   benchValues1[BENCH_COUNT];
+static sbfp_t   benchValues2[BENCH_COUNT];
+static sbfp_t   benchResults[BENCH_COUNT];
+static sbfp16_t *benchStream1;
+static sbfp16_t *benchStream2;
+static sbfp16_t *benchStreamResults;
+static volatile sbfp_t benchChainResult;
+
+//
+// Gives the current time.
+//
+// Returns the time in seconds.
+//
+static double seconds(void)
+{
+	struct timespec time;
+
+	timespec_get(&time, TIME_UTC);
+
+	return (double)time.tv_sec + (double)time.tv_nsec * 1e-9;
+}
+
+//
+// Measures a pass over a workload, as the best of BENCH_REPEAT timings.
+//
+// [in] pass   - the pass
+// [in] count  - the number of products in the pass
+// [in] passes - the number of passes per timing
+//
+// Returns the time per product in nanoseconds.
+//
+static double measure(void (*pass)(void), size_t count, int passes)
+{
+	double best = 1e30;
+
+	for (int repeat = 0; repeat < BENCH_REPEAT; ++repeat)
+	{
+		double start = seconds();
+
+		for (int passCount = 0; passCount < passes; ++passCount)
+		{
+			pass();
+		}
+
+		double elapsed = (seconds() - start) / ((double)passes * (double)count) * 1e9;
+
+		if (elapsed < best)
+		{
+			best = elapsed;
+		}
+	}
+
+	return best;
+}
+
+//
+// Gives a random normal sbfp value from 2^-7 up to 2^7, so that products of two of them are
+// normal.
+//
+// [in,out] random - the state of the random sequence
+//
+// Returns the value.
+//
+static sbfp_t random_value(uint64_t *random)
+{
+	*random = *random * 6364136223846793005ULL + 1442695040888963407ULL;
+
+	int sign = (int)(*random >> 63);
+	int expo = SBFP_BIAS - 7 + (int)((*random >> 32) % 15);
+	int frac = (int)(*random >> 40) & SBFP_FRAC_MASK;
+
+	return (sign << (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC)) | (expo << SBFP_BIT_COUNT_FRAC) | frac;
+}
+
+//
+// The passes, one per workload:
+//
+static void pass_repeated(void)
+{
+	for (size_t index = 0; index < BENCH_COUNT; ++index)
+	{
+		benchResults[index] = sbfp_mul(benchRepeated1[index], benchRepeated2[index]);
+	}
+}
+
+static void pass_random(void)
+{
+	for (size_t index = 0; index < BENCH_COUNT; ++index)
+	{
+		benchResults[index] = sbfp_mul(benchValues1[index], benchValues2[index]);
+	}
+}
+
+static void pass_stream(void)
+{
+	for (size_t index = 0; index < BENCH_STREAM_COUNT; ++index)
+	{
+		benchStreamResults[index] = (sbfp16_t)sbfp_mul(benchStream1[index], benchStream2[index]);
+	}
+}
+
+static void pass_chain(void)
+{
+	sbfp_t product = 0;
+
+	for (size_t index = 0; index < BENCH_COUNT; ++index)
+	{
+		product = sbfp_mul(benchValues1[index] ^ (product & 1), benchValues2[index]);
+	}
+
+	benchChainResult = product;
+}
+
+int main(void)
+{
+	static const struct
+	{
+		const char *name;
+		void (*pass)(void);
+		size_t count;
+		int passes;
+	}
+	workloads[] =
+	{
+		{ "4096 elements, 64 distinct pairs", pass_repeated, BENCH_COUNT,        200 },
+		{ "4096 elements, random operands",   pass_random,   BENCH_COUNT,        200 },
+		{ "32M elements, random operands",    pass_stream,   BENCH_STREAM_COUNT, 1 },
+		{ "dependent chain of products",      pass_chain,    BENCH_COUNT,        200 }
+	};
+
+	benchStream1       = malloc(BENCH_STREAM_COUNT * sizeof(sbfp16_t));
+	benchStream2       = malloc(BENCH_STREAM_COUNT * sizeof(sbfp16_t));
+	benchStreamResults = malloc(BENCH_STREAM_COUNT * sizeof(sbfp16_t));
+
+	if (benchStream1 == NULL || benchStream2 == NULL || benchStreamResults == NULL)
+	{
+		printf("out of memory\n");
+
+		return 1;
+	}
+
+	uint64_t random = 1;
+
+	for (size_t index = 0; index < BENCH_COUNT; ++index)
+	{
+		benchValues1[index] = random_value(&random);
+		benchValues2[index] = random_value(&random);
+	}
+
+	for (size_t index = 0; index < BENCH_COUNT; ++index)
+	{
+		benchRepeated1[index] = benchValues1[index % 64];
+		benchRepeated2[index] = benchValues2[index % 64];
+	}
+
+	for (size_t index = 0; index < BENCH_STREAM_COUNT; ++index)
+	{
+		benchStream1[index] = (sbfp16_t)random_value(&random);
+		benchStream2[index] = (sbfp16_t)random_value(&random);
+	}
+
+	printf("ns per sbfp_mul\n");
+	printf("%-34s %10s %10s\n", "workload", "arithmetic", "table");
+
+	for (size_t workload = 0; workload < sizeof(workloads) / sizeof(workloads[0]); ++workload)
+	{
+		sbfp_mul_init(SBFP_MUL_ENGINE_ARITHMETIC);
+
+		double arithmetic = measure(workloads[workload].pass, workloads[workload].count, workloads[workload].passes);
+
+		sbfp_mul_init(SBFP_MUL_ENGINE_TABLE);
+
+		double table = measure(workloads[workload].pass, workloads[workload].count, workloads[workload].passes);
+
+		printf("%-34s %10.2f %10.2f\n", workloads[workload].name, arithmetic, table);
+	}
+
+	free(benchStream1);
+	free(benchStream2);
+	free(benchStreamResults);
+
+	return 0;
+}
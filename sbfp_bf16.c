@@ -0,0 +1,687 @@
+//
+// sbfp_bf16.c
+//
+// This file contains function definitions for bfloat16, whose values are stored as bf16_t
+// (see sbfp_lib.h). A bfloat16 value is the top 16 bits of a float:
+// 		- 16-bit precision
+// 			Sign = bit 15
+// 			Expo = bits 7-14 (bias 127)
+// 			Frac = bits 0-6
+// It has the range of a float with 8 significant bits, and follows IEEE 754 otherwise.
+// Arithmetic truncates toward zero, as SBFP_ROUND_TRUNCATE does for sbfp_t, and magnitudes
+// beyond the largest finite value become infinity. Conversions from float and double
+// truncate as well, or round to nearest even in their _rne forms. The arithmetic has no
+// rounding modes: a float holds more than twice the significant bits of a bfloat16 value,
+// so a sum or product computed in float and converted with float_to_bf16_rne is already
+// the exact result rounded to nearest even.
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2021 Luke Andrews.  All Rights Reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify, merge,
+// publish, distribute, sub-license, and/or sell copies of the Software, and to permit persons
+// to whom the Software is furnished to do so, subject to the following conditions:
+//
+// * The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+// PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR 
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+#undef SBFP_INLINE // the library defines the external functions
+
+#include "sbfp_const.h"
+#include "sbfp_core.h"
+#include "sbfp_format.h"
+#include "sbfp_lib.h"
+#include "sbfp_x86.h"
+#include <stddef.h>
+#include <stdint.h>
+
+//
+// Truncates a given float value to bfloat16 by dropping its low 16 bits. NaN becomes
+// BF16_NAN, since its payload may lie only in the dropped bits.
+//
+// [in] fltValue - the float value to be converted
+//
+// Returns the converted value.
+//
+static inline bf16_t truncate_float(float fltValue)
+{
+	uint32_t fltBits = sbfp_core_float_bits(fltValue);
+
+	bool isNan = (fltBits & FLOAT_MAGNITUDE_MASK) > FLOAT_INF_BITS;
+
+	return isNan ? BF16_NAN : (bf16_t)(fltBits >> 16);
+}
+
+//
+// Rounds a given float value to the nearest bfloat16, ties to even. Adding just under half
+// of the dropped bits' range, plus the kept LSB, carries into the kept bits exactly when
+// the value rounds up, and a carry out of the largest finite value gives infinity.
+//
+// [in] fltValue - the float value to be converted
+//
+// Returns the converted value.
+//
+static inline bf16_t round_float(float fltValue)
+{
+	uint32_t fltBits = sbfp_core_float_bits(fltValue);
+
+	bool isNan = (fltBits & FLOAT_MAGNITUDE_MASK) > FLOAT_INF_BITS;
+
+	fltBits += 0x7FFF + ((fltBits >> 16) & 1);
+
+	return isNan ? BF16_NAN : (bf16_t)(fltBits >> 16);
+}
+
+//
+// Widens a given bfloat16 value to a float value, which holds it exactly. NaN becomes
+// FLOAT_NAN_BITS, as from sbfp_to_float.
+//
+// [in] bf16Value - the bfloat16 value to be converted
+//
+// Returns the converted value.
+//
+static inline float widen(bf16_t bf16Value)
+{
+	uint32_t fltBits = (uint32_t)bf16Value << 16;
+
+	bool isNan = (fltBits & FLOAT_MAGNITUDE_MASK) > FLOAT_INF_BITS;
+
+	return sbfp_core_bits_float(isNan ? FLOAT_NAN_BITS : fltBits);
+}
+
+//
+// Rounds a given double value to the nearest bfloat16, ties to even.
+//
+// Rounding through float would round twice, so the value is first truncated to float
+// with the LSB set if any bits were dropped (rounding to odd). A float has enough bits
+// beyond the 8 of a bfloat16 that rounding that float gives the same result as rounding
+// the double. A finite value that truncates to infinity is inexact too, and the largest
+// float takes its place so that it rounds the same way.
+//
+// [in] dblValue - the double value to be converted
+//
+// Returns the converted value.
+//
+static inline bf16_t round_double(double dblValue)
+{
+	uint32_t fltBits = sbfp_format_encode_double(FLOAT_BIT_COUNT_EXPO, FLOAT_BIT_COUNT_FRAC, FLOAT_BIAS, dblValue);
+
+	bool isInexact = (double)sbfp_core_bits_float(fltBits) != dblValue;
+
+	fltBits -= isInexact && (fltBits & FLOAT_MAGNITUDE_MASK) == FLOAT_INF_BITS;
+
+	return round_float(sbfp_core_bits_float(fltBits | isInexact));
+}
+
+//
+// Converts a given double value to bfloat16, truncating its magnitude toward zero.
+//
+// [in] dblValue - the double value to be converted
+//
+// Returns the converted value.
+//
+bf16_t double_to_bf16(double dblValue)
+{
+	return (bf16_t)sbfp_format_encode_double(SBFP_FORMAT_BFLOAT16, dblValue);
+}
+
+//
+// Converts a given double value to bfloat16, rounding it to nearest even. Magnitudes that
+// round beyond the largest finite value become infinity.
+//
+// [in] dblValue - the double value to be converted
+//
+// Returns the converted value.
+//
+bf16_t double_to_bf16_rne(double dblValue)
+{
+	return round_double(dblValue);
+}
+
+//
+// Converts a given bfloat16 value to a double value.
+//
+// [in] bf16Value - the bfloat16 value to be converted
+//
+// Returns the converted value.
+//
+double bf16_to_double(bf16_t bf16Value)
+{
+	return sbfp_format_decode_double(SBFP_FORMAT_BFLOAT16, bf16Value);
+}
+
+//
+// Converts a given float value to bfloat16, truncating it by dropping its low 16 bits. The
+// result is the same as that of double_to_bf16 on the widened value.
+//
+// [in] fltValue - the float value to be converted
+//
+// Returns the converted value.
+//
+bf16_t float_to_bf16(float fltValue)
+{
+	return truncate_float(fltValue);
+}
+
+//
+// Converts a given float value to bfloat16, rounding it to nearest even (see
+// double_to_bf16_rne).
+//
+// [in] fltValue - the float value to be converted
+//
+// Returns the converted value.
+//
+bf16_t float_to_bf16_rne(float fltValue)
+{
+	return round_float(fltValue);
+}
+
+//
+// Converts a given bfloat16 value to a float value.
+//
+// [in] bf16Value - the bfloat16 value to be converted
+//
+// Returns the converted value.
+//
+float bf16_to_float(bf16_t bf16Value)
+{
+	return widen(bf16Value);
+}
+
+//
+// Converts a given sbfp value to bfloat16, truncating it like float_to_bf16.
+//
+// [in] sbfpValue - the sbfp value to be converted
+//
+// Returns the converted value.
+//
+bf16_t sbfp_to_bf16(sbfp_t sbfpValue)
+{
+	return truncate_float(sbfp_to_float(sbfpValue));
+}
+
+//
+// Converts a given bfloat16 value to the sbfp_t type, rounding it like float_to_sbfp.
+//
+// [in] bf16Value - the bfloat16 value to be converted
+//
+// Returns the converted value.
+//
+sbfp_t bf16_to_sbfp(bf16_t bf16Value)
+{
+	return float_to_sbfp(widen(bf16Value));
+}
+
+//
+// Adds two bfloat16 values. The result is the exact sum truncated like double_to_bf16
+// would truncate it.
+//
+// [in] bf16Value1 - the augend
+// [in] bf16Value2 - the addend
+//
+// Returns the sum.
+//
+bf16_t bf16_add(bf16_t bf16Value1, bf16_t bf16Value2)
+{
+	return (bf16_t)sbfp_format_add(SBFP_FORMAT_BFLOAT16, bf16Value1, bf16Value2, 0);
+}
+
+//
+// Subtracts one bfloat16 value from another (see bf16_add).
+//
+// [in] bf16Value1 - the minuend
+// [in] bf16Value2 - the subtrahend
+//
+// Returns the difference.
+//
+bf16_t bf16_sub(bf16_t bf16Value1, bf16_t bf16Value2)
+{
+	return (bf16_t)sbfp_format_add(SBFP_FORMAT_BFLOAT16, bf16Value1, bf16Value2, 1);
+}
+
+//
+// Multiplies two bfloat16 values. The result is the exact product truncated like
+// double_to_bf16 would truncate it.
+//
+// [in] bf16Value1 - the multiplicand
+// [in] bf16Value2 - the multiplier
+//
+// Returns the product.
+//
+bf16_t bf16_mul(bf16_t bf16Value1, bf16_t bf16Value2)
+{
+	return (bf16_t)sbfp_format_mul(SBFP_FORMAT_BFLOAT16, bf16Value1, bf16Value2);
+}
+
+//
+// Converts an array of double values to bfloat16, truncating them (see double_to_bf16).
+//
+// [in]  dblValues  - the double values to be converted
+// [in]  dblStride  - the distance, in elements, between consecutive double values (1 if contiguous)
+// [out] bf16Values - the converted values
+// [in]  bf16Stride - the distance, in elements, between consecutive bfloat16 values (1 if contiguous)
+// [in]  count      - the number of values to be converted
+//
+void double_to_bf16_n(const double *dblValues, ptrdiff_t dblStride, bf16_t *bf16Values, ptrdiff_t bf16Stride, size_t count)
+{
+	for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+	{
+		bf16Values[index * bf16Stride] = (bf16_t)sbfp_format_encode_double(SBFP_FORMAT_BFLOAT16, dblValues[index * dblStride]);
+	}
+}
+
+//
+// Converts an array of double values to bfloat16, rounding them to nearest even (see
+// double_to_bf16_rne).
+//
+// [in]  dblValues  - the double values to be converted
+// [in]  dblStride  - the distance, in elements, between consecutive double values (1 if contiguous)
+// [out] bf16Values - the converted values
+// [in]  bf16Stride - the distance, in elements, between consecutive bfloat16 values (1 if contiguous)
+// [in]  count      - the number of values to be converted
+//
+void double_to_bf16_rne_n(const double *dblValues, ptrdiff_t dblStride, bf16_t *bf16Values, ptrdiff_t bf16Stride, size_t count)
+{
+	for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+	{
+		bf16Values[index * bf16Stride] = round_double(dblValues[index * dblStride]);
+	}
+}
+
+//
+// Converts an array of bfloat16 values to double values (see bf16_to_double).
+//
+// [in]  bf16Values - the bfloat16 values to be converted
+// [in]  bf16Stride - the distance, in elements, between consecutive bfloat16 values (1 if contiguous)
+// [out] dblValues  - the converted values
+// [in]  dblStride  - the distance, in elements, between consecutive double values (1 if contiguous)
+// [in]  count      - the number of values to be converted
+//
+void bf16_to_double_n(const bf16_t *bf16Values, ptrdiff_t bf16Stride, double *dblValues, ptrdiff_t dblStride, size_t count)
+{
+	for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+	{
+		dblValues[index * dblStride] = widen(bf16Values[index * bf16Stride]);
+	}
+}
+
+//
+// Converts an array of float values to bfloat16, truncating them (see float_to_bf16).
+//
+// [in]  fltValues  - the float values to be converted
+// [in]  fltStride  - the distance, in elements, between consecutive float values (1 if contiguous)
+// [out] bf16Values - the converted values
+// [in]  bf16Stride - the distance, in elements, between consecutive bfloat16 values (1 if contiguous)
+// [in]  count      - the number of values to be converted
+//
+void float_to_bf16_n(const float *fltValues, ptrdiff_t fltStride, bf16_t *bf16Values, ptrdiff_t bf16Stride, size_t count)
+{
+	if (fltStride == 1 && bf16Stride == 1)
+	{
+		size_t index = 0;
+
+#ifdef SBFP_X86
+		if (sbfpX86Kernels.float_to_bf16 != NULL)
+		{
+			index = sbfpX86Kernels.float_to_bf16(fltValues, bf16Values, count);
+		}
+#endif
+
+		for (; index < count; ++index)
+		{
+			bf16Values[index] = truncate_float(fltValues[index]);
+		}
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+		{
+			bf16Values[index * bf16Stride] = truncate_float(fltValues[index * fltStride]);
+		}
+	}
+}
+
+//
+// Converts an array of float values to bfloat16, rounding them to nearest even (see
+// float_to_bf16_rne).
+//
+// [in]  fltValues  - the float values to be converted
+// [in]  fltStride  - the distance, in elements, between consecutive float values (1 if contiguous)
+// [out] bf16Values - the converted values
+// [in]  bf16Stride - the distance, in elements, between consecutive bfloat16 values (1 if contiguous)
+// [in]  count      - the number of values to be converted
+//
+void float_to_bf16_rne_n(const float *fltValues, ptrdiff_t fltStride, bf16_t *bf16Values, ptrdiff_t bf16Stride, size_t count)
+{
+	if (fltStride == 1 && bf16Stride == 1)
+	{
+		size_t index = 0;
+
+#ifdef SBFP_X86
+		if (sbfpX86Kernels.float_to_bf16_rne != NULL)
+		{
+			index = sbfpX86Kernels.float_to_bf16_rne(fltValues, bf16Values, count);
+		}
+#endif
+
+		for (; index < count; ++index)
+		{
+			bf16Values[index] = round_float(fltValues[index]);
+		}
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+		{
+			bf16Values[index * bf16Stride] = round_float(fltValues[index * fltStride]);
+		}
+	}
+}
+
+//
+// Converts an array of bfloat16 values to float values (see bf16_to_float).
+//
+// [in]  bf16Values - the bfloat16 values to be converted
+// [in]  bf16Stride - the distance, in elements, between consecutive bfloat16 values (1 if contiguous)
+// [out] fltValues  - the converted values
+// [in]  fltStride  - the distance, in elements, between consecutive float values (1 if contiguous)
+// [in]  count      - the number of values to be converted
+//
+void bf16_to_float_n(const bf16_t *bf16Values, ptrdiff_t bf16Stride, float *fltValues, ptrdiff_t fltStride, size_t count)
+{
+	if (bf16Stride == 1 && fltStride == 1)
+	{
+		size_t index = 0;
+
+#ifdef SBFP_X86
+		if (sbfpX86Kernels.bf16_to_float != NULL)
+		{
+			index = sbfpX86Kernels.bf16_to_float(bf16Values, fltValues, count);
+		}
+#endif
+
+		for (; index < count; ++index)
+		{
+			fltValues[index] = widen(bf16Values[index]);
+		}
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+		{
+			fltValues[index * fltStride] = widen(bf16Values[index * bf16Stride]);
+		}
+	}
+}
+
+//
+// Transcodes an array of sbfp_t values to bfloat16 (see sbfp_to_bf16).
+//
+// [in]  sbfpValues - the sbfp values to be converted
+// [in]  sbfpStride - the distance, in elements, between consecutive sbfp values (1 if contiguous)
+// [out] bf16Values - the converted values
+// [in]  bf16Stride - the distance, in elements, between consecutive bfloat16 values (1 if contiguous)
+// [in]  count      - the number of values to be converted
+//
+void sbfp_to_bf16_n(const sbfp_t *sbfpValues, ptrdiff_t sbfpStride, bf16_t *bf16Values, ptrdiff_t bf16Stride, size_t count)
+{
+	if (sbfpStride == 1 && bf16Stride == 1)
+	{
+		size_t index = 0;
+
+#ifdef SBFP_X86
+		if (sbfpX86Kernels.sbfp_to_bf16 != NULL)
+		{
+			index = sbfpX86Kernels.sbfp_to_bf16(sbfpValues, bf16Values, count);
+		}
+#endif
+
+		for (; index < count; ++index)
+		{
+			bf16Values[index] = sbfp_to_bf16(sbfpValues[index]);
+		}
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+		{
+			bf16Values[index * bf16Stride] = sbfp_to_bf16(sbfpValues[index * sbfpStride]);
+		}
+	}
+}
+
+//
+// Transcodes an array of bfloat16 values to the sbfp_t type (see bf16_to_sbfp).
+//
+// [in]  bf16Values - the bfloat16 values to be converted
+// [in]  bf16Stride - the distance, in elements, between consecutive bfloat16 values (1 if contiguous)
+// [out] sbfpValues - the converted values
+// [in]  sbfpStride - the distance, in elements, between consecutive sbfp values (1 if contiguous)
+// [in]  count      - the number of values to be converted
+//
+void bf16_to_sbfp_n(const bf16_t *bf16Values, ptrdiff_t bf16Stride, sbfp_t *sbfpValues, ptrdiff_t sbfpStride, size_t count)
+{
+	if (bf16Stride == 1 && sbfpStride == 1)
+	{
+		size_t index = 0;
+
+#ifdef SBFP_X86
+		if (sbfpX86Kernels.bf16_to_sbfp != NULL)
+		{
+			index = sbfpX86Kernels.bf16_to_sbfp(bf16Values, sbfpValues, count);
+		}
+#endif
+
+		for (; index < count; ++index)
+		{
+			sbfpValues[index] = bf16_to_sbfp(bf16Values[index]);
+		}
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+		{
+			sbfpValues[index * sbfpStride] = bf16_to_sbfp(bf16Values[index * bf16Stride]);
+		}
+	}
+}
+
+//
+// Transcodes an array of sbfp16_t values to bfloat16 (see sbfp_to_bf16).
+//
+// [in]  sbfpValues - the sbfp values to be converted
+// [in]  sbfpStride - the distance, in elements, between consecutive sbfp values (1 if contiguous)
+// [out] bf16Values - the converted values
+// [in]  bf16Stride - the distance, in elements, between consecutive bfloat16 values (1 if contiguous)
+// [in]  count      - the number of values to be converted
+//
+void sbfp16_to_bf16_n(const sbfp16_t *sbfpValues, ptrdiff_t sbfpStride, bf16_t *bf16Values, ptrdiff_t bf16Stride, size_t count)
+{
+	if (sbfpStride == 1 && bf16Stride == 1)
+	{
+		size_t index = 0;
+
+#ifdef SBFP_X86
+		if (sbfpX86Kernels.sbfp16_to_bf16 != NULL)
+		{
+			index = sbfpX86Kernels.sbfp16_to_bf16(sbfpValues, bf16Values, count);
+		}
+#endif
+
+		for (; index < count; ++index)
+		{
+			bf16Values[index] = sbfp_to_bf16(sbfpValues[index]);
+		}
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+		{
+			bf16Values[index * bf16Stride] = sbfp_to_bf16(sbfpValues[index * sbfpStride]);
+		}
+	}
+}
+
+//
+// Transcodes an array of bfloat16 values to the sbfp16_t type (see bf16_to_sbfp).
+//
+// [in]  bf16Values - the bfloat16 values to be converted
+// [in]  bf16Stride - the distance, in elements, between consecutive bfloat16 values (1 if contiguous)
+// [out] sbfpValues - the converted values
+// [in]  sbfpStride - the distance, in elements, between consecutive sbfp values (1 if contiguous)
+// [in]  count      - the number of values to be converted
+//
+void bf16_to_sbfp16_n(const bf16_t *bf16Values, ptrdiff_t bf16Stride, sbfp16_t *sbfpValues, ptrdiff_t sbfpStride, size_t count)
+{
+	if (bf16Stride == 1 && sbfpStride == 1)
+	{
+		size_t index = 0;
+
+#ifdef SBFP_X86
+		if (sbfpX86Kernels.bf16_to_sbfp16 != NULL)
+		{
+			index = sbfpX86Kernels.bf16_to_sbfp16(bf16Values, sbfpValues, count);
+		}
+#endif
+
+		for (; index < count; ++index)
+		{
+			sbfpValues[index] = (sbfp16_t)bf16_to_sbfp(bf16Values[index]);
+		}
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+		{
+			sbfpValues[index * sbfpStride] = (sbfp16_t)bf16_to_sbfp(bf16Values[index * bf16Stride]);
+		}
+	}
+}
+
+//
+// Adds arrays of bfloat16 values elementwise (see bf16_add). A stride of 0 repeats the
+// same value for every element.
+//
+// [in]  bf16Values1  - the augends
+// [in]  bf16Stride1  - the distance, in elements, between consecutive augends (1 if contiguous)
+// [in]  bf16Values2  - the addends
+// [in]  bf16Stride2  - the distance, in elements, between consecutive addends (1 if contiguous)
+// [out] bf16Results  - the sums (may be the same array as either operand)
+// [in]  resultStride - the distance, in elements, between consecutive sums (1 if contiguous)
+// [in]  count        - the number of elements
+//
+void bf16_add_n(const bf16_t *bf16Values1, ptrdiff_t bf16Stride1, const bf16_t *bf16Values2, ptrdiff_t bf16Stride2,
+	bf16_t *bf16Results, ptrdiff_t resultStride, size_t count)
+{
+	if (bf16Stride1 == 1 && bf16Stride2 == 1 && resultStride == 1)
+	{
+		size_t index = 0;
+
+#ifdef SBFP_X86
+		if (sbfpX86Kernels.bf16_add != NULL)
+		{
+			index = sbfpX86Kernels.bf16_add(bf16Values1, bf16Values2, bf16Results, count);
+		}
+#endif
+
+		for (; index < count; ++index)
+		{
+			bf16Results[index] = bf16_add(bf16Values1[index], bf16Values2[index]);
+		}
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+		{
+			bf16Results[index * resultStride] = bf16_add(bf16Values1[index * bf16Stride1], bf16Values2[index * bf16Stride2]);
+		}
+	}
+}
+
+//
+// Subtracts arrays of bfloat16 values elementwise (see bf16_sub and bf16_add_n).
+//
+// [in]  bf16Values1  - the minuends
+// [in]  bf16Stride1  - the distance, in elements, between consecutive minuends (1 if contiguous)
+// [in]  bf16Values2  - the subtrahends
+// [in]  bf16Stride2  - the distance, in elements, between consecutive subtrahends (1 if contiguous)
+// [out] bf16Results  - the differences (may be the same array as either operand)
+// [in]  resultStride - the distance, in elements, between consecutive differences (1 if contiguous)
+// [in]  count        - the number of elements
+//
+void bf16_sub_n(const bf16_t *bf16Values1, ptrdiff_t bf16Stride1, const bf16_t *bf16Values2, ptrdiff_t bf16Stride2,
+	bf16_t *bf16Results, ptrdiff_t resultStride, size_t count)
+{
+	if (bf16Stride1 == 1 && bf16Stride2 == 1 && resultStride == 1)
+	{
+		size_t index = 0;
+
+#ifdef SBFP_X86
+		if (sbfpX86Kernels.bf16_sub != NULL)
+		{
+			index = sbfpX86Kernels.bf16_sub(bf16Values1, bf16Values2, bf16Results, count);
+		}
+#endif
+
+		for (; index < count; ++index)
+		{
+			bf16Results[index] = bf16_sub(bf16Values1[index], bf16Values2[index]);
+		}
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+		{
+			bf16Results[index * resultStride] = bf16_sub(bf16Values1[index * bf16Stride1], bf16Values2[index * bf16Stride2]);
+		}
+	}
+}
+
+//
+// Multiplies arrays of bfloat16 values elementwise (see bf16_mul and bf16_add_n).
+//
+// [in]  bf16Values1  - the multiplicands
+// [in]  bf16Stride1  - the distance, in elements, between consecutive multiplicands (1 if contiguous)
+// [in]  bf16Values2  - the multipliers
+// [in]  bf16Stride2  - the distance, in elements, between consecutive multipliers (1 if contiguous)
+// [out] bf16Results  - the products (may be the same array as either operand)
+// [in]  resultStride - the distance, in elements, between consecutive products (1 if contiguous)
+// [in]  count        - the number of elements
+//
+void bf16_mul_n(const bf16_t *bf16Values1, ptrdiff_t bf16Stride1, const bf16_t *bf16Values2, ptrdiff_t bf16Stride2,
+	bf16_t *bf16Results, ptrdiff_t resultStride, size_t count)
+{
+	if (bf16Stride1 == 1 && bf16Stride2 == 1 && resultStride == 1)
+	{
+		size_t index = 0;
+
+#ifdef SBFP_X86
+		if (sbfpX86Kernels.bf16_mul != NULL)
+		{
+			index = sbfpX86Kernels.bf16_mul(bf16Values1, bf16Values2, bf16Results, count);
+		}
+#endif
+
+		for (; index < count; ++index)
+		{
+			bf16Results[index] = bf16_mul(bf16Values1[index], bf16Values2[index]);
+		}
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+		{
+			bf16Results[index * resultStride] = bf16_mul(bf16Values1[index * bf16Stride1], bf16Values2[index * bf16Stride2]);
+		}
+	}
+}
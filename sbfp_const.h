@@ -32,13 +32,167 @@
 #define SBFP_BIT_COUNT_EXPO 5
 #define SBFP_BIT_COUNT_FRAC 10
 #define SBFP_BIAS ((1 << (SBFP_BIT_COUNT_EXPO - 1)) - 1)
+#define SBFP_BIT_MASK ((1 << (SBFP_BIT_COUNT_SIGN + SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC)) - 1)
+#define SBFP_EXPO_MASK ((1 << SBFP_BIT_COUNT_EXPO) - 1)
+#define SBFP_FRAC_MASK ((1 << SBFP_BIT_COUNT_FRAC) - 1)
 
-#define SBFP_NEG_INF 0x7C00
-#define SBFP_POS_INF 0x3C00
-#define SBFP_NAN     0x3C01
+#define DOUBLE_BIT_COUNT_SIGN 1
+#define DOUBLE_BIT_COUNT_EXPO 11
+#define DOUBLE_BIT_COUNT_FRAC 52
+#define DOUBLE_BIAS ((1 << (DOUBLE_BIT_COUNT_EXPO - 1)) - 1)
+
+#define DOUBLE_FRAC_MASK ((1ULL << DOUBLE_BIT_COUNT_FRAC) - 1)
+#define DOUBLE_MAGNITUDE_MASK ((1ULL << (DOUBLE_BIT_COUNT_EXPO + DOUBLE_BIT_COUNT_FRAC)) - 1)
+#define DOUBLE_INF_BITS (((1ULL << DOUBLE_BIT_COUNT_EXPO) - 1) << DOUBLE_BIT_COUNT_FRAC)
+
+// Magnitude bits of 2^16, the smallest double that overflows an sbfp in every mode:
+#define DOUBLE_SBFP_OVERFLOW_BITS ((unsigned long long)(DOUBLE_BIAS + SBFP_BIAS + 1) << DOUBLE_BIT_COUNT_FRAC)
+
+// Magnitude bits of 2^-14, the smallest normal sbfp:
+#define DOUBLE_SBFP_MIN_NORMAL_BITS ((unsigned long long)(DOUBLE_BIAS - SBFP_BIAS + 1) << DOUBLE_BIT_COUNT_FRAC)
+
+// Right shift taking a double significand to units of the smallest sbfp subnormal (2^-24):
+#define DOUBLE_SBFP_SUBNORMAL_SHIFT (DOUBLE_BIAS + DOUBLE_BIT_COUNT_FRAC - (SBFP_BIAS - 1) - SBFP_BIT_COUNT_FRAC)
+
+#define FLOAT_BIT_COUNT_SIGN 1
+#define FLOAT_BIT_COUNT_EXPO 8
+#define FLOAT_BIT_COUNT_FRAC 23
+#define FLOAT_BIAS ((1 << (FLOAT_BIT_COUNT_EXPO - 1)) - 1)
+
+#define FLOAT_FRAC_MASK ((1U << FLOAT_BIT_COUNT_FRAC) - 1)
+#define FLOAT_MAGNITUDE_MASK ((1U << (FLOAT_BIT_COUNT_EXPO + FLOAT_BIT_COUNT_FRAC)) - 1)
+#define FLOAT_INF_BITS (((1U << FLOAT_BIT_COUNT_EXPO) - 1) << FLOAT_BIT_COUNT_FRAC)
+
+// Magnitude bits of 2^16, the smallest float that overflows an sbfp in every mode:
+#define FLOAT_SBFP_OVERFLOW_BITS ((unsigned)(FLOAT_BIAS + SBFP_BIAS + 1) << FLOAT_BIT_COUNT_FRAC)
+
+// Magnitude bits of 2^-14, the smallest normal sbfp:
+#define FLOAT_SBFP_MIN_NORMAL_BITS ((unsigned)(FLOAT_BIAS - SBFP_BIAS + 1) << FLOAT_BIT_COUNT_FRAC)
+
+// Right shift taking a float significand to units of the smallest sbfp subnormal (2^-24):
+#define FLOAT_SBFP_SUBNORMAL_SHIFT (FLOAT_BIAS + FLOAT_BIT_COUNT_FRAC - (SBFP_BIAS - 1) - SBFP_BIT_COUNT_FRAC)
+
+// Special values of the original sbfp encoding, which do not follow binary16:
+#define SBFP_LEGACY_NEG_INF 0x7C00
+#define SBFP_LEGACY_POS_INF 0x3C00
+#define SBFP_LEGACY_NAN     0x3C01
+
+//
+// Defining SBFP_IEEE_BINARY16 makes sbfp_t bits exactly IEEE binary16: the infinities and
+// NaN take their binary16 patterns, -0 keeps its sign, and 2^-14 is encoded as the
+// smallest normal rather than rounded to one of its neighbours, or truncated to zero by
+// SBFP_ROUND_TRUNCATE. SBFP_ROUND_TOWARD_ZERO also saturates overflow at the largest
+// finite value, as IEEE 754 does. The original encoding is the default.
+//
+#ifdef SBFP_IEEE_BINARY16
+#define SBFP_NEG_INF 0xFC00
+#define SBFP_POS_INF 0x7C00
+#define SBFP_NAN     0x7E00
+
+#define SBFP_SIGNED_ZERO          1
+#define SBFP_ZERO_MIN_NORMAL      0
+#define SBFP_SATURATE_TOWARD_ZERO 1
+#else
+#define SBFP_NEG_INF SBFP_LEGACY_NEG_INF
+#define SBFP_POS_INF SBFP_LEGACY_POS_INF
+#define SBFP_NAN     SBFP_LEGACY_NAN
+
+#define SBFP_SIGNED_ZERO          0
+#define SBFP_ZERO_MIN_NORMAL      1
+#define SBFP_SATURATE_TOWARD_ZERO 0
+#endif
+
+#define BINARY16_POS_INF 0x7C00
+#define BINARY16_NEG_INF 0xFC00
+#define BINARY16_NAN     0x7E00
+#define BINARY16_MAX     0x7BFF // 65504, the largest finite magnitude in either encoding
+
+// Classes of binary16 values (see classify_binary16):
+#define SBFP_CLASS_ZERO      0
+#define SBFP_CLASS_SUBNORMAL 1
+#define SBFP_CLASS_NORMAL    2
+#define SBFP_CLASS_INF       3
+#define SBFP_CLASS_NAN       4
+#define SBFP_CLASS_COUNT     5
+
+// Outcomes of an operation on two classes of operands (see handle_special):
+#define SBFP_OUTCOME_FINITE   0 // computed from the operands' fields
+#define SBFP_OUTCOME_NAN      1
+#define SBFP_OUTCOME_FIRST    2 // the first operand
+#define SBFP_OUTCOME_SECOND   3 // the second operand
+#define SBFP_OUTCOME_INF_XOR  4 // infinity with the sign of the product or quotient
+#define SBFP_OUTCOME_INF_SUM  5 // the first operand if the signs agree, NaN otherwise
+#define SBFP_OUTCOME_ZERO_XOR 6 // zero with the sign of the quotient (if SBFP_SIGNED_ZERO)
+
+// Multiplication engines (see sbfp_mul_init):
+#define SBFP_MUL_ENGINE_ARITHMETIC 0 // multiplies the significands
+#define SBFP_MUL_ENGINE_TABLE      1 // looks up the product's significand in a 2 MB table
+
+// States of the table of the table engine (see sbfp_mul_init):
+#define SBFP_MUL_TABLE_EMPTY   0
+#define SBFP_MUL_TABLE_FILLING 1 // being filled by one thread, which others wait for
+#define SBFP_MUL_TABLE_FILLED  2
+
+// Rounding modes (see sbfp_set_rounding):
+#define SBFP_ROUND_NEAREST_EVEN 0 // to the nearest value, ties to an even frac, like the functions without a mode
+#define SBFP_ROUND_TOWARD_ZERO  1 // truncates
+#define SBFP_ROUND_UPWARD       2 // toward +infinity
+#define SBFP_ROUND_DOWNWARD     3 // toward -infinity
+#define SBFP_ROUND_MODE_COUNT   4
+#define SBFP_ROUND_DYNAMIC      SBFP_ROUND_MODE_COUNT // the calling thread's mode
+
+// Stochastic rounding, of the functions with a _stochastic suffix (see sbfp_seed_stochastic):
+#define SBFP_ROUND_STOCHASTIC   (SBFP_ROUND_MODE_COUNT + 1)
+
+// Truncation as the functions without a mode did before they rounded to nearest, which
+// overflows to infinity even where SBFP_ROUND_TOWARD_ZERO saturates (see
+// SBFP_SATURATE_TOWARD_ZERO), and gives 2^-14 as zero in the original encoding:
+#define SBFP_ROUND_TRUNCATE     (SBFP_ROUND_MODE_COUNT + 2)
+
+// Operations of the arithmetic that rounds in a given mode (see operate_round):
+#define SBFP_OPERATION_ADD 0
+#define SBFP_OPERATION_SUB 1
+#define SBFP_OPERATION_MUL 2
+
+// 8-bit formats (see sbfp8_t):
+#define SBFP8_E4M3         0 // 4 expo bits and 3 frac bits, with NaN but no infinity
+#define SBFP8_E5M2         1 // 5 expo bits and 2 frac bits, with infinity and NaN like binary16
+#define SBFP8_FORMAT_COUNT 2
+
+#define SBFP8_SIGN_MASK      0x80
+#define SBFP8_MAGNITUDE_MASK 0x7F
+
+#define E4M3_BIT_COUNT_EXPO 4
+#define E4M3_BIT_COUNT_FRAC 3
+#define E4M3_BIAS 7
+#define E4M3_MAX  0x7E // 448, which magnitudes beyond the range saturate to
+#define E4M3_NAN  0x7F
+
+#define E5M2_BIT_COUNT_EXPO 5
+#define E5M2_BIT_COUNT_FRAC 2
+#define E5M2_BIAS    15
+#define E5M2_MAX     0x7B // 57344
+#define E5M2_POS_INF 0x7C
+#define E5M2_NAN     0x7E
+
+// bfloat16 (see bf16_t), the top 16 bits of a float:
+#define BF16_BIT_COUNT_EXPO 8
+#define BF16_BIT_COUNT_FRAC 7
+#define BF16_BIAS    127
+#define BF16_POS_INF 0x7F80
+#define BF16_NEG_INF 0xFF80
+#define BF16_NAN     0x7FC0
 
 #define DOUBLE_POS_INF HUGE_VAL
 #define DOUBLE_NEG_INF (HUGE_VAL * -1.0)
 #define DOUBLE_NAN (INFINITY * 0.0F)
 
+#define FLOAT_NAN (INFINITY * 0.0F)
+
+// Bits of the NaN that sbfp_to_double and sbfp_to_float return, the default NaN of x86
+// (DOUBLE_NAN and FLOAT_NAN there). Fixed bits keep the decoding the same on every target
+// and at compile time:
+#define DOUBLE_NAN_BITS 0xFFF8000000000000ULL
+#define FLOAT_NAN_BITS  0xFFC00000U
+
 #endif
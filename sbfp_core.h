@@ -0,0 +1,1130 @@
+//
+// sbfp_core.h
+//
+// This file contains the scalar SBFP conversions and arithmetic as static inline
+// functions. sbfp_lib.c builds the library functions from them, and sbfp_lib.h defines
+// the scalar functions with them when SBFP_INLINE is defined. It is not meant to be
+// included by callers directly.
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2021 Luke Andrews.  All Rights Reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify, merge,
+// publish, distribute, sub-license, and/or sell copies of the Software, and to permit persons
+// to whom the Software is furnished to do so, subject to the following conditions:
+//
+// * The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+// PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR 
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+#ifndef SBFP_CORE_H
+#define SBFP_CORE_H
+
+#include "sbfp_const.h"
+#include "sbfp_lib.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+//
+// Functions and tables are constexpr in C++, so that sbfp_lib.hpp can evaluate them at
+// compile time. Bits are reinterpreted with memcpy in C and with __builtin_bit_cast in C++.
+//
+#ifdef __cplusplus
+#define SBFP_CORE_CONSTEXPR constexpr
+#else
+#define SBFP_CORE_CONSTEXPR
+#endif
+
+//
+// The functions that take a rounding mode are always inlined, so that a constant mode is
+// folded into the caller and the other modes cost nothing there. The functions without a
+// mode are those functions given SBFP_ROUND_NEAREST_EVEN.
+//
+#if defined(__GNUC__)
+#define SBFP_CORE_ROUND_INLINE static inline __attribute__((always_inline)) SBFP_CORE_CONSTEXPR
+#else
+#define SBFP_CORE_ROUND_INLINE static inline SBFP_CORE_CONSTEXPR
+#endif
+
+//
+// Gives the binary64 encoding of a given double value.
+//
+// [in] dblValue - the double value
+//
+// Returns its bits.
+//
+static inline SBFP_CORE_CONSTEXPR uint64_t sbfp_core_double_bits(double dblValue)
+{
+#ifdef __cplusplus
+	return __builtin_bit_cast(uint64_t, dblValue);
+#else
+	uint64_t dblBits = 0;
+	memcpy(&dblBits, &dblValue, sizeof(dblBits));
+
+	return dblBits;
+#endif
+}
+
+//
+// Gives the double value of a given binary64 encoding.
+//
+// [in] dblBits - the bits
+//
+// Returns the double value.
+//
+static inline SBFP_CORE_CONSTEXPR double sbfp_core_bits_double(uint64_t dblBits)
+{
+#ifdef __cplusplus
+	return __builtin_bit_cast(double, dblBits);
+#else
+	double dblValue = 0.0;
+	memcpy(&dblValue, &dblBits, sizeof(dblValue));
+
+	return dblValue;
+#endif
+}
+
+//
+// Gives the binary32 encoding of a given float value.
+//
+// [in] fltValue - the float value
+//
+// Returns its bits.
+//
+static inline SBFP_CORE_CONSTEXPR uint32_t sbfp_core_float_bits(float fltValue)
+{
+#ifdef __cplusplus
+	return __builtin_bit_cast(uint32_t, fltValue);
+#else
+	uint32_t fltBits = 0;
+	memcpy(&fltBits, &fltValue, sizeof(fltBits));
+
+	return fltBits;
+#endif
+}
+
+//
+// Gives the float value of a given binary32 encoding.
+//
+// [in] fltBits - the bits
+//
+// Returns the float value.
+//
+static inline SBFP_CORE_CONSTEXPR float sbfp_core_bits_float(uint32_t fltBits)
+{
+#ifdef __cplusplus
+	return __builtin_bit_cast(float, fltBits);
+#else
+	float fltValue = 0.0F;
+	memcpy(&fltValue, &fltBits, sizeof(fltValue));
+
+	return fltValue;
+#endif
+}
+
+//
+// Determines whether a value being rounded to sbfp goes up by one unit of its last frac
+// bit. Called with a constant mode, only that mode's test is compiled, and none for
+// SBFP_ROUND_TOWARD_ZERO or SBFP_ROUND_TRUNCATE.
+//
+// SBFP_ROUND_STOCHASTIC rounds up when the dropped bits exceed as many random bits, which
+// happens with a probability of exactly rem / (2 * half).
+//
+// [in] mode   - the rounding mode (see SBFP_ROUND_NEAREST_EVEN)
+// [in] sign   - 1 if the value is negative
+// [in] lsb    - the last frac bit that is kept
+// [in] rem    - the bits that are dropped
+// [in] half   - the weight of the highest dropped bit
+// [in] random - uniformly random bits for SBFP_ROUND_STOCHASTIC (unused by the other modes)
+//
+// Returns 1 to round the magnitude up, or 0 to truncate it.
+//
+SBFP_CORE_ROUND_INLINE uint64_t sbfp_core_round_up(int mode, uint64_t sign, uint64_t lsb, uint64_t rem, uint64_t half,
+	uint64_t random)
+{
+	uint64_t roundUp = 0;
+
+	if (mode == SBFP_ROUND_NEAREST_EVEN)
+	{
+		roundUp = (uint64_t)(rem > half) | ((uint64_t)(rem == half) & lsb);
+	}
+	else if (mode == SBFP_ROUND_UPWARD || mode == SBFP_ROUND_DOWNWARD)
+	{
+		roundUp = (uint64_t)(rem != 0) & (sign ^ (uint64_t)(mode == SBFP_ROUND_UPWARD));
+	}
+	else if (mode == SBFP_ROUND_STOCHASTIC)
+	{
+		roundUp = (uint64_t)(rem > (random & ((half << 1) - 1)));
+	}
+
+	return roundUp;
+}
+
+//
+// Determines whether a mode truncates, as SBFP_ROUND_TOWARD_ZERO and SBFP_ROUND_TRUNCATE do.
+//
+// [in] mode - the rounding mode (see SBFP_ROUND_NEAREST_EVEN)
+//
+// Returns true if the mode truncates.
+//
+SBFP_CORE_ROUND_INLINE bool sbfp_core_round_truncates(int mode)
+{
+	return (mode == SBFP_ROUND_TOWARD_ZERO) | (mode == SBFP_ROUND_TRUNCATE);
+}
+
+//
+// Determines whether a finite value beyond the largest finite magnitude saturates at it
+// rather than becoming infinity, which it does when rounded toward zero from its side:
+// downward if positive, upward if negative, and toward zero if SBFP_SATURATE_TOWARD_ZERO.
+//
+// [in] mode - the rounding mode (see SBFP_ROUND_NEAREST_EVEN)
+// [in] sign - 1 if the value is negative
+//
+// Returns true if the value saturates.
+//
+SBFP_CORE_ROUND_INLINE bool sbfp_core_round_saturates(int mode, uint64_t sign)
+{
+	return ((mode == SBFP_ROUND_DOWNWARD) & (sign == 0)) | ((mode == SBFP_ROUND_UPWARD) & (sign == 1)) |
+	       ((mode == SBFP_ROUND_TOWARD_ZERO) & SBFP_SATURATE_TOWARD_ZERO);
+}
+
+//
+// Checks a rounding mode given to a function with a _round suffix. The functions with a
+// _stochastic suffix are the only ones that round stochastically, so SBFP_ROUND_STOCHASTIC
+// is unknown here, and an unknown mode rounds to nearest even like the functions without
+// a mode, in the scalar and bulk functions alike.
+//
+// [in] mode - the rounding mode given, with SBFP_ROUND_DYNAMIC already resolved
+//
+// Returns the mode, or SBFP_ROUND_NEAREST_EVEN if it is unknown.
+//
+SBFP_CORE_ROUND_INLINE int sbfp_core_check_rounding(int mode)
+{
+	return ((mode >= 0 && mode < SBFP_ROUND_MODE_COUNT) || mode == SBFP_ROUND_TRUNCATE) ? mode : SBFP_ROUND_NEAREST_EVEN;
+}
+
+#if SBFP_ZERO_MIN_NORMAL
+//
+// Gives the magnitude bits of a value that rounds to 2^-14, which the original encoding
+// has no pattern for (see SBFP_ZERO_MIN_NORMAL). SBFP_ROUND_TRUNCATE gives zero, as the
+// functions without a mode did before they rounded to nearest.
+// The other modes give the neighbour of 2^-14 on the side they round to: 0x3FF, the largest
+// subnormal, or 0x401, the next value up. Rounding to nearest takes the closer one, and
+// 0x3FF for 2^-14 itself. Stochastic rounding takes either with equal probability, by a
+// random bit above those that rounded the value, which keeps its expected result exact.
+//
+// [in] mode    - the rounding mode (see SBFP_ROUND_NEAREST_EVEN)
+// [in] sign    - 1 if the value is negative
+// [in] isAbove - 1 if the exact magnitude is above 2^-14
+// [in] random  - random bits for SBFP_ROUND_STOCHASTIC (see sbfp_core_round_up)
+//
+// Returns the magnitude bits.
+//
+SBFP_CORE_ROUND_INLINE uint64_t sbfp_core_round_min_normal(int mode, uint64_t sign, uint64_t isAbove, uint64_t random)
+{
+	uint64_t bits = 0;
+
+	if (mode == SBFP_ROUND_NEAREST_EVEN)
+	{
+		bits = SBFP_FRAC_MASK + 2 * isAbove;
+	}
+	else if (mode == SBFP_ROUND_UPWARD || mode == SBFP_ROUND_DOWNWARD)
+	{
+		bits = SBFP_FRAC_MASK + 2 * (sign ^ (uint64_t)(mode == SBFP_ROUND_UPWARD));
+	}
+	else if (mode == SBFP_ROUND_STOCHASTIC)
+	{
+		bits = SBFP_FRAC_MASK + 2 * (random >> 63);
+	}
+
+	return bits;
+}
+#endif
+
+//
+// Encodes a given double value as an sbfp_t value, rounding it in a given mode.
+//
+// The sign, expo and frac fields are read straight from the binary64 encoding of the
+// value and the sbfp fields are derived from them with integer operations. The dropped
+// bits then decide the rounding, and a carry out of the frac simply moves to the next
+// expo. Every case is computed and the result selected, so loops over this function can
+// be vectorized. Magnitudes that round to 2^16 or above become infinity, or the largest
+// finite value where they saturate (see sbfp_core_round_saturates).
+//
+// [in] dblValue - the double value to be encoded
+// [in] mode     - the rounding mode (see SBFP_ROUND_NEAREST_EVEN)
+// [in] random   - random bits for SBFP_ROUND_STOCHASTIC (see sbfp_core_round_up)
+//
+// Returns the encoded value.
+//
+SBFP_CORE_ROUND_INLINE sbfp_t sbfp_core_encode_double_round(double dblValue, int mode, uint64_t random)
+{
+	//
+	// Extract the magnitude, expo and sign (treating 0 as positive unless SBFP_SIGNED_ZERO).
+	// Everything stays in 64 bits until the end, so vectorized loops need not repack lanes:
+	//
+	uint64_t dblBits = sbfp_core_double_bits(dblValue);
+
+	uint64_t dblMagnitude = dblBits & DOUBLE_MAGNITUDE_MASK;
+	uint64_t dblExpo      = dblMagnitude >> DOUBLE_BIT_COUNT_FRAC;
+	uint64_t sbfpSign     = (dblBits >> (DOUBLE_BIT_COUNT_EXPO + DOUBLE_BIT_COUNT_FRAC)) & (SBFP_SIGNED_ZERO || dblMagnitude != 0);
+
+	//
+	// Normal: rebias the expo and keep the top frac bits. The double expo and frac are
+	// adjacent, so both are moved with one shift and rebiased with one subtraction.
+	//
+	uint64_t sbfpNormal = (dblMagnitude >> (DOUBLE_BIT_COUNT_FRAC - SBFP_BIT_COUNT_FRAC)) -
+	                      ((uint64_t)(DOUBLE_BIAS - SBFP_BIAS) << SBFP_BIT_COUNT_FRAC);
+
+	//
+	// Subnormal: shift the full significand down to units of 2^-24. A subnormal double has
+	// no implicit bit and the expo of the smallest normal. The shift is clamped so that
+	// values far below the sbfp range simply become 0, and the excess is kept for
+	// stochastic rounding.
+	//
+	uint64_t dblSig    = (dblMagnitude & DOUBLE_FRAC_MASK) | ((uint64_t)(dblExpo != 0) << DOUBLE_BIT_COUNT_FRAC);
+	uint64_t subShift  = DOUBLE_SBFP_SUBNORMAL_SHIFT - dblExpo - (uint64_t)(dblExpo == 0);
+	uint64_t subExcess = (subShift > 63) ? subShift - 63 : 0;
+
+	subShift  = (subShift < 63) ? subShift : 63;
+	subExcess = (subExcess < 63) ? subExcess : 63;
+
+	uint64_t sbfpSubnormal = dblSig >> subShift;
+
+	bool isNormal = dblExpo > DOUBLE_BIAS - SBFP_BIAS;
+
+	uint64_t sbfpBits = isNormal ? sbfpNormal : sbfpSubnormal;
+
+	//
+	// Round with the dropped bits. A zero has none, although its significand was given the
+	// implicit bit above:
+	//
+	uint64_t dropNormal = DOUBLE_BIT_COUNT_FRAC - SBFP_BIT_COUNT_FRAC;
+	uint64_t dropCount  = isNormal ? dropNormal : subShift;
+
+	uint64_t rem = (isNormal ? dblMagnitude : dblSig) & ((1ULL << dropCount) - 1) & (0 - (uint64_t)(dblMagnitude != 0));
+
+	//
+	// Stochastic rounding compares the dropped bits with as many random bits. Past the
+	// clamped shift, they are scaled down by the excess instead, so the value still rounds
+	// up with a probability of its fraction of 2^-24 (to within 2^-63):
+	//
+	uint64_t remRandom = (mode == SBFP_ROUND_STOCHASTIC) ? rem >> (isNormal ? 0 : subExcess) : rem;
+
+	uint64_t roundUp = sbfp_core_round_up(mode, sbfpSign, sbfpBits & 1, remRandom, 1ULL << (dropCount - 1), random);
+
+	sbfpBits += roundUp;
+
+	//
+	// Magnitudes of 2^16 and above overflow, as do those that round up to 2^16:
+	//
+	bool isOverflow = (dblMagnitude >= DOUBLE_SBFP_OVERFLOW_BITS) |
+	                  (!sbfp_core_round_truncates(mode) & (sbfpBits >= ((uint64_t)SBFP_EXPO_MASK << SBFP_BIT_COUNT_FRAC)));
+
+	bool isSaturated = sbfp_core_round_saturates(mode, sbfpSign) & (dblMagnitude != DOUBLE_INF_BITS);
+
+#if SBFP_ZERO_MIN_NORMAL
+	//
+	// Magnitudes in [2^-14, (1 + 2^-10) * 2^-14) are subnormals with a zero frac. This is
+	// a mask rather than a select, which keeps the conversion loops vectorizable. The other
+	// modes round to a neighbour of 2^-14 instead:
+	//
+	if (sbfp_core_round_truncates(mode))
+	{
+		sbfpBits &= 0 - (uint64_t)(sbfpBits != (1 << SBFP_BIT_COUNT_FRAC));
+	}
+	else
+	{
+		uint64_t isAbove = (uint64_t)(rem != 0) & (roundUp ^ 1);
+
+		sbfpBits = (sbfpBits == (1 << SBFP_BIT_COUNT_FRAC)) ? sbfp_core_round_min_normal(mode, sbfpSign, isAbove, random) : sbfpBits;
+	}
+#endif
+
+	//
+	// Concatenate the sign:
+	//
+	sbfpBits |= sbfpSign << (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC);
+
+	//
+	// Determine infinity and NaN:
+	//
+	uint64_t sbfpMax = BINARY16_MAX | (sbfpSign << (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC));
+
+	sbfpBits = isOverflow ? (isSaturated ? sbfpMax : ((sbfpSign == 1) ? SBFP_NEG_INF : SBFP_POS_INF)) : sbfpBits;
+	sbfpBits = (dblMagnitude > DOUBLE_INF_BITS) ? SBFP_NAN : sbfpBits;
+
+	return (sbfp_t)sbfpBits;
+}
+
+//
+// Encodes a given double value as an sbfp_t value, rounding it to nearest even.
+//
+// [in] dblValue - the double value to be encoded
+//
+// Returns the encoded value.
+//
+static inline SBFP_CORE_CONSTEXPR sbfp_t sbfp_core_encode_double(double dblValue)
+{
+	return sbfp_core_encode_double_round(dblValue, SBFP_ROUND_NEAREST_EVEN, 0);
+}
+
+//
+// Decodes a given sbfp_t value to a double value.
+//
+// The double is assembled from the sign, expo and frac fields. Every case is computed and
+// the result selected, so loops over this function can be vectorized.
+//
+// [in] sbfpValue - the sbfp_t value to be decoded
+//
+// Returns the decoded value.
+//
+static inline SBFP_CORE_CONSTEXPR double sbfp_core_decode_double(sbfp_t sbfpValue)
+{
+	//
+	// Extract the magnitude, frac, expo and sign:
+	//
+	int sbfpMagnitude = sbfpValue & (SBFP_BIT_MASK >> SBFP_BIT_COUNT_SIGN);
+	int sbfpFrac      = sbfpMagnitude & SBFP_FRAC_MASK;
+	int sbfpExpo      = sbfpMagnitude >> SBFP_BIT_COUNT_FRAC;
+
+	uint64_t dblSign = (uint64_t)((sbfpValue >> (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC)) & 1) <<
+	                   (DOUBLE_BIT_COUNT_EXPO + DOUBLE_BIT_COUNT_FRAC);
+
+	//
+	// Normal: move the expo and frac into place together and rebias the expo:
+	//
+	uint64_t dblNormal = ((uint64_t)sbfpMagnitude << (DOUBLE_BIT_COUNT_FRAC - SBFP_BIT_COUNT_FRAC)) +
+	                     ((uint64_t)(DOUBLE_BIAS - SBFP_BIAS) << DOUBLE_BIT_COUNT_FRAC);
+
+	//
+	// Subnormal: the frac counts units of 2^-24, which converts to double exactly:
+	//
+	uint64_t dblSubnormal = sbfp_core_double_bits((double)sbfpFrac / (1 << (SBFP_BIAS - 1 + SBFP_BIT_COUNT_FRAC)));
+
+	//
+	// Select the case, concatenate the sign (NaN has its own) and return. The selects are
+	// masks rather than conditionals, which keeps the conversion loops vectorizable:
+	//
+	uint64_t isSubnormal = 0 - (uint64_t)(sbfpExpo == 0);
+	uint64_t isSpecial   = 0 - (uint64_t)(sbfpExpo == SBFP_EXPO_MASK);
+	uint64_t isNan       = isSpecial & (0 - (uint64_t)(sbfpFrac != 0));
+
+	uint64_t dblBits = (dblNormal & ~isSubnormal) | (dblSubnormal & isSubnormal);
+
+	dblBits = (dblBits & ~isSpecial) | (DOUBLE_INF_BITS & isSpecial);
+	dblBits |= dblSign;
+	dblBits = (dblBits & ~isNan) | (DOUBLE_NAN_BITS & isNan);
+
+	return sbfp_core_bits_double(dblBits);
+}
+
+//
+// Encodes a given float value as an sbfp_t value, rounding it in a given mode. It works
+// directly on the binary32 encoding (see sbfp_core_encode_double_round), except for
+// stochastic rounding.
+//
+// [in] fltValue - the float value to be encoded
+// [in] mode     - the rounding mode (see SBFP_ROUND_NEAREST_EVEN)
+// [in] random   - random bits for SBFP_ROUND_STOCHASTIC (see sbfp_core_round_up)
+//
+// Returns the encoded value.
+//
+SBFP_CORE_ROUND_INLINE sbfp_t sbfp_core_encode_float_round(float fltValue, int mode, uint64_t random)
+{
+	//
+	// A float converts to double exactly, and the double encoding keeps the probability of
+	// stochastic rounding exact far below the sbfp range, so stochastic rounding uses it:
+	//
+	if (mode == SBFP_ROUND_STOCHASTIC)
+	{
+		return sbfp_core_encode_double_round((double)fltValue, mode, random);
+	}
+
+	//
+	// Extract the magnitude, expo and sign (treating 0 as positive unless SBFP_SIGNED_ZERO):
+	//
+	uint32_t fltBits = sbfp_core_float_bits(fltValue);
+
+	uint32_t fltMagnitude = fltBits & FLOAT_MAGNITUDE_MASK;
+	uint32_t fltExpo      = fltMagnitude >> FLOAT_BIT_COUNT_FRAC;
+	uint32_t sbfpSign     = (fltBits >> (FLOAT_BIT_COUNT_EXPO + FLOAT_BIT_COUNT_FRAC)) & (SBFP_SIGNED_ZERO || fltMagnitude != 0);
+
+	//
+	// Normal: rebias the expo and keep the top frac bits:
+	//
+	uint32_t sbfpNormal = (fltMagnitude >> (FLOAT_BIT_COUNT_FRAC - SBFP_BIT_COUNT_FRAC)) -
+	                      ((uint32_t)(FLOAT_BIAS - SBFP_BIAS) << SBFP_BIT_COUNT_FRAC);
+
+	//
+	// Subnormal: shift the full significand down to units of 2^-24. A subnormal float has
+	// no implicit bit and the expo of the smallest normal:
+	//
+	uint32_t fltSig   = (fltMagnitude & FLOAT_FRAC_MASK) | ((uint32_t)(fltExpo != 0) << FLOAT_BIT_COUNT_FRAC);
+	uint32_t subShift = FLOAT_SBFP_SUBNORMAL_SHIFT - fltExpo - (uint32_t)(fltExpo == 0);
+
+	subShift = (subShift < 31) ? subShift : 31;
+
+	uint32_t sbfpSubnormal = fltSig >> subShift;
+
+	bool isNormal = fltExpo > FLOAT_BIAS - SBFP_BIAS;
+
+	uint32_t sbfpBits = isNormal ? sbfpNormal : sbfpSubnormal;
+
+	//
+	// Round with the dropped bits (a zero has none):
+	//
+	uint32_t dropNormal = FLOAT_BIT_COUNT_FRAC - SBFP_BIT_COUNT_FRAC;
+	uint32_t dropCount  = isNormal ? dropNormal : subShift;
+
+	uint32_t rem = (isNormal ? fltMagnitude : fltSig) & ((1U << dropCount) - 1) & (0 - (uint32_t)(fltMagnitude != 0));
+
+	uint32_t roundUp = (uint32_t)sbfp_core_round_up(mode, sbfpSign, sbfpBits & 1, rem, 1U << (dropCount - 1), random);
+
+	sbfpBits += roundUp;
+
+	bool isOverflow = (fltMagnitude >= FLOAT_SBFP_OVERFLOW_BITS) |
+	                  (!sbfp_core_round_truncates(mode) & (sbfpBits >= ((uint32_t)SBFP_EXPO_MASK << SBFP_BIT_COUNT_FRAC)));
+
+	bool isSaturated = sbfp_core_round_saturates(mode, sbfpSign) & (fltMagnitude != FLOAT_INF_BITS);
+
+#if SBFP_ZERO_MIN_NORMAL
+	//
+	// Magnitudes in [2^-14, (1 + 2^-10) * 2^-14) are subnormals with a zero frac, or round
+	// to a neighbour of 2^-14 in the other modes:
+	//
+	if (sbfp_core_round_truncates(mode))
+	{
+		sbfpBits &= 0 - (uint32_t)(sbfpBits != (1 << SBFP_BIT_COUNT_FRAC));
+	}
+	else
+	{
+		uint32_t isAbove = (uint32_t)(rem != 0) & (roundUp ^ 1);
+
+		sbfpBits = (sbfpBits == (1 << SBFP_BIT_COUNT_FRAC)) ? (uint32_t)sbfp_core_round_min_normal(mode, sbfpSign, isAbove, random) : sbfpBits;
+	}
+#endif
+
+	//
+	// Concatenate the sign:
+	//
+	sbfpBits |= sbfpSign << (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC);
+
+	//
+	// Determine infinity and NaN:
+	//
+	uint32_t sbfpMax = BINARY16_MAX | (sbfpSign << (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC));
+
+	sbfpBits = isOverflow ? (isSaturated ? sbfpMax : ((sbfpSign == 1) ? SBFP_NEG_INF : SBFP_POS_INF)) : sbfpBits;
+	sbfpBits = (fltMagnitude > FLOAT_INF_BITS) ? SBFP_NAN : sbfpBits;
+
+	return (sbfp_t)sbfpBits;
+}
+
+//
+// Encodes a given float value as an sbfp_t value, rounding it to nearest even.
+//
+// [in] fltValue - the float value to be encoded
+//
+// Returns the encoded value.
+//
+static inline SBFP_CORE_CONSTEXPR sbfp_t sbfp_core_encode_float(float fltValue)
+{
+	return sbfp_core_encode_float_round(fltValue, SBFP_ROUND_NEAREST_EVEN, 0);
+}
+
+//
+// Decodes a given sbfp_t value to a float value, assembling its binary32 encoding
+// directly (see sbfp_core_decode_double).
+//
+// [in] sbfpValue - the sbfp_t value to be decoded
+//
+// Returns the decoded value.
+//
+static inline SBFP_CORE_CONSTEXPR float sbfp_core_decode_float(sbfp_t sbfpValue)
+{
+	//
+	// Extract the magnitude, frac, expo and sign:
+	//
+	uint32_t sbfpMagnitude = (uint32_t)sbfpValue & (SBFP_BIT_MASK >> SBFP_BIT_COUNT_SIGN);
+	uint32_t sbfpFrac      = sbfpMagnitude & SBFP_FRAC_MASK;
+	uint32_t sbfpExpo      = sbfpMagnitude >> SBFP_BIT_COUNT_FRAC;
+
+	uint32_t fltSign = (((uint32_t)sbfpValue >> (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC)) & 1) <<
+	                   (FLOAT_BIT_COUNT_EXPO + FLOAT_BIT_COUNT_FRAC);
+
+	//
+	// Normal: move the expo and frac into place together and rebias the expo:
+	//
+	uint32_t fltNormal = (sbfpMagnitude << (FLOAT_BIT_COUNT_FRAC - SBFP_BIT_COUNT_FRAC)) +
+	                     ((uint32_t)(FLOAT_BIAS - SBFP_BIAS) << FLOAT_BIT_COUNT_FRAC);
+
+	//
+	// Subnormal: the frac counts units of 2^-24, which converts to float exactly:
+	//
+	uint32_t fltSubnormal = sbfp_core_float_bits((float)sbfpFrac / (1 << (SBFP_BIAS - 1 + SBFP_BIT_COUNT_FRAC)));
+
+	//
+	// Select the case, concatenate the sign (NaN has its own) and return:
+	//
+	uint32_t isSubnormal = 0 - (uint32_t)(sbfpExpo == 0);
+	uint32_t isSpecial   = 0 - (uint32_t)(sbfpExpo == SBFP_EXPO_MASK);
+	uint32_t isNan       = isSpecial & (0 - (uint32_t)(sbfpFrac != 0));
+
+	uint32_t fltBits = (fltNormal & ~isSubnormal) | (fltSubnormal & isSubnormal);
+
+	fltBits = (fltBits & ~isSpecial) | (FLOAT_INF_BITS & isSpecial);
+	fltBits |= fltSign;
+	fltBits = (fltBits & ~isNan) | (FLOAT_NAN_BITS & isNan);
+
+	return sbfp_core_bits_float(fltBits);
+}
+
+//
+// Counts the leading zero bits of a given nonzero 64-bit value.
+//
+// [in] value - the value whose leading zeros to count
+//
+// Returns the number of leading zero bits.
+//
+static inline SBFP_CORE_CONSTEXPR int sbfp_core_count_leading_zeros(uint64_t value)
+{
+#ifdef __GNUC__
+	return __builtin_clzll(value);
+#else
+	int count = 0;
+
+	while (!(value & (1ULL << 63)))
+	{
+		value <<= 1;
+		++count;
+	}
+
+	return count;
+#endif
+}
+
+//
+// Translates given bits of the original sbfp encoding to IEEE binary16. SBFP_LEGACY_POS_INF,
+// SBFP_LEGACY_NEG_INF and SBFP_LEGACY_NAN are mapped to the binary16 infinities and quiet
+// NaN, and every other value keeps its bits. The selects are masks, so loops over this
+// function can be vectorized.
+//
+// [in] bits - the bits to be translated (without any higher bits)
+//
+// Returns the binary16 bits.
+//
+static inline SBFP_CORE_CONSTEXPR int sbfp_core_legacy_to_binary16(int bits)
+{
+	//
+	// The masks are computed from the original bits, so that SBFP_LEGACY_NEG_INF is not
+	// confused with the BINARY16_POS_INF that SBFP_LEGACY_POS_INF maps to:
+	//
+	int isPosInf = 0 - (bits == SBFP_LEGACY_POS_INF);
+	int isNegInf = 0 - (bits == SBFP_LEGACY_NEG_INF);
+	int isNan    = 0 - (bits == SBFP_LEGACY_NAN);
+
+	return (bits & ~(isPosInf | isNegInf | isNan)) |
+	       (BINARY16_POS_INF & isPosInf) | (BINARY16_NEG_INF & isNegInf) | (BINARY16_NAN & isNan);
+}
+
+//
+// Translates given IEEE binary16 bits to the original sbfp encoding (see
+// sbfp_core_legacy_to_binary16). Every NaN becomes SBFP_LEGACY_NAN.
+//
+// [in] bits - the bits to be translated (without any higher bits)
+//
+// Returns the bits in the original encoding.
+//
+static inline SBFP_CORE_CONSTEXPR int sbfp_core_binary16_to_legacy(int bits)
+{
+	int isSpecial = 0 - (((bits >> SBFP_BIT_COUNT_FRAC) & SBFP_EXPO_MASK) == SBFP_EXPO_MASK);
+	int isNan     = isSpecial & (0 - ((bits & SBFP_FRAC_MASK) != 0));
+	int isPosInf  = 0 - (bits == BINARY16_POS_INF);
+	int isNegInf  = 0 - (bits == BINARY16_NEG_INF);
+
+	return (bits & ~isSpecial) |
+	       (SBFP_LEGACY_POS_INF & isPosInf) | (SBFP_LEGACY_NEG_INF & isNegInf) | (SBFP_LEGACY_NAN & isNan);
+}
+
+//
+// Translates a given sbfp_t value to IEEE binary16 bits, which is how the arithmetic
+// functions work on it. Only the original encoding needs any translation.
+//
+// [in] sbfpValue - the sbfp_t value to be translated
+//
+// Returns the binary16 bits.
+//
+static inline SBFP_CORE_CONSTEXPR int sbfp_core_to_binary16(sbfp_t sbfpValue)
+{
+#ifdef SBFP_IEEE_BINARY16
+	return sbfpValue & SBFP_BIT_MASK;
+#else
+	return sbfp_core_legacy_to_binary16(sbfpValue & SBFP_BIT_MASK);
+#endif
+}
+
+//
+// Determines whether given sbfp_t bits are infinity or NaN, in either the sbfp encoding
+// or binary16, with one test instead of an equality test per special value.
+//
+// [in] bits - the sbfp_t bits (without any higher bits)
+//
+// Returns nonzero if the bits need to be translated and handled as special.
+//
+static inline SBFP_CORE_CONSTEXPR int sbfp_core_is_special(int bits)
+{
+	//
+	// SBFP_NEG_INF and SBFP_NAN differ from SBFP_POS_INF only in these bits:
+	//
+	const int aliasBits = (SBFP_POS_INF ^ SBFP_NEG_INF) | (SBFP_POS_INF ^ SBFP_NAN);
+
+	return ((bits & ~aliasBits) == SBFP_POS_INF) | (((bits >> SBFP_BIT_COUNT_FRAC) & SBFP_EXPO_MASK) == SBFP_EXPO_MASK);
+}
+
+//
+// Translates given IEEE binary16 bits back to the sbfp_t type (see sbfp_core_to_binary16). The
+// arithmetic only produces the quiet NaN BINARY16_NAN, so with SBFP_IEEE_BINARY16 the
+// bits are already the result. Otherwise only infinity and NaN results are translated,
+// behind a branch that finite results predict well.
+//
+// [in] bits - the binary16 bits to be translated
+//
+// Returns the sbfp_t value.
+//
+static inline SBFP_CORE_CONSTEXPR sbfp_t sbfp_core_from_binary16(int bits)
+{
+#ifdef SBFP_IEEE_BINARY16
+	return bits;
+#else
+	if (((bits >> SBFP_BIT_COUNT_FRAC) & SBFP_EXPO_MASK) == SBFP_EXPO_MASK)
+	{
+		bits = sbfp_core_binary16_to_legacy(bits);
+	}
+
+	return bits;
+#endif
+}
+
+//
+// Packs a sign and an exact magnitude sig * 2^expo into binary16 bits, following the
+// rules of double_to_sbfp_round: the magnitude is rounded in the given mode, an exact
+// zero is +0 (unless SBFP_SIGNED_ZERO), 2^-14 becomes zero when truncated or else one of
+// its neighbours (if SBFP_ZERO_MIN_NORMAL), and magnitudes that round to 2^16 or above
+// become infinity, or BINARY16_MAX where they saturate (see sbfp_core_round_saturates).
+//
+// The significand may also stand for an inexact magnitude, as long as its lowest bit is
+// set for any nonzero bits below it and lies below every bit that decides the rounding.
+// Stochastic rounding then takes that bit for the exact remainder.
+//
+// [in] sign   - the sign (1 if negative, which also applies to an exact zero if SBFP_SIGNED_ZERO)
+// [in] sig    - the significand
+// [in] expo   - the unbiased exponent of the significand's least significant bit
+// [in] mode   - the rounding mode (see SBFP_ROUND_NEAREST_EVEN)
+// [in] random - random bits for SBFP_ROUND_STOCHASTIC (see sbfp_core_round_up)
+//
+// Returns the binary16 bits.
+//
+SBFP_CORE_ROUND_INLINE int sbfp_core_pack_binary16_round(int sign, uint64_t sig, int expo, int mode, uint64_t random)
+{
+	int status = 0;
+	int bits   = 0;
+
+	//
+	// Determine zero:
+	//
+	bool isZero = (sig == 0);
+
+	if (status == 0)
+	{
+		if (isZero)
+		{
+			bits = 0;
+
+			status = 1;
+		}
+	}
+
+	//
+	// Determine the biased expo, which is 1 for subnormals, and infinity:
+	//
+	int sbfpExpo = 0;
+
+	if (status == 0)
+	{
+		sbfpExpo = (63 - sbfp_core_count_leading_zeros(sig)) + expo + SBFP_BIAS;
+
+		if (sbfpExpo >= SBFP_EXPO_MASK)
+		{
+			bits = sbfp_core_round_saturates(mode, (uint64_t)sign) ? BINARY16_MAX : BINARY16_POS_INF;
+
+			status = 1;
+		}
+		else if (sbfpExpo < 1)
+		{
+			sbfpExpo = 1;
+		}
+	}
+
+	//
+	// Align the significand to the frac, rounding with the bits shifted out. The implicit
+	// bit of a normal result carries into the expo, and a subnormal result has none. So does
+	// a carry out of the frac when rounding up, which gives BINARY16_POS_INF past the
+	// largest normal:
+	//
+	if (status == 0)
+	{
+		int shift = sbfpExpo - SBFP_BIAS - SBFP_BIT_COUNT_FRAC - expo;
+
+		int shiftRight = (shift > 0) ? shift : 0;
+		int shiftLeft  = (shift < 0) ? -shift : 0;
+
+		shiftRight = (shiftRight > 63) ? 63 : shiftRight; // the significand never uses bit 63
+
+		uint64_t rem  = sig & ((1ULL << shiftRight) - 1);
+		uint64_t half = (shiftRight > 0) ? (1ULL << (shiftRight - 1)) : 1;
+
+		sig = (sig >> shiftRight) << shiftLeft;
+
+		uint64_t roundUp = sbfp_core_round_up(mode, (uint64_t)sign, sig & 1, rem, half, random);
+
+		bits = ((sbfpExpo - 1) << SBFP_BIT_COUNT_FRAC) + (int)(sig + roundUp);
+
+#if SBFP_ZERO_MIN_NORMAL
+		//
+		// Magnitudes in [2^-14, (1 + 2^-10) * 2^-14) are subnormals with a zero frac, or round
+		// to a neighbour of 2^-14 in the other modes:
+		//
+		if (bits == (1 << SBFP_BIT_COUNT_FRAC))
+		{
+			uint64_t isAbove = (uint64_t)(rem != 0) & (roundUp ^ 1);
+
+			bits = (int)sbfp_core_round_min_normal(mode, (uint64_t)sign, isAbove, random);
+		}
+#endif
+	}
+
+	//
+	// Concatenate the sign (an exact zero has none unless SBFP_SIGNED_ZERO), and return:
+	//
+	if (!isZero || SBFP_SIGNED_ZERO)
+	{
+		bits |= sign << (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC);
+	}
+
+	return bits;
+}
+
+//
+// Packs a sign and an exact magnitude sig * 2^expo into binary16 bits, rounding the
+// magnitude to nearest even (see sbfp_core_pack_binary16_round).
+//
+// [in] sign - the sign (1 if negative, which also applies to an exact zero if SBFP_SIGNED_ZERO)
+// [in] sig  - the significand
+// [in] expo - the unbiased exponent of the significand's least significant bit
+//
+// Returns the binary16 bits.
+//
+static inline SBFP_CORE_CONSTEXPR int sbfp_core_pack_binary16(int sign, uint64_t sig, int expo)
+{
+	return sbfp_core_pack_binary16_round(sign, sig, expo, SBFP_ROUND_NEAREST_EVEN, 0);
+}
+
+//
+// Classifies given binary16 bits as zero, subnormal, normal, infinity or NaN.
+//
+// [in] bits - the binary16 bits to be classified
+//
+// Returns the SBFP_CLASS_* value.
+//
+static inline SBFP_CORE_CONSTEXPR int sbfp_core_classify_binary16(int bits)
+{
+	int sbfpExpo = (bits >> SBFP_BIT_COUNT_FRAC) & SBFP_EXPO_MASK;
+	int hasFrac  = (bits & SBFP_FRAC_MASK) != 0;
+
+	int sbfpClass = SBFP_CLASS_NORMAL;
+
+	sbfpClass = (sbfpExpo == 0)              ? SBFP_CLASS_ZERO + hasFrac : sbfpClass; // zero or subnormal
+	sbfpClass = (sbfpExpo == SBFP_EXPO_MASK) ? SBFP_CLASS_INF + hasFrac  : sbfpClass; // infinity or NaN
+
+	return sbfpClass;
+}
+
+//
+// Outcomes of multiplying and adding operands by their classes, indexed as
+// [multiplicand or augend][multiplier or addend]:
+//
+static SBFP_CORE_CONSTEXPR const unsigned char sbfpMulOutcomes[SBFP_CLASS_COUNT][SBFP_CLASS_COUNT] =
+{
+	//  zero                 subnormal             normal                inf                   NaN
+	{ SBFP_OUTCOME_FINITE, SBFP_OUTCOME_FINITE,  SBFP_OUTCOME_FINITE,  SBFP_OUTCOME_NAN,     SBFP_OUTCOME_NAN }, // zero
+	{ SBFP_OUTCOME_FINITE, SBFP_OUTCOME_FINITE,  SBFP_OUTCOME_FINITE,  SBFP_OUTCOME_INF_XOR, SBFP_OUTCOME_NAN }, // subnormal
+	{ SBFP_OUTCOME_FINITE, SBFP_OUTCOME_FINITE,  SBFP_OUTCOME_FINITE,  SBFP_OUTCOME_INF_XOR, SBFP_OUTCOME_NAN }, // normal
+	{ SBFP_OUTCOME_NAN,    SBFP_OUTCOME_INF_XOR, SBFP_OUTCOME_INF_XOR, SBFP_OUTCOME_INF_XOR, SBFP_OUTCOME_NAN }, // inf
+	{ SBFP_OUTCOME_NAN,    SBFP_OUTCOME_NAN,     SBFP_OUTCOME_NAN,     SBFP_OUTCOME_NAN,     SBFP_OUTCOME_NAN }, // NaN
+};
+
+static SBFP_CORE_CONSTEXPR const unsigned char sbfpAddOutcomes[SBFP_CLASS_COUNT][SBFP_CLASS_COUNT] =
+{
+	//  zero                 subnormal             normal                inf                   NaN
+	{ SBFP_OUTCOME_FINITE, SBFP_OUTCOME_FINITE,  SBFP_OUTCOME_FINITE,  SBFP_OUTCOME_SECOND,  SBFP_OUTCOME_NAN }, // zero
+	{ SBFP_OUTCOME_FINITE, SBFP_OUTCOME_FINITE,  SBFP_OUTCOME_FINITE,  SBFP_OUTCOME_SECOND,  SBFP_OUTCOME_NAN }, // subnormal
+	{ SBFP_OUTCOME_FINITE, SBFP_OUTCOME_FINITE,  SBFP_OUTCOME_FINITE,  SBFP_OUTCOME_SECOND,  SBFP_OUTCOME_NAN }, // normal
+	{ SBFP_OUTCOME_FIRST,  SBFP_OUTCOME_FIRST,   SBFP_OUTCOME_FIRST,   SBFP_OUTCOME_INF_SUM, SBFP_OUTCOME_NAN }, // inf
+	{ SBFP_OUTCOME_NAN,    SBFP_OUTCOME_NAN,     SBFP_OUTCOME_NAN,     SBFP_OUTCOME_NAN,     SBFP_OUTCOME_NAN }, // NaN
+};
+
+//
+// Computes the result of an operation whose outcome (see sbfpMulOutcomes, sbfpAddOutcomes
+// and sbfpDivOutcomes) is not SBFP_OUTCOME_FINITE, which is always the case when an operand is
+// infinity or NaN.
+//
+// [in] outcome - the SBFP_OUTCOME_* value
+// [in] bits1   - the first operand
+// [in] bits2   - the second operand
+//
+// Returns the binary16 result.
+//
+static inline SBFP_CORE_CONSTEXPR int sbfp_core_handle_special(int outcome, int bits1, int bits2)
+{
+	int bitsResult = BINARY16_NAN;
+
+	switch (outcome)
+	{
+		case SBFP_OUTCOME_FIRST:
+		{
+			bitsResult = bits1;
+			break;
+		}
+
+		case SBFP_OUTCOME_SECOND:
+		{
+			bitsResult = bits2;
+			break;
+		}
+
+		case SBFP_OUTCOME_INF_XOR:
+		{
+			bitsResult = BINARY16_POS_INF | ((bits1 ^ bits2) & (1 << (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC)));
+			break;
+		}
+
+		case SBFP_OUTCOME_INF_SUM:
+		{
+			bitsResult = (bits1 == bits2) ? bits1 : BINARY16_NAN;
+			break;
+		}
+
+		case SBFP_OUTCOME_ZERO_XOR:
+		{
+			bitsResult = SBFP_SIGNED_ZERO ? ((bits1 ^ bits2) & (1 << (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC))) : 0;
+			break;
+		}
+
+		default:
+		{
+			bitsResult = BINARY16_NAN;
+			break;
+		}
+	}
+
+	return bitsResult;
+}
+
+//
+// Multiplies two sbfp values with the arithmetic engine, rounding in a given mode.
+//
+// The significands are multiplied as integers, so the product is exact before it is
+// packed. It is then rounded like double_to_sbfp_round would round the exact product.
+//
+// [in] sbfpValue1 - the multiplicand
+// [in] sbfpValue2 - the multiplier
+// [in] mode       - the rounding mode (see SBFP_ROUND_NEAREST_EVEN)
+// [in] random     - random bits for SBFP_ROUND_STOCHASTIC (see sbfp_core_round_up)
+//
+// Returns the product.
+//
+SBFP_CORE_ROUND_INLINE sbfp_t sbfp_core_multiply_round(sbfp_t sbfpValue1, sbfp_t sbfpValue2, int mode, uint64_t random)
+{
+	int status = 0;
+
+	int bitsProduct = 0;
+
+	//
+	// Extract the frac, expo and sign of both sbfp values:
+	//
+	int bits1 = sbfpValue1 & SBFP_BIT_MASK;
+	int bits2 = sbfpValue2 & SBFP_BIT_MASK;
+
+	int sbfpFrac1 = bits1 & SBFP_FRAC_MASK;
+	int sbfpExpo1 = (bits1 >> SBFP_BIT_COUNT_FRAC) & SBFP_EXPO_MASK;
+	int sbfpSign1 = bits1 >> (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC);
+
+	int sbfpFrac2 = bits2 & SBFP_FRAC_MASK;
+	int sbfpExpo2 = (bits2 >> SBFP_BIT_COUNT_FRAC) & SBFP_EXPO_MASK;
+	int sbfpSign2 = bits2 >> (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC);
+
+	//
+	// Handle if the sbfp values are infinity or NaN:
+	//
+	if (status == 0)
+	{
+		if (sbfp_core_is_special(bits1) | sbfp_core_is_special(bits2))
+		{
+			int special1 = sbfp_core_to_binary16(sbfpValue1);
+			int special2 = sbfp_core_to_binary16(sbfpValue2);
+
+			bitsProduct = sbfp_core_handle_special(sbfpMulOutcomes[sbfp_core_classify_binary16(special1)][sbfp_core_classify_binary16(special2)], special1, special2);
+
+			status = 1;
+		}
+	}
+
+	//
+	// Multiply the significands (with the implicit bit for normals), add the expos, and
+	// return:
+	//
+	if (status == 0)
+	{
+		uint32_t M1 = (uint32_t)sbfpFrac1 | ((uint32_t)(sbfpExpo1 != 0) << SBFP_BIT_COUNT_FRAC);
+		uint32_t M2 = (uint32_t)sbfpFrac2 | ((uint32_t)(sbfpExpo2 != 0) << SBFP_BIT_COUNT_FRAC);
+
+		int E1 = sbfpExpo1 + (sbfpExpo1 == 0) - SBFP_BIAS - SBFP_BIT_COUNT_FRAC;
+		int E2 = sbfpExpo2 + (sbfpExpo2 == 0) - SBFP_BIAS - SBFP_BIT_COUNT_FRAC;
+
+		bitsProduct = sbfp_core_pack_binary16_round(sbfpSign1 ^ sbfpSign2, M1 * M2, E1 + E2, mode, random);
+	}
+
+	return sbfp_core_from_binary16(bitsProduct);
+}
+
+//
+// Multiplies two sbfp values with the arithmetic engine, rounding the product like
+// double_to_sbfp would round it (see sbfp_core_multiply_round).
+//
+// [in] sbfpValue1 - the multiplicand
+// [in] sbfpValue2 - the multiplier
+//
+// Returns the product.
+//
+static inline SBFP_CORE_CONSTEXPR sbfp_t sbfp_core_multiply_arithmetic(sbfp_t sbfpValue1, sbfp_t sbfpValue2)
+{
+	return sbfp_core_multiply_round(sbfpValue1, sbfpValue2, SBFP_ROUND_NEAREST_EVEN, 0);
+}
+
+//
+// Adds two sbfp values, or subtracts the second from the first, rounding in a given mode.
+//
+// The significands are aligned to the smaller expo as integers. Every sum of two sbfp
+// values fits in 41 bits that way, so it is exact before it is packed, and it rounds like
+// double_to_sbfp_round would round the exact sum. No guard, round or sticky bits are
+// needed, nor an ordering of the operands by magnitude. A subtraction flips the addend's
+// sign once it is in binary16, as flipping the sign bit of SBFP_POS_INF or SBFP_NAN in the
+// original encoding would give a finite value.
+//
+// [in] sbfpValue1 - the augend
+// [in] sbfpValue2 - the addend
+// [in] negate2    - 1 to subtract the addend, 0 to add it
+// [in] mode       - the rounding mode (see SBFP_ROUND_NEAREST_EVEN)
+// [in] random     - random bits for SBFP_ROUND_STOCHASTIC (see sbfp_core_round_up)
+//
+// Returns the sum.
+//
+SBFP_CORE_ROUND_INLINE sbfp_t sbfp_core_add_round(sbfp_t sbfpValue1, sbfp_t sbfpValue2, int negate2, int mode,
+	uint64_t random)
+{
+	int status = 0;
+
+	int bitsSum = 0;
+
+	//
+	// Extract the frac, expo and sign of both sbfp values:
+	//
+	int bits1 = sbfpValue1 & SBFP_BIT_MASK;
+	int bits2 = sbfpValue2 & SBFP_BIT_MASK;
+
+	int sbfpFrac1 = bits1 & SBFP_FRAC_MASK;
+	int sbfpExpo1 = (bits1 >> SBFP_BIT_COUNT_FRAC) & SBFP_EXPO_MASK;
+	int sbfpSign1 = bits1 >> (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC);
+
+	int sbfpFrac2 = bits2 & SBFP_FRAC_MASK;
+	int sbfpExpo2 = (bits2 >> SBFP_BIT_COUNT_FRAC) & SBFP_EXPO_MASK;
+	int sbfpSign2 = (bits2 >> (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC)) ^ negate2;
+
+	//
+	// Handle if the sbfp values are infinity or NaN:
+	//
+	if (status == 0)
+	{
+		if (sbfp_core_is_special(bits1) | sbfp_core_is_special(bits2))
+		{
+			int special1 = sbfp_core_to_binary16(sbfpValue1);
+			int special2 = sbfp_core_to_binary16(sbfpValue2) ^ (negate2 << (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC));
+
+			bitsSum = sbfp_core_handle_special(sbfpAddOutcomes[sbfp_core_classify_binary16(special1)][sbfp_core_classify_binary16(special2)], special1, special2);
+
+			status = 1;
+		}
+	}
+
+	//
+	// Align the significands (with the implicit bit for normals) to the smaller expo,
+	// add them with their signs, and return:
+	//
+	if (status == 0)
+	{
+		int64_t M1 = sbfpFrac1 | ((sbfpExpo1 != 0) << SBFP_BIT_COUNT_FRAC);
+		int64_t M2 = sbfpFrac2 | ((sbfpExpo2 != 0) << SBFP_BIT_COUNT_FRAC);
+
+		int E1 = sbfpExpo1 + (sbfpExpo1 == 0);
+		int E2 = sbfpExpo2 + (sbfpExpo2 == 0);
+		int E  = (E1 < E2) ? E1 : E2;
+
+		M1 <<= E1 - E;
+		M2 <<= E2 - E;
+
+		M1 = (M1 ^ (0 - (int64_t)sbfpSign1)) + sbfpSign1;
+		M2 = (M2 ^ (0 - (int64_t)sbfpSign2)) + sbfpSign2;
+
+		int64_t M        = M1 + M2;
+		int64_t signMask = M >> 63;
+
+		//
+		// An exact zero sum is negative only if both sbfp values are, or if either is when
+		// rounding downward:
+		//
+		int sign = (int)(signMask & 1) | (sbfpSign1 & sbfpSign2) |
+		           ((sbfpSign1 | sbfpSign2) & (M == 0) & (mode == SBFP_ROUND_DOWNWARD));
+
+		bitsSum = sbfp_core_pack_binary16_round(sign, (uint64_t)((M ^ signMask) - signMask), E - SBFP_BIAS - SBFP_BIT_COUNT_FRAC, mode, random);
+	}
+
+	return sbfp_core_from_binary16(bitsSum);
+}
+
+//
+// Adds two sbfp values, or subtracts the second from the first, rounding the result like
+// double_to_sbfp would round it (see sbfp_core_add_round).
+//
+// [in] sbfpValue1 - the augend
+// [in] sbfpValue2 - the addend
+// [in] negate2    - 1 to subtract the addend, 0 to add it
+//
+// Returns the sum.
+//
+static inline SBFP_CORE_CONSTEXPR sbfp_t sbfp_core_add(sbfp_t sbfpValue1, sbfp_t sbfpValue2, int negate2)
+{
+	return sbfp_core_add_round(sbfpValue1, sbfpValue2, negate2, SBFP_ROUND_NEAREST_EVEN, 0);
+}
+
+#endif
@@ -0,0 +1,432 @@
+//
+// sbfp_format.h
+//
+// This file contains conversions and arithmetic for binary floating point formats of any
+// width, as static inline functions whose first parameters are the format's expo width,
+// frac width and bias. Called with constant widths, as through the SBFP_FORMAT_* macros,
+// they are inlined and folded into code specialized for that format, so that one binary
+// can work with several formats. sbfp_lib.hpp wraps them in the sbfp::format template.
+//
+// The formats follow IEEE 754 like sbfp_t does with SBFP_IEEE_BINARY16: the largest expo
+// encodes infinity and NaN, and zeros keep their sign. Results are truncated toward zero
+// as SBFP_ROUND_TRUNCATE truncates an sbfp value, and magnitudes beyond the largest finite
+// value become infinity. A format may have 2 to 10
+// expo bits and 1 to 30 frac bits, in at most 32 bits. Values are held in the low bits of
+// a uint32_t.
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2021 Luke Andrews.  All Rights Reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify, merge,
+// publish, distribute, sub-license, and/or sell copies of the Software, and to permit persons
+// to whom the Software is furnished to do so, subject to the following conditions:
+//
+// * The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+// PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR 
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+#ifndef SBFP_FORMAT_H
+#define SBFP_FORMAT_H
+
+#include "sbfp_const.h"
+#include "sbfp_core.h"
+#include <stdint.h>
+
+//
+// Arguments of the sbfp_format_* functions for common formats (expo bits, frac bits, bias):
+//
+#define SBFP_FORMAT_BINARY16 5, 10, 15
+#define SBFP_FORMAT_BFLOAT16 8, 7, 127
+#define SBFP_FORMAT_E5M2     5, 2, 15
+
+#if defined(__GNUC__)
+#define SBFP_FORMAT_INLINE static inline __attribute__((always_inline)) SBFP_CORE_CONSTEXPR
+#else
+#define SBFP_FORMAT_INLINE static inline SBFP_CORE_CONSTEXPR
+#endif
+
+//
+// Converts a given double value to a format, truncating it toward zero.
+//
+// [in] expoBits - the number of expo bits of the format
+// [in] fracBits - the number of frac bits of the format
+// [in] bias     - the expo bias of the format
+// [in] dblValue - the double value to be converted
+//
+// Returns the bits of the converted value.
+//
+SBFP_FORMAT_INLINE uint32_t sbfp_format_encode_double(int expoBits, int fracBits, int bias, double dblValue)
+{
+	int expoMask = (1 << expoBits) - 1;
+
+	//
+	// Extract the magnitude, expo and sign:
+	//
+	uint64_t dblBits      = sbfp_core_double_bits(dblValue);
+	uint64_t dblMagnitude = dblBits & DOUBLE_MAGNITUDE_MASK;
+	uint64_t dblExpo      = dblMagnitude >> DOUBLE_BIT_COUNT_FRAC;
+	uint64_t fmtSign      = dblBits >> (DOUBLE_BIT_COUNT_EXPO + DOUBLE_BIT_COUNT_FRAC);
+
+	//
+	// Normal: rebias the expo and keep the top frac bits:
+	//
+	uint64_t fmtNormal = (dblMagnitude >> (DOUBLE_BIT_COUNT_FRAC - fracBits)) - ((uint64_t)(DOUBLE_BIAS - bias) << fracBits);
+
+	//
+	// Subnormal: shift the full significand down to units of the smallest subnormal. The
+	// shift is clamped so that values far below the format's range simply become 0:
+	//
+	uint64_t dblSig   = (dblMagnitude & DOUBLE_FRAC_MASK) | (1ULL << DOUBLE_BIT_COUNT_FRAC);
+	uint64_t subShift = (uint64_t)(DOUBLE_BIAS + DOUBLE_BIT_COUNT_FRAC - (bias - 1) - fracBits) - dblExpo;
+
+	uint64_t fmtSubnormal = dblSig >> (subShift < 63 ? subShift : 63);
+
+	uint64_t fmtBits = (dblExpo > (uint64_t)(DOUBLE_BIAS - bias)) ? fmtNormal : fmtSubnormal;
+
+	//
+	// Concatenate the sign, and determine infinity (from the smallest magnitude that
+	// overflows, 2^(expoMask - bias)) and NaN:
+	//
+	uint64_t overflowBits = (uint64_t)(DOUBLE_BIAS + expoMask - bias) << DOUBLE_BIT_COUNT_FRAC;
+
+	fmtBits = (dblMagnitude >= overflowBits) ? ((uint64_t)expoMask << fracBits) : fmtBits;
+	fmtBits |= fmtSign << (expoBits + fracBits);
+	fmtBits = (dblMagnitude > DOUBLE_INF_BITS) ? (((uint64_t)expoMask << fracBits) | (1ULL << (fracBits - 1))) : fmtBits;
+
+	return (uint32_t)fmtBits;
+}
+
+//
+// Converts a value of a format to a double value, which holds it exactly.
+//
+// [in] expoBits - the number of expo bits of the format
+// [in] fracBits - the number of frac bits of the format
+// [in] bias     - the expo bias of the format
+// [in] fmtBits  - the bits of the value to be converted
+//
+// Returns the double value, with NaN as DOUBLE_NAN_BITS.
+//
+SBFP_FORMAT_INLINE double sbfp_format_decode_double(int expoBits, int fracBits, int bias, uint32_t fmtBits)
+{
+	uint32_t expoMask = (1U << expoBits) - 1;
+	uint32_t fracMask = (1U << fracBits) - 1;
+
+	//
+	// Extract the magnitude, frac, expo and sign:
+	//
+	uint32_t fmtMagnitude = fmtBits & ((1U << (expoBits + fracBits)) - 1);
+	uint32_t fmtFrac      = fmtMagnitude & fracMask;
+	uint32_t fmtExpo      = fmtMagnitude >> fracBits;
+
+	uint64_t dblSign = (uint64_t)((fmtBits >> (expoBits + fracBits)) & 1) << (DOUBLE_BIT_COUNT_EXPO + DOUBLE_BIT_COUNT_FRAC);
+
+	//
+	// Normal: move the expo and frac into place together and rebias the expo:
+	//
+	uint64_t dblNormal = ((uint64_t)fmtMagnitude << (DOUBLE_BIT_COUNT_FRAC - fracBits)) +
+	                     ((uint64_t)(DOUBLE_BIAS - bias) << DOUBLE_BIT_COUNT_FRAC);
+
+	//
+	// Subnormal: the frac counts units of the smallest subnormal, 2^(1 - bias - fracBits):
+	//
+	double   dblUnit      = sbfp_core_bits_double((uint64_t)(DOUBLE_BIAS + 1 - bias - fracBits) << DOUBLE_BIT_COUNT_FRAC);
+	uint64_t dblSubnormal = sbfp_core_double_bits((double)fmtFrac * dblUnit);
+
+	//
+	// Select the case, concatenate the sign (NaN has its own) and return:
+	//
+	uint64_t isSubnormal = 0 - (uint64_t)(fmtExpo == 0);
+	uint64_t isSpecial   = 0 - (uint64_t)(fmtExpo == expoMask);
+	uint64_t isNan       = isSpecial & (0 - (uint64_t)(fmtFrac != 0));
+
+	uint64_t dblBits = (dblNormal & ~isSubnormal) | (dblSubnormal & isSubnormal);
+
+	dblBits = (dblBits & ~isSpecial) | (DOUBLE_INF_BITS & isSpecial);
+	dblBits |= dblSign;
+	dblBits = (dblBits & ~isNan) | (DOUBLE_NAN_BITS & isNan);
+
+	return sbfp_core_bits_double(dblBits);
+}
+
+//
+// Packs a sign and an exact magnitude sig * 2^expo into the bits of a format, truncating
+// the magnitude toward zero (see sbfp_core_pack_binary16).
+//
+// [in] expoBits - the number of expo bits of the format
+// [in] fracBits - the number of frac bits of the format
+// [in] bias     - the expo bias of the format
+// [in] sign     - the sign (1 if negative, which also applies to an exact zero)
+// [in] sig      - the significand
+// [in] expo     - the unbiased exponent of the significand's least significant bit
+//
+// Returns the bits of the packed value.
+//
+SBFP_FORMAT_INLINE uint32_t sbfp_format_pack(int expoBits, int fracBits, int bias, int sign, uint64_t sig, int expo)
+{
+	int expoMask = (1 << expoBits) - 1;
+
+	uint32_t fmtBits = 0;
+
+	//
+	// Determine the biased expo, which is 1 for subnormals, and infinity:
+	//
+	if (sig != 0)
+	{
+		int fmtExpo = (63 - sbfp_core_count_leading_zeros(sig)) + expo + bias;
+
+		if (fmtExpo >= expoMask)
+		{
+			fmtBits = (uint32_t)expoMask << fracBits;
+		}
+		else
+		{
+			fmtExpo = (fmtExpo < 1) ? 1 : fmtExpo;
+
+			//
+			// Align the significand to the frac, truncating the bits shifted out:
+			//
+			int shift = fmtExpo - bias - fracBits - expo;
+
+			int shiftRight = (shift > 0) ? shift : 0;
+			int shiftLeft  = (shift < 0) ? -shift : 0;
+
+			shiftRight = (shiftRight > 63) ? 63 : shiftRight;
+
+			fmtBits = ((uint32_t)(fmtExpo - 1) << fracBits) + (uint32_t)((sig >> shiftRight) << shiftLeft);
+		}
+	}
+
+	return fmtBits | ((uint32_t)sign << (expoBits + fracBits));
+}
+
+//
+// Computes the result of an operation on two values of a format whose outcome (see
+// sbfpMulOutcomes and sbfpAddOutcomes) is not SBFP_OUTCOME_FINITE.
+//
+// [in] expoBits - the number of expo bits of the format
+// [in] fracBits - the number of frac bits of the format
+// [in] outcome  - the SBFP_OUTCOME_* value
+// [in] fmtBits1 - the first operand
+// [in] fmtBits2 - the second operand
+//
+// Returns the bits of the result.
+//
+SBFP_FORMAT_INLINE uint32_t sbfp_format_handle_special(int expoBits, int fracBits, int outcome, uint32_t fmtBits1, uint32_t fmtBits2)
+{
+	uint32_t infBits  = ((1U << expoBits) - 1) << fracBits;
+	uint32_t nanBits  = infBits | (1U << (fracBits - 1));
+	uint32_t signMask = 1U << (expoBits + fracBits);
+
+	uint32_t fmtResult = nanBits;
+
+	switch (outcome)
+	{
+		case SBFP_OUTCOME_FIRST:
+		{
+			fmtResult = fmtBits1;
+			break;
+		}
+
+		case SBFP_OUTCOME_SECOND:
+		{
+			fmtResult = fmtBits2;
+			break;
+		}
+
+		case SBFP_OUTCOME_INF_XOR:
+		{
+			fmtResult = infBits | ((fmtBits1 ^ fmtBits2) & signMask);
+			break;
+		}
+
+		case SBFP_OUTCOME_INF_SUM:
+		{
+			fmtResult = (fmtBits1 == fmtBits2) ? fmtBits1 : nanBits;
+			break;
+		}
+
+		default:
+		{
+			fmtResult = nanBits;
+			break;
+		}
+	}
+
+	return fmtResult;
+}
+
+//
+// Classifies the bits of a value of a format as zero, subnormal, normal, infinity or NaN.
+//
+// [in] expoBits - the number of expo bits of the format
+// [in] fracBits - the number of frac bits of the format
+// [in] fmtBits  - the bits to be classified
+//
+// Returns the SBFP_CLASS_* value.
+//
+SBFP_FORMAT_INLINE int sbfp_format_classify(int expoBits, int fracBits, uint32_t fmtBits)
+{
+	uint32_t expoMask = (1U << expoBits) - 1;
+	uint32_t fmtExpo  = (fmtBits >> fracBits) & expoMask;
+	int      hasFrac  = (fmtBits & ((1U << fracBits) - 1)) != 0;
+
+	int fmtClass = SBFP_CLASS_NORMAL;
+
+	fmtClass = (fmtExpo == 0)        ? SBFP_CLASS_ZERO + hasFrac : fmtClass; // zero or subnormal
+	fmtClass = (fmtExpo == expoMask) ? SBFP_CLASS_INF + hasFrac  : fmtClass; // infinity or NaN
+
+	return fmtClass;
+}
+
+//
+// Multiplies two values of a format. The significands are multiplied as integers, so the
+// product is exact before it is truncated.
+//
+// [in] expoBits - the number of expo bits of the format
+// [in] fracBits - the number of frac bits of the format
+// [in] bias     - the expo bias of the format
+// [in] fmtBits1 - the multiplicand
+// [in] fmtBits2 - the multiplier
+//
+// Returns the bits of the product.
+//
+SBFP_FORMAT_INLINE uint32_t sbfp_format_mul(int expoBits, int fracBits, int bias, uint32_t fmtBits1, uint32_t fmtBits2)
+{
+	uint32_t expoMask = (1U << expoBits) - 1;
+	uint32_t fracMask = (1U << fracBits) - 1;
+
+	uint32_t fmtProduct = 0;
+
+	//
+	// Extract the frac, expo and sign of both values:
+	//
+	uint32_t fmtFrac1 = fmtBits1 & fracMask;
+	uint32_t fmtExpo1 = (fmtBits1 >> fracBits) & expoMask;
+	int      fmtSign1 = (fmtBits1 >> (expoBits + fracBits)) & 1;
+
+	uint32_t fmtFrac2 = fmtBits2 & fracMask;
+	uint32_t fmtExpo2 = (fmtBits2 >> fracBits) & expoMask;
+	int      fmtSign2 = (fmtBits2 >> (expoBits + fracBits)) & 1;
+
+	if (fmtExpo1 == expoMask || fmtExpo2 == expoMask)
+	{
+		//
+		// Infinity or NaN:
+		//
+		int outcome = sbfpMulOutcomes[sbfp_format_classify(expoBits, fracBits, fmtBits1)][sbfp_format_classify(expoBits, fracBits, fmtBits2)];
+
+		fmtProduct = sbfp_format_handle_special(expoBits, fracBits, outcome, fmtBits1, fmtBits2);
+	}
+	else
+	{
+		//
+		// Multiply the significands (with the implicit bit for normals) and add the expos:
+		//
+		uint64_t M1 = fmtFrac1 | ((uint64_t)(fmtExpo1 != 0) << fracBits);
+		uint64_t M2 = fmtFrac2 | ((uint64_t)(fmtExpo2 != 0) << fracBits);
+
+		int E1 = (int)fmtExpo1 + (fmtExpo1 == 0) - bias - fracBits;
+		int E2 = (int)fmtExpo2 + (fmtExpo2 == 0) - bias - fracBits;
+
+		fmtProduct = sbfp_format_pack(expoBits, fracBits, bias, fmtSign1 ^ fmtSign2, M1 * M2, E1 + E2);
+	}
+
+	return fmtProduct;
+}
+
+//
+// Adds two values of a format, or subtracts the second from the first.
+//
+// The smaller magnitude is aligned to the larger one with two guard bits. In a
+// subtraction, a sticky bit then stands for any bits shifted out, so that the difference
+// truncates like the exact one. The expos of wide formats differ by too much to align the
+// significands exactly as sbfp_core_add does.
+//
+// [in] expoBits - the number of expo bits of the format
+// [in] fracBits - the number of frac bits of the format
+// [in] bias     - the expo bias of the format
+// [in] fmtBits1 - the augend
+// [in] fmtBits2 - the addend
+// [in] negate2  - 1 to subtract the addend, 0 to add it
+//
+// Returns the bits of the sum.
+//
+SBFP_FORMAT_INLINE uint32_t sbfp_format_add(int expoBits, int fracBits, int bias, uint32_t fmtBits1, uint32_t fmtBits2, int negate2)
+{
+	const int guardBits = 2;
+
+	uint32_t expoMask      = (1U << expoBits) - 1;
+	uint32_t fracMask      = (1U << fracBits) - 1;
+	uint32_t magnitudeMask = (1U << (expoBits + fracBits)) - 1;
+
+	uint32_t fmtSum = 0;
+
+	fmtBits2 ^= (uint32_t)negate2 << (expoBits + fracBits);
+
+	uint32_t fmtExpo1 = (fmtBits1 >> fracBits) & expoMask;
+	uint32_t fmtExpo2 = (fmtBits2 >> fracBits) & expoMask;
+
+	if (fmtExpo1 == expoMask || fmtExpo2 == expoMask)
+	{
+		//
+		// Infinity or NaN:
+		//
+		int outcome = sbfpAddOutcomes[sbfp_format_classify(expoBits, fracBits, fmtBits1)][sbfp_format_classify(expoBits, fracBits, fmtBits2)];
+
+		fmtSum = sbfp_format_handle_special(expoBits, fracBits, outcome, fmtBits1, fmtBits2);
+	}
+	else
+	{
+		//
+		// Order the operands so that X has the larger magnitude:
+		//
+		bool     isSwapped = (fmtBits2 & magnitudeMask) > (fmtBits1 & magnitudeMask);
+		uint32_t fmtBitsX  = isSwapped ? fmtBits2 : fmtBits1;
+		uint32_t fmtBitsY  = isSwapped ? fmtBits1 : fmtBits2;
+
+		uint32_t fmtExpoX = (fmtBitsX >> fracBits) & expoMask;
+		uint32_t fmtExpoY = (fmtBitsY >> fracBits) & expoMask;
+
+		uint64_t MX = ((fmtBitsX & fracMask) | ((uint64_t)(fmtExpoX != 0) << fracBits)) << guardBits;
+		uint64_t MY = ((fmtBitsY & fracMask) | ((uint64_t)(fmtExpoY != 0) << fracBits)) << guardBits;
+
+		int EX = (int)fmtExpoX + (fmtExpoX == 0);
+		int EY = (int)fmtExpoY + (fmtExpoY == 0);
+
+		//
+		// Align MY to MX, keeping a sticky bit for the bits shifted out:
+		//
+		int shift = EX - EY;
+
+		shift = (shift > 63) ? 63 : shift;
+
+		uint64_t sticky = (MY & ((1ULL << shift) - 1)) != 0;
+
+		MY >>= shift;
+
+		int signX         = (fmtBitsX >> (expoBits + fracBits)) & 1;
+		int isSubtraction = ((fmtBits1 ^ fmtBits2) >> (expoBits + fracBits)) & 1;
+
+		uint64_t M = isSubtraction ? (MX - MY - sticky) : (MX + MY);
+
+		//
+		// An exact zero sum is negative only if both values are:
+		//
+		int sign = (M == 0) ? (int)((fmtBits1 & fmtBits2) >> (expoBits + fracBits)) & 1 : signX;
+
+		fmtSum = sbfp_format_pack(expoBits, fracBits, bias, sign, M, EX - bias - fracBits - guardBits);
+	}
+
+	return fmtSum;
+}
+
+#endif
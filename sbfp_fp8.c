@@ -0,0 +1,660 @@
+//
+// sbfp_fp8.c
+//
+// This file contains function definitions for 8-bit floating point formats, whose values
+// are stored as sbfp8_t (see sbfp_lib.h). Two formats are supported:
+// 		- SBFP8_E4M3
+// 			Sign = bit 7
+// 			Expo = bits 3-6 (bias 7)
+// 			Frac = bits 0-2
+// 		- SBFP8_E5M2
+// 			Sign = bit 7
+// 			Expo = bits 2-6 (bias 15)
+// 			Frac = bits 0-1
+// E5M2 follows IEEE 754 like binary16, whose top 8 bits it matches. E4M3 has no infinity:
+// its largest expo holds normal values up to 448, and only 0x7F and 0xFF are NaN. Values
+// are truncated toward zero, as SBFP_ROUND_TRUNCATE truncates an sbfp value. Magnitudes
+// beyond the largest finite value become infinity in E5M2 and saturate to 448 in E4M3,
+// which is where truncation toward zero stops when a format has no infinity.
+//
+// With 256 values per format, every sum and product is precomputed in 64 KB tables. The
+// tables hold one result per pair of operands, so the arithmetic has one rounding mode:
+// another would need tables of its own.
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2021 Luke Andrews.  All Rights Reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify, merge,
+// publish, distribute, sub-license, and/or sell copies of the Software, and to permit persons
+// to whom the Software is furnished to do so, subject to the following conditions:
+//
+// * The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+// PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR 
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+#undef SBFP_INLINE // the library defines the external functions
+
+#include "sbfp_const.h"
+#include "sbfp_core.h"
+#include "sbfp_format.h"
+#include "sbfp_lib.h"
+#include "sbfp_x86.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// Values converted at a time through a float buffer, which holds every sbfp and sbfp8 value exactly:
+#define SBFP8_CHUNK_COUNT 256
+
+//
+// Sums and products of every pair of values of each format, indexed by the format and
+// then (value1 << 8) | value2. The tables take 256 KB, and they are filled once when the
+// library is loaded (see fill_tables), so lookups need no check and no synchronization.
+//
+static uint8_t sbfp8AddTables[SBFP8_FORMAT_COUNT][1 << 16];
+static uint8_t sbfp8MulTables[SBFP8_FORMAT_COUNT][1 << 16];
+
+//
+// Gives the index of a format in the tables. Formats other than SBFP8_E5M2 are E4M3.
+//
+// [in] format - SBFP8_E4M3 or SBFP8_E5M2
+//
+// Returns the index.
+//
+static inline int format_index(int format)
+{
+	return (format == SBFP8_E5M2) ? SBFP8_E5M2 : SBFP8_E4M3;
+}
+
+//
+// Converts a given double value to the E4M3 format.
+//
+// The value is encoded in a format with one more expo bit, which holds the top binade of
+// E4M3 (up to 448) as normal values like E4M3 does. Magnitudes beyond 448, including
+// infinity, then saturate.
+//
+// [in] dblValue - the double value to be converted
+//
+// Returns the converted value.
+//
+static inline sbfp8_t encode_e4m3(double dblValue)
+{
+	uint32_t wideBits = sbfp_format_encode_double(E4M3_BIT_COUNT_EXPO + 1, E4M3_BIT_COUNT_FRAC, E4M3_BIAS, dblValue);
+
+	uint32_t wideMagnitude = wideBits & ((1U << (E4M3_BIT_COUNT_EXPO + 1 + E4M3_BIT_COUNT_FRAC)) - 1);
+	uint32_t wideSign      = wideBits >> (E4M3_BIT_COUNT_EXPO + 1 + E4M3_BIT_COUNT_FRAC);
+
+	uint32_t wideInf = ((1U << (E4M3_BIT_COUNT_EXPO + 1)) - 1) << E4M3_BIT_COUNT_FRAC;
+
+	uint32_t sbfp8Bits = (wideMagnitude > E4M3_MAX) ? E4M3_MAX : wideMagnitude;
+
+	sbfp8Bits |= wideSign << (E4M3_BIT_COUNT_EXPO + E4M3_BIT_COUNT_FRAC);
+	sbfp8Bits = (wideMagnitude > wideInf) ? E4M3_NAN : sbfp8Bits;
+
+	return (sbfp8_t)sbfp8Bits;
+}
+
+//
+// Converts a given E4M3 value to a double value, through the wider format of encode_e4m3.
+//
+// [in] sbfp8Value - the E4M3 value to be converted
+//
+// Returns the converted value.
+//
+static inline double decode_e4m3(sbfp8_t sbfp8Value)
+{
+	uint32_t sbfp8Magnitude = sbfp8Value & SBFP8_MAGNITUDE_MASK;
+	uint32_t sbfp8Sign      = sbfp8Value >> (E4M3_BIT_COUNT_EXPO + E4M3_BIT_COUNT_FRAC);
+
+	uint32_t wideBits = sbfp8Magnitude | (sbfp8Sign << (E4M3_BIT_COUNT_EXPO + 1 + E4M3_BIT_COUNT_FRAC));
+
+	double dblValue = sbfp_format_decode_double(E4M3_BIT_COUNT_EXPO + 1, E4M3_BIT_COUNT_FRAC, E4M3_BIAS, wideBits);
+
+	return (sbfp8Magnitude == E4M3_NAN) ? sbfp_core_bits_double(DOUBLE_NAN_BITS) : dblValue;
+}
+
+//
+// Converts a given double value to an 8-bit format.
+//
+// [in] format   - SBFP8_E4M3 or SBFP8_E5M2
+// [in] dblValue - the double value to be converted
+//
+// Returns the converted value.
+//
+static inline sbfp8_t encode_double(int format, double dblValue)
+{
+	sbfp8_t sbfp8Value = 0;
+
+	if (format == SBFP8_E5M2)
+	{
+		sbfp8Value = (sbfp8_t)sbfp_format_encode_double(SBFP_FORMAT_E5M2, dblValue);
+	}
+	else
+	{
+		sbfp8Value = encode_e4m3(dblValue);
+	}
+
+	return sbfp8Value;
+}
+
+//
+// Converts a given value of an 8-bit format to a double value, which holds it exactly.
+//
+// [in] format     - SBFP8_E4M3 or SBFP8_E5M2
+// [in] sbfp8Value - the value to be converted
+//
+// Returns the converted value.
+//
+static inline double decode_double(int format, sbfp8_t sbfp8Value)
+{
+	double dblValue = 0.0;
+
+	if (format == SBFP8_E5M2)
+	{
+		dblValue = sbfp_format_decode_double(SBFP_FORMAT_E5M2, sbfp8Value);
+	}
+	else
+	{
+		dblValue = decode_e4m3(sbfp8Value);
+	}
+
+	return dblValue;
+}
+
+//
+// Fills the sum and product tables (see sbfp8AddTables). Sums and products of two 8-bit
+// values are exact in double, so each entry is the exact result truncated like
+// double_to_sbfp8 would truncate it. Runs once when the library is loaded, before any
+// thread can use 8-bit arithmetic.
+//
+#if defined(__GNUC__)
+__attribute__((constructor))
+#elif !defined(_MSC_VER)
+#error "sbfp_fp8.c requires __attribute__((constructor)) or MSVC initializer support"
+#endif
+static void fill_tables(void)
+{
+	for (int format = 0; format < SBFP8_FORMAT_COUNT; ++format)
+	{
+		for (uint32_t bits1 = 0; bits1 <= UINT8_MAX; ++bits1)
+		{
+			double dblValue1 = decode_double(format, (sbfp8_t)bits1);
+
+			for (uint32_t bits2 = 0; bits2 <= UINT8_MAX; ++bits2)
+			{
+				double dblValue2 = decode_double(format, (sbfp8_t)bits2);
+
+				sbfp8AddTables[format][(bits1 << 8) | bits2] = encode_double(format, dblValue1 + dblValue2);
+				sbfp8MulTables[format][(bits1 << 8) | bits2] = encode_double(format, dblValue1 * dblValue2);
+			}
+		}
+	}
+}
+
+#if defined(_MSC_VER) && !defined(__GNUC__)
+//
+// Runs fill_tables among the C runtime's initializers, like a constructor of GCC's:
+//
+#pragma section(".CRT$XCU", read)
+__declspec(allocate(".CRT$XCU")) void (*sbfp8_fill_tables_at_load)(void) = fill_tables;
+#endif
+
+//
+// Gives the sum table of a format.
+//
+// [in] format - SBFP8_E4M3 or SBFP8_E5M2
+//
+// Returns the table.
+//
+static inline const uint8_t *add_table(int format)
+{
+	return sbfp8AddTables[format_index(format)];
+}
+
+//
+// Gives the product table of a format (see add_table).
+//
+// [in] format - SBFP8_E4M3 or SBFP8_E5M2
+//
+// Returns the table.
+//
+static inline const uint8_t *mul_table(int format)
+{
+	return sbfp8MulTables[format_index(format)];
+}
+
+//
+// Converts a given double value to an 8-bit format, truncating its magnitude toward zero.
+//
+// [in] format   - SBFP8_E4M3 or SBFP8_E5M2
+// [in] dblValue - the double value to be converted
+//
+// Returns the converted value.
+//
+sbfp8_t double_to_sbfp8(int format, double dblValue)
+{
+	return encode_double(format, dblValue);
+}
+
+//
+// Converts a given value of an 8-bit format to a double value.
+//
+// [in] format     - SBFP8_E4M3 or SBFP8_E5M2
+// [in] sbfp8Value - the value to be converted
+//
+// Returns the converted value.
+//
+double sbfp8_to_double(int format, sbfp8_t sbfp8Value)
+{
+	return decode_double(format, sbfp8Value);
+}
+
+//
+// Converts a given float value to an 8-bit format. The result is the same as that of
+// double_to_sbfp8 on the widened value.
+//
+// [in] format   - SBFP8_E4M3 or SBFP8_E5M2
+// [in] fltValue - the float value to be converted
+//
+// Returns the converted value.
+//
+sbfp8_t float_to_sbfp8(int format, float fltValue)
+{
+	return encode_double(format, fltValue);
+}
+
+//
+// Converts a given value of an 8-bit format to a float value, which holds it exactly.
+//
+// [in] format     - SBFP8_E4M3 or SBFP8_E5M2
+// [in] sbfp8Value - the value to be converted
+//
+// Returns the converted value.
+//
+float sbfp8_to_float(int format, sbfp8_t sbfp8Value)
+{
+	return (float)decode_double(format, sbfp8Value);
+}
+
+//
+// Converts a given sbfp value to an 8-bit format, truncating it like double_to_sbfp8.
+//
+// [in] format    - SBFP8_E4M3 or SBFP8_E5M2
+// [in] sbfpValue - the sbfp value to be converted
+//
+// Returns the converted value.
+//
+sbfp8_t sbfp_to_sbfp8(int format, sbfp_t sbfpValue)
+{
+	return encode_double(format, sbfp_to_double(sbfpValue));
+}
+
+//
+// Converts a given value of an 8-bit format to the sbfp_t type like double_to_sbfp. Every
+// E5M2 value is an sbfp value, as is every finite E4M3 value, except 2^-14 in the original
+// encoding, which becomes the largest subnormal.
+//
+// [in] format     - SBFP8_E4M3 or SBFP8_E5M2
+// [in] sbfp8Value - the value to be converted
+//
+// Returns the converted value.
+//
+sbfp_t sbfp8_to_sbfp(int format, sbfp8_t sbfp8Value)
+{
+	return double_to_sbfp(decode_double(format, sbfp8Value));
+}
+
+//
+// Adds two values of an 8-bit format with one table lookup. The result is the exact sum
+// truncated like double_to_sbfp8 would truncate it.
+//
+// [in] format      - SBFP8_E4M3 or SBFP8_E5M2
+// [in] sbfp8Value1 - the augend
+// [in] sbfp8Value2 - the addend
+//
+// Returns the sum.
+//
+sbfp8_t sbfp8_add(int format, sbfp8_t sbfp8Value1, sbfp8_t sbfp8Value2)
+{
+	return add_table(format)[(sbfp8Value1 << 8) | sbfp8Value2];
+}
+
+//
+// Subtracts one value of an 8-bit format from another, as the sum with the subtrahend's
+// sign flipped (see sbfp8_add).
+//
+// [in] format      - SBFP8_E4M3 or SBFP8_E5M2
+// [in] sbfp8Value1 - the minuend
+// [in] sbfp8Value2 - the subtrahend
+//
+// Returns the difference.
+//
+sbfp8_t sbfp8_sub(int format, sbfp8_t sbfp8Value1, sbfp8_t sbfp8Value2)
+{
+	return add_table(format)[(sbfp8Value1 << 8) | (sbfp8Value2 ^ SBFP8_SIGN_MASK)];
+}
+
+//
+// Multiplies two values of an 8-bit format with one table lookup. The result is the exact
+// product truncated like double_to_sbfp8 would truncate it.
+//
+// [in] format      - SBFP8_E4M3 or SBFP8_E5M2
+// [in] sbfp8Value1 - the multiplicand
+// [in] sbfp8Value2 - the multiplier
+//
+// Returns the product.
+//
+sbfp8_t sbfp8_mul(int format, sbfp8_t sbfp8Value1, sbfp8_t sbfp8Value2)
+{
+	return mul_table(format)[(sbfp8Value1 << 8) | sbfp8Value2];
+}
+
+//
+// Converts an array of double values to an 8-bit format (see double_to_sbfp8).
+//
+// [in]  format      - SBFP8_E4M3 or SBFP8_E5M2
+// [in]  dblValues   - the double values to be converted
+// [in]  dblStride   - the distance, in elements, between consecutive double values (1 if contiguous)
+// [out] sbfp8Values - the converted values
+// [in]  sbfp8Stride - the distance, in elements, between consecutive sbfp8 values (1 if contiguous)
+// [in]  count       - the number of values to be converted
+//
+void double_to_sbfp8_n(int format, const double *dblValues, ptrdiff_t dblStride, sbfp8_t *sbfp8Values, ptrdiff_t sbfp8Stride, size_t count)
+{
+	for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+	{
+		sbfp8Values[index * sbfp8Stride] = encode_double(format, dblValues[index * dblStride]);
+	}
+}
+
+//
+// Converts an array of values of an 8-bit format to double values (see sbfp8_to_double).
+//
+// [in]  format      - SBFP8_E4M3 or SBFP8_E5M2
+// [in]  sbfp8Values - the values to be converted
+// [in]  sbfp8Stride - the distance, in elements, between consecutive sbfp8 values (1 if contiguous)
+// [out] dblValues   - the converted values
+// [in]  dblStride   - the distance, in elements, between consecutive double values (1 if contiguous)
+// [in]  count       - the number of values to be converted
+//
+void sbfp8_to_double_n(int format, const sbfp8_t *sbfp8Values, ptrdiff_t sbfp8Stride, double *dblValues, ptrdiff_t dblStride, size_t count)
+{
+	for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+	{
+		dblValues[index * dblStride] = decode_double(format, sbfp8Values[index * sbfp8Stride]);
+	}
+}
+
+//
+// Converts an array of float values to an 8-bit format (see float_to_sbfp8).
+//
+// [in]  format      - SBFP8_E4M3 or SBFP8_E5M2
+// [in]  fltValues   - the float values to be converted
+// [in]  fltStride   - the distance, in elements, between consecutive float values (1 if contiguous)
+// [out] sbfp8Values - the converted values
+// [in]  sbfp8Stride - the distance, in elements, between consecutive sbfp8 values (1 if contiguous)
+// [in]  count       - the number of values to be converted
+//
+void float_to_sbfp8_n(int format, const float *fltValues, ptrdiff_t fltStride, sbfp8_t *sbfp8Values, ptrdiff_t sbfp8Stride, size_t count)
+{
+	if (fltStride == 1 && sbfp8Stride == 1)
+	{
+		size_t index = 0;
+
+#ifdef SBFP_X86
+		size_t (*kernel)(const float *, sbfp8_t *, size_t) =
+			(format == SBFP8_E5M2) ? sbfpX86Kernels.float_to_e5m2 : sbfpX86Kernels.float_to_e4m3;
+
+		if (kernel != NULL)
+		{
+			index = kernel(fltValues, sbfp8Values, count);
+		}
+#endif
+
+		for (; index < count; ++index)
+		{
+			sbfp8Values[index] = encode_double(format, fltValues[index]);
+		}
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+		{
+			sbfp8Values[index * sbfp8Stride] = encode_double(format, fltValues[index * fltStride]);
+		}
+	}
+}
+
+//
+// Converts an array of values of an 8-bit format to float values (see sbfp8_to_float).
+//
+// [in]  format      - SBFP8_E4M3 or SBFP8_E5M2
+// [in]  sbfp8Values - the values to be converted
+// [in]  sbfp8Stride - the distance, in elements, between consecutive sbfp8 values (1 if contiguous)
+// [out] fltValues   - the converted values
+// [in]  fltStride   - the distance, in elements, between consecutive float values (1 if contiguous)
+// [in]  count       - the number of values to be converted
+//
+void sbfp8_to_float_n(int format, const sbfp8_t *sbfp8Values, ptrdiff_t sbfp8Stride, float *fltValues, ptrdiff_t fltStride, size_t count)
+{
+	if (sbfp8Stride == 1 && fltStride == 1)
+	{
+		size_t index = 0;
+
+#ifdef SBFP_X86
+		size_t (*kernel)(const sbfp8_t *, float *, size_t) =
+			(format == SBFP8_E5M2) ? sbfpX86Kernels.e5m2_to_float : sbfpX86Kernels.e4m3_to_float;
+
+		if (kernel != NULL)
+		{
+			index = kernel(sbfp8Values, fltValues, count);
+		}
+#endif
+
+		for (; index < count; ++index)
+		{
+			fltValues[index] = (float)decode_double(format, sbfp8Values[index]);
+		}
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+		{
+			fltValues[index * fltStride] = (float)decode_double(format, sbfp8Values[index * sbfp8Stride]);
+		}
+	}
+}
+
+//
+// Converts an array of sbfp_t values to an 8-bit format (see sbfp_to_sbfp8). The values
+// pass through float, which holds them exactly, so that both steps use the bulk kernels.
+//
+// [in]  format      - SBFP8_E4M3 or SBFP8_E5M2
+// [in]  sbfpValues  - the sbfp values to be converted
+// [in]  sbfpStride  - the distance, in elements, between consecutive sbfp values (1 if contiguous)
+// [out] sbfp8Values - the converted values
+// [in]  sbfp8Stride - the distance, in elements, between consecutive sbfp8 values (1 if contiguous)
+// [in]  count       - the number of values to be converted
+//
+void sbfp_to_sbfp8_n(int format, const sbfp_t *sbfpValues, ptrdiff_t sbfpStride, sbfp8_t *sbfp8Values, ptrdiff_t sbfp8Stride, size_t count)
+{
+	float fltValues[SBFP8_CHUNK_COUNT];
+
+	for (size_t index = 0; index < count; index += SBFP8_CHUNK_COUNT)
+	{
+		size_t chunkCount = (count - index < SBFP8_CHUNK_COUNT) ? count - index : SBFP8_CHUNK_COUNT;
+
+		sbfp_to_float_n(sbfpValues + (ptrdiff_t)index * sbfpStride, sbfpStride, fltValues, 1, chunkCount);
+		float_to_sbfp8_n(format, fltValues, 1, sbfp8Values + (ptrdiff_t)index * sbfp8Stride, sbfp8Stride, chunkCount);
+	}
+}
+
+//
+// Converts an array of values of an 8-bit format to the sbfp_t type (see sbfp8_to_sbfp),
+// through float like sbfp_to_sbfp8_n.
+//
+// [in]  format      - SBFP8_E4M3 or SBFP8_E5M2
+// [in]  sbfp8Values - the values to be converted
+// [in]  sbfp8Stride - the distance, in elements, between consecutive sbfp8 values (1 if contiguous)
+// [out] sbfpValues  - the converted values
+// [in]  sbfpStride  - the distance, in elements, between consecutive sbfp values (1 if contiguous)
+// [in]  count       - the number of values to be converted
+//
+void sbfp8_to_sbfp_n(int format, const sbfp8_t *sbfp8Values, ptrdiff_t sbfp8Stride, sbfp_t *sbfpValues, ptrdiff_t sbfpStride, size_t count)
+{
+	float fltValues[SBFP8_CHUNK_COUNT];
+
+	for (size_t index = 0; index < count; index += SBFP8_CHUNK_COUNT)
+	{
+		size_t chunkCount = (count - index < SBFP8_CHUNK_COUNT) ? count - index : SBFP8_CHUNK_COUNT;
+
+		sbfp8_to_float_n(format, sbfp8Values + (ptrdiff_t)index * sbfp8Stride, sbfp8Stride, fltValues, 1, chunkCount);
+		float_to_sbfp_n(fltValues, 1, sbfpValues + (ptrdiff_t)index * sbfpStride, sbfpStride, chunkCount);
+	}
+}
+
+//
+// Converts an array of sbfp16_t values to an 8-bit format (see sbfp_to_sbfp8_n).
+//
+// [in]  format      - SBFP8_E4M3 or SBFP8_E5M2
+// [in]  sbfpValues  - the sbfp values to be converted
+// [in]  sbfpStride  - the distance, in elements, between consecutive sbfp values (1 if contiguous)
+// [out] sbfp8Values - the converted values
+// [in]  sbfp8Stride - the distance, in elements, between consecutive sbfp8 values (1 if contiguous)
+// [in]  count       - the number of values to be converted
+//
+void sbfp16_to_sbfp8_n(int format, const sbfp16_t *sbfpValues, ptrdiff_t sbfpStride, sbfp8_t *sbfp8Values, ptrdiff_t sbfp8Stride, size_t count)
+{
+	float fltValues[SBFP8_CHUNK_COUNT];
+
+	for (size_t index = 0; index < count; index += SBFP8_CHUNK_COUNT)
+	{
+		size_t chunkCount = (count - index < SBFP8_CHUNK_COUNT) ? count - index : SBFP8_CHUNK_COUNT;
+
+		sbfp16_to_float_n(sbfpValues + (ptrdiff_t)index * sbfpStride, sbfpStride, fltValues, 1, chunkCount);
+		float_to_sbfp8_n(format, fltValues, 1, sbfp8Values + (ptrdiff_t)index * sbfp8Stride, sbfp8Stride, chunkCount);
+	}
+}
+
+//
+// Converts an array of values of an 8-bit format to the sbfp16_t type (see
+// sbfp8_to_sbfp_n).
+//
+// [in]  format      - SBFP8_E4M3 or SBFP8_E5M2
+// [in]  sbfp8Values - the values to be converted
+// [in]  sbfp8Stride - the distance, in elements, between consecutive sbfp8 values (1 if contiguous)
+// [out] sbfpValues  - the converted values
+// [in]  sbfpStride  - the distance, in elements, between consecutive sbfp values (1 if contiguous)
+// [in]  count       - the number of values to be converted
+//
+void sbfp8_to_sbfp16_n(int format, const sbfp8_t *sbfp8Values, ptrdiff_t sbfp8Stride, sbfp16_t *sbfpValues, ptrdiff_t sbfpStride, size_t count)
+{
+	float fltValues[SBFP8_CHUNK_COUNT];
+
+	for (size_t index = 0; index < count; index += SBFP8_CHUNK_COUNT)
+	{
+		size_t chunkCount = (count - index < SBFP8_CHUNK_COUNT) ? count - index : SBFP8_CHUNK_COUNT;
+
+		sbfp8_to_float_n(format, sbfp8Values + (ptrdiff_t)index * sbfp8Stride, sbfp8Stride, fltValues, 1, chunkCount);
+		float_to_sbfp16_n(fltValues, 1, sbfpValues + (ptrdiff_t)index * sbfpStride, sbfpStride, chunkCount);
+	}
+}
+
+//
+// Looks up the results of an operation on arrays of 8-bit values elementwise in one of the
+// tables. A stride of 0 repeats the same value for every element.
+//
+// [in]  table        - the table of results
+// [in]  flip2        - a mask applied to each second operand (the sign bit to subtract)
+// [in]  sbfp8Values1 - the first operands
+// [in]  sbfp8Stride1 - the distance, in elements, between consecutive first operands (1 if contiguous)
+// [in]  sbfp8Values2 - the second operands
+// [in]  sbfp8Stride2 - the distance, in elements, between consecutive second operands (1 if contiguous)
+// [out] sbfp8Results - the results (may be the same array as either operand)
+// [in]  resultStride - the distance, in elements, between consecutive results (1 if contiguous)
+// [in]  count        - the number of elements
+//
+static void look_up_n(const uint8_t *table, uint32_t flip2, const sbfp8_t *sbfp8Values1, ptrdiff_t sbfp8Stride1,
+	const sbfp8_t *sbfp8Values2, ptrdiff_t sbfp8Stride2, sbfp8_t *sbfp8Results, ptrdiff_t resultStride, size_t count)
+{
+	if (sbfp8Stride1 == 1 && sbfp8Stride2 == 1 && resultStride == 1)
+	{
+		for (size_t index = 0; index < count; ++index)
+		{
+			sbfp8Results[index] = table[((uint32_t)sbfp8Values1[index] << 8) | (sbfp8Values2[index] ^ flip2)];
+		}
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+		{
+			sbfp8Results[index * resultStride] =
+				table[((uint32_t)sbfp8Values1[index * sbfp8Stride1] << 8) | (sbfp8Values2[index * sbfp8Stride2] ^ flip2)];
+		}
+	}
+}
+
+//
+// Adds arrays of values of an 8-bit format elementwise (see sbfp8_add). A stride of 0
+// repeats the same value for every element.
+//
+// [in]  format       - SBFP8_E4M3 or SBFP8_E5M2
+// [in]  sbfp8Values1 - the augends
+// [in]  sbfp8Stride1 - the distance, in elements, between consecutive augends (1 if contiguous)
+// [in]  sbfp8Values2 - the addends
+// [in]  sbfp8Stride2 - the distance, in elements, between consecutive addends (1 if contiguous)
+// [out] sbfp8Results - the sums (may be the same array as either operand)
+// [in]  resultStride - the distance, in elements, between consecutive sums (1 if contiguous)
+// [in]  count        - the number of elements
+//
+void sbfp8_add_n(int format, const sbfp8_t *sbfp8Values1, ptrdiff_t sbfp8Stride1, const sbfp8_t *sbfp8Values2, ptrdiff_t sbfp8Stride2,
+	sbfp8_t *sbfp8Results, ptrdiff_t resultStride, size_t count)
+{
+	look_up_n(add_table(format), 0, sbfp8Values1, sbfp8Stride1, sbfp8Values2, sbfp8Stride2, sbfp8Results, resultStride, count);
+}
+
+//
+// Subtracts arrays of values of an 8-bit format elementwise (see sbfp8_sub and
+// sbfp8_add_n).
+//
+// [in]  format       - SBFP8_E4M3 or SBFP8_E5M2
+// [in]  sbfp8Values1 - the minuends
+// [in]  sbfp8Stride1 - the distance, in elements, between consecutive minuends (1 if contiguous)
+// [in]  sbfp8Values2 - the subtrahends
+// [in]  sbfp8Stride2 - the distance, in elements, between consecutive subtrahends (1 if contiguous)
+// [out] sbfp8Results - the differences (may be the same array as either operand)
+// [in]  resultStride - the distance, in elements, between consecutive differences (1 if contiguous)
+// [in]  count        - the number of elements
+//
+void sbfp8_sub_n(int format, const sbfp8_t *sbfp8Values1, ptrdiff_t sbfp8Stride1, const sbfp8_t *sbfp8Values2, ptrdiff_t sbfp8Stride2,
+	sbfp8_t *sbfp8Results, ptrdiff_t resultStride, size_t count)
+{
+	look_up_n(add_table(format), SBFP8_SIGN_MASK, sbfp8Values1, sbfp8Stride1, sbfp8Values2, sbfp8Stride2, sbfp8Results, resultStride, count);
+}
+
+//
+// Multiplies arrays of values of an 8-bit format elementwise (see sbfp8_mul and
+// sbfp8_add_n).
+//
+// [in]  format       - SBFP8_E4M3 or SBFP8_E5M2
+// [in]  sbfp8Values1 - the multiplicands
+// [in]  sbfp8Stride1 - the distance, in elements, between consecutive multiplicands (1 if contiguous)
+// [in]  sbfp8Values2 - the multipliers
+// [in]  sbfp8Stride2 - the distance, in elements, between consecutive multipliers (1 if contiguous)
+// [out] sbfp8Results - the products (may be the same array as either operand)
+// [in]  resultStride - the distance, in elements, between consecutive products (1 if contiguous)
+// [in]  count        - the number of elements
+//
+void sbfp8_mul_n(int format, const sbfp8_t *sbfp8Values1, ptrdiff_t sbfp8Stride1, const sbfp8_t *sbfp8Values2, ptrdiff_t sbfp8Stride2,
+	sbfp8_t *sbfp8Results, ptrdiff_t resultStride, size_t count)
+{
+	look_up_n(mul_table(format), 0, sbfp8Values1, sbfp8Stride1, sbfp8Values2, sbfp8Stride2, sbfp8Results, resultStride, count);
+}
@@ -38,724 +38,2426 @@
 // OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
 // DEALINGS IN THE SOFTWARE.
 //
+#undef SBFP_INLINE // the library defines the external functions
+
 #include "sbfp_const.h"
+#include "sbfp_core.h"
 #include "sbfp_lib.h"
+#include "sbfp_x86.h"
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
 
 //
-// Extracts the fraction of a given double value and stores it as an integer.
+// Converts a given double value to the sbfp_t type.
 //
-// [in] value - the double value whose fraction to extract
+// The magnitude is rounded to nearest, ties to an even frac. The original encoding has no
+// pattern for 2^-14, so magnitudes that round to it become its nearest neighbour, the
+// largest subnormal for 2^-14 itself (see sbfp_core_round_min_normal). Magnitudes that
+// round to 2^16 or above become infinity, and NaN becomes SBFP_NAN. Truncation is
+// double_to_sbfp_round with SBFP_ROUND_TRUNCATE.
 //
-// Returns the extracted fraction as an integer.
+// [in] dblValue - the double value to be converted
+// 
+// Returns the converted value.
 //
-static int extract_frac(double value)
+sbfp_t double_to_sbfp(double dblValue)
 {
-	double fracDbl = value - (long)value;
-	int    fracInt = 0;
+	return sbfp_core_encode_double(dblValue);
+}
 
-	for (int count = 0; count < SBFP_BIT_COUNT_FRAC; ++count)
-	{
-		fracInt <<= 1;
+#ifdef SBFP_DECODE_TABLE
 
-		double temp = fracDbl * 2;
+#ifndef __GNUC__
+#error "SBFP_DECODE_TABLE requires __attribute__((constructor)) support"
+#endif
 
-		if (temp >= 1.0)
-		{
-			fracInt += 1;
+//
+// Decoded values of every sbfp bit pattern, indexed by the low 16 bits of an sbfp_t:
+//
+static double sbfpDoubleTable[SBFP_BIT_MASK + 1];
+static float  sbfpFloatTable[SBFP_BIT_MASK + 1];
 
-			fracDbl = temp - (long)temp;
-		}
-		else
-		{
-			fracDbl = temp;
-		}
+//
+// Fills the decode tables. Runs once when the library is loaded.
+//
+__attribute__((constructor))
+static void init_decode_tables(void)
+{
+	for (int index = 0; index <= SBFP_BIT_MASK; ++index)
+	{
+		sbfpDoubleTable[index] = sbfp_core_decode_double(index);
+		sbfpFloatTable[index]  = (float)sbfpDoubleTable[index];
 	}
+}
+
+#endif
 
-	return fracInt;
+//
+// Returns the table of decoded double values of every sbfp bit pattern, indexed by the low
+// 16 bits of an sbfp_t, or NULL if the library was built without SBFP_DECODE_TABLE.
+//
+const double *sbfp_double_table(void)
+{
+#ifdef SBFP_DECODE_TABLE
+	return sbfpDoubleTable;
+#else
+	return NULL;
+#endif
 }
 
 //
-// Converts a given double value to the sbfp_t type.
+// Returns the table of decoded float values of every sbfp bit pattern, indexed by the low
+// 16 bits of an sbfp_t, or NULL if the library was built without SBFP_DECODE_TABLE.
 //
-// [in] value - the double value to be converted
-// 
-// Returns the converted value.
+const float *sbfp_float_table(void)
+{
+#ifdef SBFP_DECODE_TABLE
+	return sbfpFloatTable;
+#else
+	return NULL;
+#endif
+}
+
 //
-sbfp_t double_to_sbfp(double dblValue)
+// Returns the name of the most capable SIMD backend used by the bulk functions: "scalar",
+// "sse2", "avx2", "f16c" or "avx512". The backend is chosen once, when the library is
+// loaded, and can be capped with the SBFP_BACKEND environment variable.
+//
+const char *sbfp_backend(void)
 {
-	int status = 0;
+#ifdef SBFP_X86
+	return sbfp_x86_backend_name();
+#else
+	return "scalar";
+#endif
+}
 
-	sbfp_t sbfpValue = 0;
-	int    sbfpSign  = 0;
-	int    sbfpExpo  = 0;
-	int    sbfpFrac  =  0;
+//
+// Decodes a given sbfp_t value to a double value, through the decode table if the library
+// was built with one.
+//
+// [in] sbfpValue - the sbfp_t value to be decoded
+//
+// Returns the decoded value.
+//
+static inline double lookup_double(sbfp_t sbfpValue)
+{
+#ifdef SBFP_DECODE_TABLE
+	return sbfpDoubleTable[sbfpValue & SBFP_BIT_MASK];
+#else
+	return sbfp_core_decode_double(sbfpValue);
+#endif
+}
 
-	//
-	// Extract sign (treating 0 as positive):
-	//
-	if (status == 0)
+//
+// Converts a given sbfp_t value to a double value.
+//
+// [in] sbfpValue - the sbfp_t value to be converted
+//
+// Returns the converted value.
+//
+double sbfp_to_double(sbfp_t sbfpValue)
+{
+	return lookup_double(sbfpValue);
+}
+
+//
+// Converts an array of double values to the sbfp_t type (see double_to_sbfp).
+//
+// [in]  dblValues  - the double values to be converted
+// [in]  dblStride  - the distance, in elements, between consecutive double values (1 if contiguous)
+// [out] sbfpValues - the converted values
+// [in]  sbfpStride - the distance, in elements, between consecutive sbfp values (1 if contiguous)
+// [in]  count      - the number of values to be converted
+//
+void double_to_sbfp_n(const double *dblValues, ptrdiff_t dblStride, sbfp_t *sbfpValues, ptrdiff_t sbfpStride, size_t count)
+{
+	if (dblStride == 1 && sbfpStride == 1)
 	{
-		if (dblValue < 0.0)
+		size_t index = 0;
+
+#ifdef SBFP_X86
+		if (sbfpX86Kernels.double_to_sbfp != NULL)
 		{
-			sbfpSign = 1; // negative
-			dblValue *= -1.0;
+			index = sbfpX86Kernels.double_to_sbfp(dblValues, sbfpValues, count);
 		}
-		else
+#endif
+
+		for (; index < count; ++index)
 		{
-			sbfpSign = 0; // positive
+			sbfpValues[index] = sbfp_core_encode_double(dblValues[index]);
 		}
 	}
-
-	//
-	// Determine infinity:
-	//
-	unsigned long long dblValueWhole = (unsigned long long)dblValue;
-
-	if (status == 0)
+	else
 	{
-		if (dblValueWhole >= (1 << (SBFP_BIAS + 1)))
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
 		{
-			if (sbfpSign == 1)
-			{
-				sbfpValue = SBFP_NEG_INF;
-			}
-			else
-			{
-				sbfpValue = SBFP_POS_INF;
-			}
-
-			status = 1;
+			sbfpValues[index * sbfpStride] = sbfp_core_encode_double(dblValues[index * dblStride]);
 		}
 	}
+}
 
-	//
-	// Determine if value needs to be denormalized:
-	//
-	bool denormalize  = false;
-
-	if (status == 0)
+//
+// Converts an array of sbfp_t values to double values (see sbfp_to_double).
+//
+// [in]  sbfpValues - the sbfp values to be converted
+// [in]  sbfpStride - the distance, in elements, between consecutive sbfp values (1 if contiguous)
+// [out] dblValues  - the converted values
+// [in]  dblStride  - the distance, in elements, between consecutive double values (1 if contiguous)
+// [in]  count      - the number of values to be converted
+//
+void sbfp_to_double_n(const sbfp_t *sbfpValues, ptrdiff_t sbfpStride, double *dblValues, ptrdiff_t dblStride, size_t count)
+{
+	if (sbfpStride == 1 && dblStride == 1)
 	{
-		if (dblValueWhole == 0 &&
-			(dblValue - (long)dblValue) < (((double)((1 << 10) + 1) / (1 << 10)) / (1 << (SBFP_BIAS - 1))))
+		size_t index = 0;
+
+#ifdef SBFP_X86
+		if (sbfpX86Kernels.sbfp_to_double != NULL)
 		{
-			denormalize = true;
+			index = sbfpX86Kernels.sbfp_to_double(sbfpValues, dblValues, count);
 		}
-	}
+#endif
 
-	//
-	// Extract expo and frac:
-	//
-	if (status == 0)
-	{
-		if (denormalize)
+		for (; index < count; ++index)
 		{
-			sbfpExpo = 0;
-			sbfpFrac = extract_frac(dblValue * (1 << (SBFP_BIAS - 1)));
+			dblValues[index] = lookup_double(sbfpValues[index]);
 		}
-		else
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
 		{
-			int E = 0;
-
-			while (!(dblValue < 2 && dblValue >= 1))
-			{
-				dblValue /= 2;
-				++E;
-			}
-
-			sbfpExpo = E + SBFP_BIAS;
-
-			sbfpFrac = extract_frac(dblValue);
+			dblValues[index * dblStride] = lookup_double(sbfpValues[index * sbfpStride]);
 		}
 	}
+}
 
-	//
-	// Concatenate sign, expo and frac to the sbfp value, and return:
-	//
-	if (status == 0)
-	{
-		sbfpValue += sbfpSign;
-
-		sbfpValue <<= SBFP_BIT_COUNT_EXPO;
-		sbfpValue += sbfpExpo;
-
-		sbfpValue <<= SBFP_BIT_COUNT_FRAC;
-		sbfpValue += sbfpFrac;
-	}
+//
+// Converts a given float value to the sbfp_t type. The result is the same as that of
+// double_to_sbfp on the widened value.
+//
+// [in] fltValue - the float value to be converted
+//
+// Returns the converted value.
+//
+sbfp_t float_to_sbfp(float fltValue)
+{
+	return sbfp_core_encode_float(fltValue);
+}
 
-	return sbfpValue;
+//
+// Decodes a given sbfp_t value to a float value, through the decode table if the library
+// was built with one.
+//
+// [in] sbfpValue - the sbfp_t value to be decoded
+//
+// Returns the decoded value.
+//
+static inline float lookup_float(sbfp_t sbfpValue)
+{
+#ifdef SBFP_DECODE_TABLE
+	return sbfpFloatTable[sbfpValue & SBFP_BIT_MASK];
+#else
+	return sbfp_core_decode_float(sbfpValue);
+#endif
 }
 
 //
-// Converts a given sbfp_t value to a double value.
+// Converts a given sbfp_t value to a float value. The result is the same as that of
+// sbfp_to_double narrowed to float.
 //
 // [in] sbfpValue - the sbfp_t value to be converted
 //
 // Returns the converted value.
 //
-double sbfp_to_double(sbfp_t sbfpValue)
+float sbfp_to_float(sbfp_t sbfpValue)
 {
-	int    status   = 0;
-	double dblValue = 0.0;
-
-	//
-	// Extract frac, expo and sign:
-	//
-	int sbfpFrac = 0;
-	int sbfpExpo = 0;
-	int sbfpSign = 0;
+	return lookup_float(sbfpValue);
+}
 
-	if (status == 0)
+//
+// Converts an array of float values to the sbfp_t type (see float_to_sbfp).
+//
+// [in]  fltValues  - the float values to be converted
+// [in]  fltStride  - the distance, in elements, between consecutive float values (1 if contiguous)
+// [out] sbfpValues - the converted values
+// [in]  sbfpStride - the distance, in elements, between consecutive sbfp values (1 if contiguous)
+// [in]  count      - the number of values to be converted
+//
+void float_to_sbfp_n(const float *fltValues, ptrdiff_t fltStride, sbfp_t *sbfpValues, ptrdiff_t sbfpStride, size_t count)
+{
+	if (fltStride == 1 && sbfpStride == 1)
 	{
-		sbfpFrac = sbfpValue & ((1 << SBFP_BIT_COUNT_FRAC) - 1);
-		sbfpValue >>= SBFP_BIT_COUNT_FRAC;
+		size_t index = 0;
 
-		sbfpExpo = sbfpValue & ((1 << SBFP_BIT_COUNT_EXPO) - 1);
-		sbfpValue >>= SBFP_BIT_COUNT_EXPO;
+#ifdef SBFP_X86
+		if (sbfpX86Kernels.float_to_sbfp != NULL)
+		{
+			index = sbfpX86Kernels.float_to_sbfp(fltValues, sbfpValues, count);
+		}
+#endif
 
-		sbfpSign = sbfpValue & ((1 << SBFP_BIT_COUNT_SIGN) - 1);
+		for (; index < count; ++index)
+		{
+			sbfpValues[index] = sbfp_core_encode_float(fltValues[index]);
+		}
 	}
-
-	//
-	// Determine if sbfp value is infinity or NaN:
-	//
-	if (status == 0)
+	else
 	{
-		if (sbfpExpo == ((1 << SBFP_BIT_COUNT_EXPO) - 1))
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
 		{
-			if (sbfpFrac == 0)
-			{
-				if (sbfpSign == 0)
-				{
-					dblValue = DOUBLE_POS_INF;
-				}
-				else
-				{
-					dblValue = DOUBLE_NEG_INF;
-				}
-			}
-			else
-			{
-				dblValue = DOUBLE_NAN;
-			}
-
-			status = 1;
+			sbfpValues[index * sbfpStride] = sbfp_core_encode_float(fltValues[index * fltStride]);
 		}
 	}
+}
 
-	//
-	// Calculate double value and return:
-	//
-	if (status == 0)
+//
+// Converts an array of sbfp_t values to float values (see sbfp_to_float).
+//
+// [in]  sbfpValues - the sbfp values to be converted
+// [in]  sbfpStride - the distance, in elements, between consecutive sbfp values (1 if contiguous)
+// [out] fltValues  - the converted values
+// [in]  fltStride  - the distance, in elements, between consecutive float values (1 if contiguous)
+// [in]  count      - the number of values to be converted
+//
+void sbfp_to_float_n(const sbfp_t *sbfpValues, ptrdiff_t sbfpStride, float *fltValues, ptrdiff_t fltStride, size_t count)
+{
+	if (sbfpStride == 1 && fltStride == 1)
 	{
-		int    E = 0;
-		double M = 0.0;
+		size_t index = 0;
 
-		if (sbfpExpo == 0)
-		{
-			E = 1 - SBFP_BIAS;
-			M = (double)sbfpFrac / (1 << SBFP_BIT_COUNT_FRAC);
-		}
-		else
+#ifdef SBFP_X86
+		if (sbfpX86Kernels.sbfp_to_float != NULL)
 		{
-			E = sbfpExpo - SBFP_BIAS;
-			M = 1 + ((double)sbfpFrac / (1 << SBFP_BIT_COUNT_FRAC));
+			index = sbfpX86Kernels.sbfp_to_float(sbfpValues, fltValues, count);
 		}
+#endif
 
-		if (E < 0)
-		{
-			dblValue = M / (1 << ((-1) * E));
-		}
-		else
+		for (; index < count; ++index)
 		{
-			dblValue = M * (1 << E);
+			fltValues[index] = lookup_float(sbfpValues[index]);
 		}
-
-		if (sbfpSign == 1)
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
 		{
-			dblValue *= -1;
+			fltValues[index * fltStride] = lookup_float(sbfpValues[index * sbfpStride]);
 		}
 	}
-
-	return dblValue;
 }
 
 //
-// Multiplies two special sbfp values.
+// Narrows an array of sbfp_t values to the sbfp16_t type, which keeps the same bits in
+// half the memory.
 //
-// [in] sbfpValue1 - the multiplicand
-// [in] sbfpValue2 - the multiplier
+// [in]  sbfpValues   - the sbfp values to be narrowed
+// [in]  sbfpStride   - the distance, in elements, between consecutive sbfp values (1 if contiguous)
+// [out] sbfp16Values - the narrowed values
+// [in]  sbfp16Stride - the distance, in elements, between consecutive sbfp16 values (1 if contiguous)
+// [in]  count        - the number of values to be narrowed
 //
-// Returns the product.
+void sbfp_to_sbfp16_n(const sbfp_t *sbfpValues, ptrdiff_t sbfpStride, sbfp16_t *sbfp16Values, ptrdiff_t sbfp16Stride, size_t count)
+{
+	for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+	{
+		sbfp16Values[index * sbfp16Stride] = (sbfp16_t)(sbfpValues[index * sbfpStride] & SBFP_BIT_MASK);
+	}
+}
+
+//
+// Widens an array of sbfp16_t values to the sbfp_t type.
 //
-sbfp_t handle_special_mul(sbfp_t sbfpValue1, sbfp_t sbfpValue2)
+// [in]  sbfp16Values - the sbfp16 values to be widened
+// [in]  sbfp16Stride - the distance, in elements, between consecutive sbfp16 values (1 if contiguous)
+// [out] sbfpValues   - the widened values
+// [in]  sbfpStride   - the distance, in elements, between consecutive sbfp values (1 if contiguous)
+// [in]  count        - the number of values to be widened
+//
+void sbfp16_to_sbfp_n(const sbfp16_t *sbfp16Values, ptrdiff_t sbfp16Stride, sbfp_t *sbfpValues, ptrdiff_t sbfpStride, size_t count)
 {
-	sbfp_t sbfpProduct = 0;
+	for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+	{
+		sbfpValues[index * sbfpStride] = sbfp16Values[index * sbfp16Stride];
+	}
+}
 
-	switch (sbfpValue1)
+//
+// Converts an array of double values to the sbfp16_t type (see double_to_sbfp).
+//
+// [in]  dblValues  - the double values to be converted
+// [in]  dblStride  - the distance, in elements, between consecutive double values (1 if contiguous)
+// [out] sbfpValues - the converted values
+// [in]  sbfpStride - the distance, in elements, between consecutive sbfp values (1 if contiguous)
+// [in]  count      - the number of values to be converted
+//
+void double_to_sbfp16_n(const double *dblValues, ptrdiff_t dblStride, sbfp16_t *sbfpValues, ptrdiff_t sbfpStride, size_t count)
+{
+	if (dblStride == 1 && sbfpStride == 1)
 	{
-		case SBFP_POS_INF:
-		{
-			if (sbfpValue2 == SBFP_POS_INF)
-			{
-				sbfpProduct = SBFP_POS_INF;
-			}
-			else if (sbfpValue2 == SBFP_NEG_INF)
-			{
-				sbfpProduct = SBFP_NEG_INF;
-			}
-			else if (sbfpValue2 == SBFP_NAN)
-			{
-				sbfpProduct = SBFP_NAN;
-			}
-			else
-			{
-				sbfpProduct = SBFP_POS_INF;
-			}
-		}
+		size_t index = 0;
 
-		case SBFP_NEG_INF:
+#ifdef SBFP_X86
+		if (sbfpX86Kernels.double_to_sbfp16 != NULL)
 		{
-			if (sbfpValue2 == SBFP_POS_INF)
-			{
-				sbfpProduct = SBFP_NEG_INF;
-			}
-			else if (sbfpValue2 == SBFP_NEG_INF)
-			{
-				sbfpProduct = SBFP_POS_INF;
-			}
-			else if (sbfpValue2 == SBFP_NAN)
-			{
-				sbfpProduct = SBFP_NAN;
-			}
-			else
-			{
-				sbfpProduct = SBFP_NEG_INF;
-			}
+			index = sbfpX86Kernels.double_to_sbfp16(dblValues, sbfpValues, count);
 		}
+#endif
 
-		case SBFP_NAN:
+		for (; index < count; ++index)
 		{
-			if (sbfpValue2 == SBFP_POS_INF)
-			{
-				sbfpProduct = SBFP_NAN;
-			}
-			else if (sbfpValue2 == SBFP_NEG_INF)
-			{
-				sbfpProduct = SBFP_NAN;
-			}
-			else if (sbfpValue2 == SBFP_NAN)
-			{
-				sbfpProduct = SBFP_NAN;
-			}
-			else
-			{
-				sbfpProduct = SBFP_NAN;
-			}
+			sbfpValues[index] = (sbfp16_t)sbfp_core_encode_double(dblValues[index]);
 		}
-
-		default:
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
 		{
-			if (sbfpValue2 == SBFP_POS_INF)
-			{
-				sbfpProduct = SBFP_POS_INF;
-			}
-			else if (sbfpValue2 == SBFP_NEG_INF)
-			{
-				sbfpProduct = SBFP_NEG_INF;
-			}
-			else if (sbfpValue2 == SBFP_NAN)
-			{
-				sbfpProduct = SBFP_NAN;
-			}
-			else
-			{
-				// error: you shouldn't be here
-			}
+			sbfpValues[index * sbfpStride] = (sbfp16_t)sbfp_core_encode_double(dblValues[index * dblStride]);
 		}
 	}
-
-	return sbfpProduct;
 }
 
 //
-// Multiplies two sbfp values.
-//
-// [in] sbfpValue1 - the multiplicand
-// [in] sbfpValue2 - the multiplier
+// Converts an array of sbfp16_t values to double values (see sbfp_to_double).
 //
-// Returns the product.
+// [in]  sbfpValues - the sbfp values to be converted
+// [in]  sbfpStride - the distance, in elements, between consecutive sbfp values (1 if contiguous)
+// [out] dblValues  - the converted values
+// [in]  dblStride  - the distance, in elements, between consecutive double values (1 if contiguous)
+// [in]  count      - the number of values to be converted
 //
-sbfp_t sbfp_mul(sbfp_t sbfpValue1, sbfp_t sbfpValue2)
+void sbfp16_to_double_n(const sbfp16_t *sbfpValues, ptrdiff_t sbfpStride, double *dblValues, ptrdiff_t dblStride, size_t count)
 {
-	int status = 0;
+	if (sbfpStride == 1 && dblStride == 1)
+	{
+		size_t index = 0;
 
-	sbfp_t sbfpProduct = 0;
+#ifdef SBFP_X86
+		if (sbfpX86Kernels.sbfp16_to_double != NULL)
+		{
+			index = sbfpX86Kernels.sbfp16_to_double(sbfpValues, dblValues, count);
+		}
+#endif
 
-	//
-	// Handle if the sbfp values are infinity or NaN:
-	//
-	if (status == 0)
+		for (; index < count; ++index)
+		{
+			dblValues[index] = lookup_double(sbfpValues[index]);
+		}
+	}
+	else
 	{
-		if (sbfpValue1 == SBFP_POS_INF || sbfpValue1 == SBFP_NEG_INF || sbfpValue1 == SBFP_NAN ||
-			sbfpValue2 == SBFP_POS_INF || sbfpValue2 == SBFP_NEG_INF || sbfpValue2 == SBFP_NAN)
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
 		{
-			sbfpProduct = handle_special_mul(sbfpValue1, sbfpValue2);
-
-			status = 1;
+			dblValues[index * dblStride] = lookup_double(sbfpValues[index * sbfpStride]);
 		}
 	}
+}
 
-	//
-	// Extract the frac, expo and sign of both sbfp values:
-	//
-	int sbfpFrac1 = 0;
-	int sbfpExpo1 = 0;
-	int sbfpSign1 = 0;
-
-	int sbfpFrac2 = 0;
-	int sbfpExpo2 = 0;
-	int sbfpSign2 = 0;
-
-	if (status == 0)
+//
+// Converts an array of float values to the sbfp16_t type (see float_to_sbfp).
+//
+// [in]  fltValues  - the float values to be converted
+// [in]  fltStride  - the distance, in elements, between consecutive float values (1 if contiguous)
+// [out] sbfpValues - the converted values
+// [in]  sbfpStride - the distance, in elements, between consecutive sbfp values (1 if contiguous)
+// [in]  count      - the number of values to be converted
+//
+void float_to_sbfp16_n(const float *fltValues, ptrdiff_t fltStride, sbfp16_t *sbfpValues, ptrdiff_t sbfpStride, size_t count)
+{
+	if (fltStride == 1 && sbfpStride == 1)
 	{
-		//
-		// First sbfp value:
-		//
-		sbfpFrac1 = sbfpValue1 & ((1 << SBFP_BIT_COUNT_FRAC) - 1);
-		sbfpValue1 >>= SBFP_BIT_COUNT_FRAC;
-
-		sbfpExpo1 = sbfpValue1 & ((1 << SBFP_BIT_COUNT_EXPO) - 1);
-		sbfpValue1 >>= SBFP_BIT_COUNT_EXPO;
+		size_t index = 0;
 
-		sbfpSign1 = sbfpValue1 & ((1 << SBFP_BIT_COUNT_SIGN) - 1);
+#ifdef SBFP_X86
+		if (sbfpX86Kernels.float_to_sbfp16 != NULL)
+		{
+			index = sbfpX86Kernels.float_to_sbfp16(fltValues, sbfpValues, count);
+		}
+#endif
 
-		//
-		// Second sbfp value:
-		//
-		sbfpFrac2 = sbfpValue2 & ((1 << SBFP_BIT_COUNT_FRAC) - 1);
-		sbfpValue1 >>= SBFP_BIT_COUNT_FRAC;
-
-		sbfpExpo2 = sbfpValue2 & ((1 << SBFP_BIT_COUNT_EXPO) - 1);
-		sbfpValue1 >>= SBFP_BIT_COUNT_EXPO;
-
-		sbfpSign2 = sbfpValue2 & ((1 << SBFP_BIT_COUNT_SIGN) - 1);
+		for (; index < count; ++index)
+		{
+			sbfpValues[index] = (sbfp16_t)sbfp_core_encode_float(fltValues[index]);
+		}
 	}
-
-	//
-	// Calculate individual variables for multiplying:
-	//
-	int    E1 = 0;
-	int    E2 = 0;
-	double M1 = 0.0;
-	double M2 = 0.0;
-
-	if (status == 0)
+	else
 	{
-		//
-		// First sbfp value:
-		//
-		if (sbfpExpo1 == 0)
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
 		{
-			E1 = 1 - SBFP_BIAS;
-			M1 = (double)sbfpFrac1 / (1 << SBFP_BIT_COUNT_FRAC);
+			sbfpValues[index * sbfpStride] = (sbfp16_t)sbfp_core_encode_float(fltValues[index * fltStride]);
 		}
-		else
+	}
+}
+
+//
+// Converts an array of sbfp16_t values to float values (see sbfp_to_float).
+//
+// [in]  sbfpValues - the sbfp values to be converted
+// [in]  sbfpStride - the distance, in elements, between consecutive sbfp values (1 if contiguous)
+// [out] fltValues  - the converted values
+// [in]  fltStride  - the distance, in elements, between consecutive float values (1 if contiguous)
+// [in]  count      - the number of values to be converted
+//
+void sbfp16_to_float_n(const sbfp16_t *sbfpValues, ptrdiff_t sbfpStride, float *fltValues, ptrdiff_t fltStride, size_t count)
+{
+	if (sbfpStride == 1 && fltStride == 1)
+	{
+		size_t index = 0;
+
+#ifdef SBFP_X86
+		if (sbfpX86Kernels.sbfp16_to_float != NULL)
 		{
-			E1 = sbfpExpo1 - SBFP_BIAS;
-			M1 = 1 + ((double)sbfpFrac1 / (1 << SBFP_BIT_COUNT_FRAC));
+			index = sbfpX86Kernels.sbfp16_to_float(sbfpValues, fltValues, count);
 		}
+#endif
 
-		//
-		// Second sbfp value:
-		//
-		if (sbfpExpo2 == 0)
+		for (; index < count; ++index)
 		{
-			E2 = 1 - SBFP_BIAS;
-			M2 = (double)sbfpFrac2 / (1 << SBFP_BIT_COUNT_FRAC);
+			fltValues[index] = lookup_float(sbfpValues[index]);
 		}
-		else
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
 		{
-			E2 = sbfpExpo2 - SBFP_BIAS;
-			M2 = 1 + ((double)sbfpFrac2 / (1 << SBFP_BIT_COUNT_FRAC));
+			fltValues[index * fltStride] = lookup_float(sbfpValues[index * sbfpStride]);
 		}
 	}
+}
 
-	//
-	// Multiply the values and return:
-	//
-	if (status == 0)
+//
+// Translates an array of sbfp16_t values from the original sbfp encoding to IEEE
+// binary16, which is the encoding used with SBFP_IEEE_BINARY16. Only SBFP_LEGACY_POS_INF,
+// SBFP_LEGACY_NEG_INF and SBFP_LEGACY_NAN change.
+//
+// [in]  values       - the values to be translated
+// [in]  stride       - the distance, in elements, between consecutive values (1 if contiguous)
+// [out] results      - the translated values (may be the same array as values)
+// [in]  resultStride - the distance, in elements, between consecutive results (1 if contiguous)
+// [in]  count        - the number of values to be translated
+//
+void sbfp_legacy_to_binary16_n(const sbfp16_t *values, ptrdiff_t stride, sbfp16_t *results, ptrdiff_t resultStride, size_t count)
+{
+	if (stride == 1 && resultStride == 1)
 	{
-		int    S = sbfpSign1 ^ sbfpSign2;
-		int    E = E1 + E2;
-		double M = M1 * M2;
-		double sbfpDblProduct = 0.0;
-
-		if (E < 0)
+		for (size_t index = 0; index < count; ++index)
 		{
-			sbfpDblProduct = M / (1 << ((-1) * E));
+			results[index] = (sbfp16_t)sbfp_core_legacy_to_binary16(values[index]);
 		}
-		else
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
 		{
-			sbfpDblProduct = M * (1 << E);
+			results[index * resultStride] = (sbfp16_t)sbfp_core_legacy_to_binary16(values[index * stride]);
 		}
+	}
+}
 
-		if (S == 1)
+//
+// Translates an array of sbfp16_t values from IEEE binary16 to the original sbfp encoding.
+// The infinities become SBFP_LEGACY_POS_INF and SBFP_LEGACY_NEG_INF, and every NaN becomes
+// SBFP_LEGACY_NAN. The original encoding has no 1.0 or 1 + 2^-10, as their bits are
+// SBFP_LEGACY_POS_INF and SBFP_LEGACY_NAN, so those values pass through unchanged and read
+// as the special values, just like double_to_sbfp would produce them.
+//
+// [in]  values       - the values to be translated
+// [in]  stride       - the distance, in elements, between consecutive values (1 if contiguous)
+// [out] results      - the translated values (may be the same array as values)
+// [in]  resultStride - the distance, in elements, between consecutive results (1 if contiguous)
+// [in]  count        - the number of values to be translated
+//
+void sbfp_binary16_to_legacy_n(const sbfp16_t *values, ptrdiff_t stride, sbfp16_t *results, ptrdiff_t resultStride, size_t count)
+{
+	if (stride == 1 && resultStride == 1)
+	{
+		for (size_t index = 0; index < count; ++index)
 		{
-			sbfpDblProduct *= -1;
+			results[index] = (sbfp16_t)sbfp_core_binary16_to_legacy(values[index]);
+		}
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+		{
+			results[index * resultStride] = (sbfp16_t)sbfp_core_binary16_to_legacy(values[index * stride]);
 		}
-
-		sbfpProduct = double_to_sbfp(sbfpDblProduct);
 	}
-
-	return sbfpProduct;
 }
 
 //
-// Adds two special sbfp values.
+// Product significands of every pair of normal fracs, indexed by (frac1 << 10) | frac2.
+// Each entry holds the 10-bit frac of the product rounded to 11 significant bits, nearest
+// even, and above it a carry bit that is set if the rounded product is 2 or more, which
+// adds 1 to the expo.
+// The table takes 2 MB, and it is filled by sbfp_mul_init.
 //
-// [in] sbfpValue1 - the augend
-// [in] sbfpValue2 - the addend
+static uint16_t sbfpMulTable[1 << (2 * SBFP_BIT_COUNT_FRAC)];
+
 //
-// Returns the sum.
+// Gives up the processor to the thread that fills the product table, so a thread waiting
+// for the table does not take the time the filling thread needs on the same core:
 //
-sbfp_t handle_special_add(sbfp_t sbfpValue1, sbfp_t sbfpValue2)
-{
-	sbfp_t sbfpSum = 0;
+#if defined(__unix__) || defined(__APPLE__)
+#include <sched.h>
+#define SBFP_YIELD() sched_yield()
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define SBFP_YIELD() _mm_pause()
+#else
+#define SBFP_YIELD() ((void)0)
+#endif
+
+//
+// The state of the table and the selected engine. Both are atomic, so any thread may call
+// sbfp_mul_init while others multiply: the table is filled once and published with a
+// release store, and sbfp_mul loads the engine with acquire, so it never sees the table
+// engine before the table it reads.
+//
+static atomic_int sbfpMulTableState = SBFP_MUL_TABLE_EMPTY;
+static atomic_int sbfpMulEngine     = SBFP_MUL_ENGINE_ARITHMETIC;
 
-	switch (sbfpValue1)
+//
+// Fills the product table (see sbfpMulTable).
+//
+static void fill_mul_table(void)
+{
+	for (uint32_t frac1 = 0; frac1 <= SBFP_FRAC_MASK; ++frac1)
 	{
-		case SBFP_POS_INF:
+		for (uint32_t frac2 = 0; frac2 <= SBFP_FRAC_MASK; ++frac2)
 		{
-			if (sbfpValue2 == SBFP_POS_INF)
-			{
-				sbfpSum = SBFP_POS_INF;
-			}
-			else if (sbfpValue2 == SBFP_NEG_INF)
-			{
-				sbfpSum = SBFP_NAN;
-			}
-			else if (sbfpValue2 == SBFP_NAN)
-			{
-				sbfpSum = SBFP_NAN;
-			}
-			else
-			{
-				sbfpSum = SBFP_POS_INF;
-			}
-		}
+			uint32_t product = (frac1 | (1U << SBFP_BIT_COUNT_FRAC)) * (frac2 | (1U << SBFP_BIT_COUNT_FRAC));
+			uint32_t carry   = product >> (2 * SBFP_BIT_COUNT_FRAC + 1);
 
-		case SBFP_NEG_INF:
-		{
-			if (sbfpValue2 == SBFP_POS_INF)
-			{
-				sbfpSum = SBFP_NAN;
-			}
-			else if (sbfpValue2 == SBFP_NEG_INF)
-			{
-				sbfpSum = SBFP_NEG_INF;
-			}
-			else if (sbfpValue2 == SBFP_NAN)
-			{
-				sbfpSum = SBFP_NAN;
-			}
-			else
-			{
-				sbfpSum = SBFP_NEG_INF;
-			}
-		}
+			//
+			// Round to 11 bits, which carries the product to 2 when it rounds up from just
+			// below it:
+			//
+			uint32_t dropCount = SBFP_BIT_COUNT_FRAC + carry;
+			uint32_t sig       = (product + (1U << (dropCount - 1)) - 1 + ((product >> dropCount) & 1)) >> dropCount;
 
-		case SBFP_NAN:
-		{
-			if (sbfpValue2 == SBFP_POS_INF)
-			{
-				sbfpSum = SBFP_NAN;
-			}
-			else if (sbfpValue2 == SBFP_NEG_INF)
-			{
-				sbfpSum = SBFP_NAN;
-			}
-			else if (sbfpValue2 == SBFP_NAN)
-			{
-				sbfpSum = SBFP_NAN;
-			}
-			else
-			{
-				sbfpSum = SBFP_NAN;
-			}
-		}
+			carry |= sig >> (SBFP_BIT_COUNT_FRAC + 1);
 
-		default:
-		{
-			if (sbfpValue2 == SBFP_POS_INF)
-			{
-				sbfpSum = SBFP_POS_INF;
-			}
-			else if (sbfpValue2 == SBFP_NEG_INF)
-			{
-				sbfpSum = SBFP_NEG_INF;
-			}
-			else if (sbfpValue2 == SBFP_NAN)
-			{
-				sbfpSum = SBFP_NAN;
-			}
-			else
-			{
-				// error: you shouldn't be here
-			}
+			sbfpMulTable[(frac1 << SBFP_BIT_COUNT_FRAC) | frac2] = (uint16_t)((sig & SBFP_FRAC_MASK) | (carry << SBFP_BIT_COUNT_FRAC));
 		}
 	}
-
-	return sbfpSum;
 }
 
 //
-// Adds two sbfp values.
+// Multiplies two sbfp values with the table engine.
 //
-// [in] sbfpValue1 - the augend
-// [in] sbfpValue2 - the addend
+// Two normal values are multiplied with one lookup of their product's significand, which
+// is already rounded to 11 bits, so a normal result is the same as the arithmetic
+// engine's. A subnormal result has fewer frac bits, and rounding the rounded significand
+// again could differ from rounding the exact product once, so it is left to the
+// arithmetic engine, as are zeros, subnormals, infinity and NaN, and a result that rounds
+// to 2^-14 in the original encoding.
 //
-// Returns the sum.
+// [in] sbfpValue1 - the multiplicand
+// [in] sbfpValue2 - the multiplier
 //
-sbfp_t sbfp_add(sbfp_t sbfpValue1, sbfp_t sbfpValue2)
+// Returns the product.
+//
+static inline sbfp_t multiply_table(sbfp_t sbfpValue1, sbfp_t sbfpValue2)
 {
 	int status = 0;
 
-	sbfp_t sbfpSum = 0;
+	int bitsProduct = 0;
+
+	//
+	// Extract the frac, expo and sign of both sbfp values:
+	//
+	int bits1 = sbfpValue1 & SBFP_BIT_MASK;
+	int bits2 = sbfpValue2 & SBFP_BIT_MASK;
+
+	int sbfpFrac1 = bits1 & SBFP_FRAC_MASK;
+	int sbfpExpo1 = (bits1 >> SBFP_BIT_COUNT_FRAC) & SBFP_EXPO_MASK;
+	int sbfpSign1 = bits1 >> (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC);
+
+	int sbfpFrac2 = bits2 & SBFP_FRAC_MASK;
+	int sbfpExpo2 = (bits2 >> SBFP_BIT_COUNT_FRAC) & SBFP_EXPO_MASK;
+	int sbfpSign2 = bits2 >> (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC);
 
 	//
-	// Handle if the sbfp values are infinity or NaN:
+	// Handle if either sbfp value is not a normal number:
 	//
 	if (status == 0)
 	{
-		if (sbfpValue1 == SBFP_POS_INF || sbfpValue1 == SBFP_NEG_INF || sbfpValue1 == SBFP_NAN ||
-			sbfpValue2 == SBFP_POS_INF || sbfpValue2 == SBFP_NEG_INF || sbfpValue2 == SBFP_NAN)
+		if (sbfp_core_is_special(bits1) | sbfp_core_is_special(bits2) | (sbfpExpo1 == 0) | (sbfpExpo2 == 0))
 		{
-			sbfpSum = handle_special_add(sbfpValue1, sbfpValue2);
+			bitsProduct = sbfp_core_to_binary16(sbfp_core_multiply_arithmetic(sbfpValue1, sbfpValue2));
 
 			status = 1;
 		}
 	}
 
 	//
-	// Extract the frac, expo and sign of both sbfp values:
+	// Look up the product's significand, add the expos (with the carry), and concatenate
+	// the sign:
 	//
-	int sbfpFrac1 = 0;
-	int sbfpExpo1 = 0;
-	int sbfpSign1 = 0;
-
-	int sbfpFrac2 = 0;
-	int sbfpExpo2 = 0;
-	int sbfpSign2 = 0;
-
 	if (status == 0)
 	{
-		//
-		// First sbfp value:
-		//
-		sbfpFrac1 = sbfpValue1 & ((1 << SBFP_BIT_COUNT_FRAC) - 1);
-		sbfpValue1 >>= SBFP_BIT_COUNT_FRAC;
+		int entry = sbfpMulTable[(sbfpFrac1 << SBFP_BIT_COUNT_FRAC) | sbfpFrac2];
+
+		int E = sbfpExpo1 + sbfpExpo2 - SBFP_BIAS + (entry >> SBFP_BIT_COUNT_FRAC);
 
-		sbfpExpo1 = sbfpValue1 & ((1 << SBFP_BIT_COUNT_EXPO) - 1);
-		sbfpValue1 >>= SBFP_BIT_COUNT_EXPO;
+		bitsProduct = (E << SBFP_BIT_COUNT_FRAC) | (entry & SBFP_FRAC_MASK);
 
-		sbfpSign1 = sbfpValue1 & ((1 << SBFP_BIT_COUNT_SIGN) - 1);
+		bitsProduct = (E >= SBFP_EXPO_MASK) ? BINARY16_POS_INF : bitsProduct;
 
 		//
-		// Second sbfp value:
+		// Handle if the product is subnormal, or rounds to 2^-14 in the original encoding:
 		//
-		sbfpFrac2 = sbfpValue2 & ((1 << SBFP_BIT_COUNT_FRAC) - 1);
-		sbfpValue2 >>= SBFP_BIT_COUNT_FRAC;
+		if ((E < 1) | (SBFP_ZERO_MIN_NORMAL & (bitsProduct == (1 << SBFP_BIT_COUNT_FRAC))))
+		{
+			bitsProduct = sbfp_core_to_binary16(sbfp_core_multiply_arithmetic(sbfpValue1, sbfpValue2));
+		}
+		else
+		{
+			bitsProduct |= (sbfpSign1 ^ sbfpSign2) << (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC);
+		}
+	}
 
-		sbfpExpo2 = sbfpValue2 & ((1 << SBFP_BIT_COUNT_EXPO) - 1);
-		sbfpValue2 >>= SBFP_BIT_COUNT_EXPO;
+	return sbfp_core_from_binary16(bitsProduct);
+}
 
-		sbfpSign2 = sbfpValue2 & ((1 << SBFP_BIT_COUNT_SIGN) - 1);
-	}
+//
+// Selects the engine used by sbfp_mul. The table engine fills its table the first time it
+// is selected, which takes a few milliseconds. If several threads select it at once, one
+// fills the table and the others wait for it. The engine is a process-wide setting, and
+// it may be changed while other threads call sbfp_mul, which give the same results with
+// either engine.
+//
+// [in] engine - SBFP_MUL_ENGINE_ARITHMETIC (the default) or SBFP_MUL_ENGINE_TABLE
+//
+// Returns 0 if the engine was selected, or -1 if it is not a known engine.
+//
+int sbfp_mul_init(int engine)
+{
+	int status = 0;
 
-	//
-	// Compute individual variables for adding:
-	//
-	int    S1 = 1;
-	int    S2 = 1;
-	int    E1 = 0;
-	int    E2 = 0;
-	double M1 = 0.0;
-	double M2 = 0.0;
+	if (status == 0)
+	{
+		if (engine != SBFP_MUL_ENGINE_ARITHMETIC && engine != SBFP_MUL_ENGINE_TABLE)
+		{
+			status = -1;
+		}
+	}
 
 	if (status == 0)
 	{
-		//
-		// First sbfp value:
-		//
-		if (sbfpSign1 == 1)
+		if (engine == SBFP_MUL_ENGINE_TABLE)
+		{
+			int state = SBFP_MUL_TABLE_EMPTY;
+
+			if (atomic_compare_exchange_strong_explicit(&sbfpMulTableState, &state, SBFP_MUL_TABLE_FILLING,
+				memory_order_acquire, memory_order_acquire))
+			{
+				fill_mul_table();
+
+				atomic_store_explicit(&sbfpMulTableState, SBFP_MUL_TABLE_FILLED, memory_order_release);
+			}
+
+			while (atomic_load_explicit(&sbfpMulTableState, memory_order_acquire) != SBFP_MUL_TABLE_FILLED)
+			{
+				// another thread is filling the table
+				SBFP_YIELD();
+			}
+		}
+
+		atomic_store_explicit(&sbfpMulEngine, engine, memory_order_release);
+	}
+
+	return status;
+}
+
+//
+// Multiplies two sbfp values with the engine selected by sbfp_mul_init.
+//
+// [in] sbfpValue1 - the multiplicand
+// [in] sbfpValue2 - the multiplier
+//
+// Returns the product.
+//
+static inline sbfp_t multiply(sbfp_t sbfpValue1, sbfp_t sbfpValue2)
+{
+	sbfp_t sbfpProduct = 0;
+
+	if (atomic_load_explicit(&sbfpMulEngine, memory_order_acquire) == SBFP_MUL_ENGINE_TABLE)
+	{
+		sbfpProduct = multiply_table(sbfpValue1, sbfpValue2);
+	}
+	else
+	{
+		sbfpProduct = sbfp_core_multiply_arithmetic(sbfpValue1, sbfpValue2);
+	}
+
+	return sbfpProduct;
+}
+
+//
+// Multiplies two sbfp values, with the engine selected by sbfp_mul_init. Both engines give
+// the same results.
+//
+// [in] sbfpValue1 - the multiplicand
+// [in] sbfpValue2 - the multiplier
+//
+// Returns the product.
+//
+sbfp_t sbfp_mul(sbfp_t sbfpValue1, sbfp_t sbfpValue2)
+{
+	return multiply(sbfpValue1, sbfpValue2);
+}
+
+//
+// Multiplies arrays of sbfp values elementwise (see sbfp_mul). A stride of 0 repeats the
+// same value for every element.
+//
+// [in]  sbfpValues1  - the multiplicands
+// [in]  sbfpStride1  - the distance, in elements, between consecutive multiplicands (1 if contiguous)
+// [in]  sbfpValues2  - the multipliers
+// [in]  sbfpStride2  - the distance, in elements, between consecutive multipliers (1 if contiguous)
+// [out] sbfpResults  - the products (may be the same array as either operand)
+// [in]  resultStride - the distance, in elements, between consecutive products (1 if contiguous)
+// [in]  count        - the number of elements
+//
+void sbfp_mul_n(const sbfp_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp_t *sbfpResults, ptrdiff_t resultStride, size_t count)
+{
+	if (sbfpStride1 == 1 && sbfpStride2 == 1 && resultStride == 1)
+	{
+		size_t index = 0;
+
+#ifdef SBFP_X86
+		if (sbfpX86Kernels.sbfp_mul != NULL)
 		{
-			S1 = -1;
+			index = sbfpX86Kernels.sbfp_mul(sbfpValues1, sbfpValues2, sbfpResults, count);
 		}
+#endif
 
-		if (sbfpExpo1 == 0)
+		for (; index < count; ++index)
 		{
-			E1 = 1 - SBFP_BIAS;
-			M1 = (double)sbfpFrac1 / (1 << SBFP_BIT_COUNT_FRAC);
+			sbfpResults[index] = multiply(sbfpValues1[index], sbfpValues2[index]);
 		}
-		else
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
 		{
-			E1 = sbfpExpo1 - SBFP_BIAS;
-			M1 = 1 + ((double)sbfpFrac1 / (1 << SBFP_BIT_COUNT_FRAC));
+			sbfpResults[index * resultStride] = multiply(sbfpValues1[index * sbfpStride1], sbfpValues2[index * sbfpStride2]);
 		}
+	}
+}
 
-		//
-		// Second sbfp value:
-		//
-		if (sbfpSign2 == 1)
+//
+// Multiplies arrays of sbfp16_t values elementwise (see sbfp_mul_n).
+//
+// [in]  sbfpValues1  - the multiplicands
+// [in]  sbfpStride1  - the distance, in elements, between consecutive multiplicands (1 if contiguous)
+// [in]  sbfpValues2  - the multipliers
+// [in]  sbfpStride2  - the distance, in elements, between consecutive multipliers (1 if contiguous)
+// [out] sbfpResults  - the products (may be the same array as either operand)
+// [in]  resultStride - the distance, in elements, between consecutive products (1 if contiguous)
+// [in]  count        - the number of elements
+//
+void sbfp16_mul_n(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp16_t *sbfpResults, ptrdiff_t resultStride, size_t count)
+{
+	if ((sbfpStride1 == 0 || sbfpStride1 == 1) && (sbfpStride2 == 0 || sbfpStride2 == 1) && resultStride == 1)
+	{
+		size_t index = 0;
+
+#ifdef SBFP_X86
+		if (sbfpX86Kernels.sbfp16_mul != NULL)
 		{
-			S2 = -1;
+			index = sbfpX86Kernels.sbfp16_mul(sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, count);
 		}
+#endif
 
-		if (sbfpExpo2 == 0)
+		for (; index < count; ++index)
 		{
-			E2 = 1 - SBFP_BIAS;
-			M2 = (double)sbfpFrac2 / (1 << SBFP_BIT_COUNT_FRAC);
+			sbfpResults[index] = (sbfp16_t)multiply(sbfpValues1[index * sbfpStride1], sbfpValues2[index * sbfpStride2]);
 		}
-		else
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
 		{
-			E2 = sbfpExpo2 - SBFP_BIAS;
-			M2 = 1 + ((double)sbfpFrac2 / (1 << SBFP_BIT_COUNT_FRAC));
+			sbfpResults[index * resultStride] = (sbfp16_t)multiply(sbfpValues1[index * sbfpStride1], sbfpValues2[index * sbfpStride2]);
 		}
 	}
+}
 
-	//
-	// Compute sum:
-	//
-	int    E          = 0;
-	double M          = 0.0;
-	double sbfpDblSum = 0.0;
+//
+// Adds two sbfp values. The result is the exact sum rounded like double_to_sbfp would
+// round it.
+//
+// [in] sbfpValue1 - the augend
+// [in] sbfpValue2 - the addend
+//
+// Returns the sum.
+//
+sbfp_t sbfp_add(sbfp_t sbfpValue1, sbfp_t sbfpValue2)
+{
+	return sbfp_core_add(sbfpValue1, sbfpValue2, 0);
+}
 
-	if (E1 > E2)
+//
+// Adds arrays of sbfp values elementwise (see sbfp_add). A stride of 0 repeats the
+// same value for every element.
+//
+// [in]  sbfpValues1  - the augends
+// [in]  sbfpStride1  - the distance, in elements, between consecutive augends (1 if contiguous)
+// [in]  sbfpValues2  - the addends
+// [in]  sbfpStride2  - the distance, in elements, between consecutive addends (1 if contiguous)
+// [out] sbfpResults  - the sums (may be the same array as either operand)
+// [in]  resultStride - the distance, in elements, between consecutive sums (1 if contiguous)
+// [in]  count        - the number of elements
+//
+void sbfp_add_n(const sbfp_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp_t *sbfpResults, ptrdiff_t resultStride, size_t count)
+{
+	if (sbfpStride1 == 1 && sbfpStride2 == 1 && resultStride == 1)
 	{
-		E = E2;
-		M1 *= (1 << (E1 - E2));
+		size_t index = 0;
+
+#ifdef SBFP_X86
+		if (sbfpX86Kernels.sbfp_add != NULL)
+		{
+			index = sbfpX86Kernels.sbfp_add(sbfpValues1, sbfpValues2, sbfpResults, count);
+		}
+#endif
+
+		for (; index < count; ++index)
+		{
+			sbfpResults[index] = sbfp_core_add(sbfpValues1[index], sbfpValues2[index], 0);
+		}
 	}
 	else
 	{
-		E = E1;
-		M2 *= (1 << (E2 - E1));
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+		{
+			sbfpResults[index * resultStride] = sbfp_core_add(sbfpValues1[index * sbfpStride1], sbfpValues2[index * sbfpStride2], 0);
+		}
 	}
+}
 
-	M = (S1 * M1) + (S2 * M2);
-
-	if (E < 0)
+//
+// Adds arrays of sbfp16_t values elementwise (see sbfp_add_n).
+//
+// [in]  sbfpValues1  - the augends
+// [in]  sbfpStride1  - the distance, in elements, between consecutive augends (1 if contiguous)
+// [in]  sbfpValues2  - the addends
+// [in]  sbfpStride2  - the distance, in elements, between consecutive addends (1 if contiguous)
+// [out] sbfpResults  - the sums (may be the same array as either operand)
+// [in]  resultStride - the distance, in elements, between consecutive sums (1 if contiguous)
+// [in]  count        - the number of elements
+//
+void sbfp16_add_n(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp16_t *sbfpResults, ptrdiff_t resultStride, size_t count)
+{
+	if ((sbfpStride1 == 0 || sbfpStride1 == 1) && (sbfpStride2 == 0 || sbfpStride2 == 1) && resultStride == 1)
 	{
-		sbfpDblSum = M / (1 << ((-1) * E));
+		size_t index = 0;
+
+#ifdef SBFP_X86
+		if (sbfpX86Kernels.sbfp16_add != NULL)
+		{
+			index = sbfpX86Kernels.sbfp16_add(sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, count);
+		}
+#endif
+
+		for (; index < count; ++index)
+		{
+			sbfpResults[index] = (sbfp16_t)sbfp_core_add(sbfpValues1[index * sbfpStride1], sbfpValues2[index * sbfpStride2], 0);
+		}
 	}
 	else
 	{
-		sbfpDblSum = M * (1 << E);
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+		{
+			sbfpResults[index * resultStride] = (sbfp16_t)sbfp_core_add(sbfpValues1[index * sbfpStride1], sbfpValues2[index * sbfpStride2], 0);
+		}
 	}
+}
+
+//
+// Subtracts an sbfp value from another. The result is the exact difference rounded like
+// double_to_sbfp would round it.
+//
+// [in] sbfpValue1 - the minuend
+// [in] sbfpValue2 - the subtrahend
+//
+// Returns the difference.
+//
+sbfp_t sbfp_sub(sbfp_t sbfpValue1, sbfp_t sbfpValue2)
+{
+	return sbfp_core_add(sbfpValue1, sbfpValue2, 1);
+}
+
+//
+// Subtracts arrays of sbfp values elementwise (see sbfp_sub). A stride of 0 repeats the
+// same value for every element.
+//
+// [in]  sbfpValues1  - the minuends
+// [in]  sbfpStride1  - the distance, in elements, between consecutive minuends (1 if contiguous)
+// [in]  sbfpValues2  - the subtrahends
+// [in]  sbfpStride2  - the distance, in elements, between consecutive subtrahends (1 if contiguous)
+// [out] sbfpResults  - the differences (may be the same array as either operand)
+// [in]  resultStride - the distance, in elements, between consecutive differences (1 if contiguous)
+// [in]  count        - the number of elements
+//
+void sbfp_sub_n(const sbfp_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp_t *sbfpResults, ptrdiff_t resultStride, size_t count)
+{
+	if (sbfpStride1 == 1 && sbfpStride2 == 1 && resultStride == 1)
+	{
+		size_t index = 0;
+
+#ifdef SBFP_X86
+		if (sbfpX86Kernels.sbfp_sub != NULL)
+		{
+			index = sbfpX86Kernels.sbfp_sub(sbfpValues1, sbfpValues2, sbfpResults, count);
+		}
+#endif
+
+		for (; index < count; ++index)
+		{
+			sbfpResults[index] = sbfp_core_add(sbfpValues1[index], sbfpValues2[index], 1);
+		}
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+		{
+			sbfpResults[index * resultStride] = sbfp_core_add(sbfpValues1[index * sbfpStride1], sbfpValues2[index * sbfpStride2], 1);
+		}
+	}
+}
+
+//
+// Subtracts arrays of sbfp16_t values elementwise (see sbfp_sub_n).
+//
+// [in]  sbfpValues1  - the minuends
+// [in]  sbfpStride1  - the distance, in elements, between consecutive minuends (1 if contiguous)
+// [in]  sbfpValues2  - the subtrahends
+// [in]  sbfpStride2  - the distance, in elements, between consecutive subtrahends (1 if contiguous)
+// [out] sbfpResults  - the differences (may be the same array as either operand)
+// [in]  resultStride - the distance, in elements, between consecutive differences (1 if contiguous)
+// [in]  count        - the number of elements
+//
+void sbfp16_sub_n(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp16_t *sbfpResults, ptrdiff_t resultStride, size_t count)
+{
+	if ((sbfpStride1 == 0 || sbfpStride1 == 1) && (sbfpStride2 == 0 || sbfpStride2 == 1) && resultStride == 1)
+	{
+		size_t index = 0;
+
+#ifdef SBFP_X86
+		if (sbfpX86Kernels.sbfp16_sub != NULL)
+		{
+			index = sbfpX86Kernels.sbfp16_sub(sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, count);
+		}
+#endif
+
+		for (; index < count; ++index)
+		{
+			sbfpResults[index] = (sbfp16_t)sbfp_core_add(sbfpValues1[index * sbfpStride1], sbfpValues2[index * sbfpStride2], 1);
+		}
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+		{
+			sbfpResults[index * resultStride] = (sbfp16_t)sbfp_core_add(sbfpValues1[index * sbfpStride1], sbfpValues2[index * sbfpStride2], 1);
+		}
+	}
+}
+
+//
+// Multiplies two sbfp values and adds a third with a single rounding.
+//
+// The product of the significands is exact, and it is aligned with the addend's
+// significand as integers like in sbfp_add. An addend too far below the product (or a
+// product too far below the addend) to fit the alignment only decides the direction of
+// the rounding, so it is kept as a sticky bit below the larger one's frac.
+//
+// [in] sbfpValue1 - the multiplicand
+// [in] sbfpValue2 - the multiplier
+// [in] sbfpValue3 - the addend
+// [in] mode       - the rounding mode (see SBFP_ROUND_NEAREST_EVEN)
+//
+// Returns the rounded value of sbfpValue1 * sbfpValue2 + sbfpValue3.
+//
+static inline sbfp_t multiply_add(sbfp_t sbfpValue1, sbfp_t sbfpValue2, sbfp_t sbfpValue3, int mode)
+{
+	int status = 0;
+
+	int bitsResult = 0;
+
+	//
+	// Extract the frac, expo and sign of the three sbfp values:
+	//
+	int bits1 = sbfpValue1 & SBFP_BIT_MASK;
+	int bits2 = sbfpValue2 & SBFP_BIT_MASK;
+	int bits3 = sbfpValue3 & SBFP_BIT_MASK;
+
+	int sbfpFrac1 = bits1 & SBFP_FRAC_MASK;
+	int sbfpExpo1 = (bits1 >> SBFP_BIT_COUNT_FRAC) & SBFP_EXPO_MASK;
+	int sbfpSign1 = bits1 >> (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC);
+
+	int sbfpFrac2 = bits2 & SBFP_FRAC_MASK;
+	int sbfpExpo2 = (bits2 >> SBFP_BIT_COUNT_FRAC) & SBFP_EXPO_MASK;
+	int sbfpSign2 = bits2 >> (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC);
+
+	int sbfpFrac3 = bits3 & SBFP_FRAC_MASK;
+	int sbfpExpo3 = (bits3 >> SBFP_BIT_COUNT_FRAC) & SBFP_EXPO_MASK;
+	int sbfpSign3 = bits3 >> (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC);
+
+	//
+	// Handle if the sbfp values are infinity or NaN (a finite product is passed on as
+	// zero, since only the addend can then be special):
+	//
+	if (status == 0)
+	{
+		if (sbfp_core_is_special(bits1) | sbfp_core_is_special(bits2) | sbfp_core_is_special(bits3))
+		{
+			int special1 = sbfp_core_to_binary16(sbfpValue1);
+			int special2 = sbfp_core_to_binary16(sbfpValue2);
+			int special3 = sbfp_core_to_binary16(sbfpValue3);
+
+			int outcomeProduct = sbfpMulOutcomes[sbfp_core_classify_binary16(special1)][sbfp_core_classify_binary16(special2)];
+			int bitsProduct    = 0;
+
+			if (outcomeProduct != SBFP_OUTCOME_FINITE)
+			{
+				bitsProduct = sbfp_core_handle_special(outcomeProduct, special1, special2);
+			}
+
+			bitsResult = sbfp_core_handle_special(sbfpAddOutcomes[sbfp_core_classify_binary16(bitsProduct)][sbfp_core_classify_binary16(special3)], bitsProduct, special3);
+
+			status = 1;
+		}
+	}
+
+	//
+	// Multiply the significands (with the implicit bit for normals), align the product and
+	// the addend's significand to the smaller expo, add them with their signs, and return:
+	//
+	if (status == 0)
+	{
+		const int maxShift = 63 - 2 * (SBFP_BIT_COUNT_FRAC + 1) - 1; // keeps a shifted product below 2^62
+
+		int64_t M1 = sbfpFrac1 | ((sbfpExpo1 != 0) << SBFP_BIT_COUNT_FRAC);
+		int64_t M2 = sbfpFrac2 | ((sbfpExpo2 != 0) << SBFP_BIT_COUNT_FRAC);
+		int64_t M3 = sbfpFrac3 | ((sbfpExpo3 != 0) << SBFP_BIT_COUNT_FRAC);
+
+		int E1 = sbfpExpo1 + (sbfpExpo1 == 0) - SBFP_BIAS - SBFP_BIT_COUNT_FRAC;
+		int E2 = sbfpExpo2 + (sbfpExpo2 == 0) - SBFP_BIAS - SBFP_BIT_COUNT_FRAC;
+		int E3 = sbfpExpo3 + (sbfpExpo3 == 0) - SBFP_BIAS - SBFP_BIT_COUNT_FRAC;
+
+		int64_t MP = M1 * M2;
+		int     EP = E1 + E2;
+
+		//
+		// A zero term needs no alignment, and a term beyond the alignment becomes sticky:
+		//
+		EP = (MP == 0) ? E3 : EP;
+		E3 = (M3 == 0) ? EP : E3;
+
+		if (EP - E3 > maxShift)
+		{
+			M3 = 1;
+			E3 = EP - SBFP_BIT_COUNT_FRAC - 2;
+		}
+		else if (E3 - EP > maxShift)
+		{
+			MP = 1;
+			EP = E3 - SBFP_BIT_COUNT_FRAC - 2;
+		}
+
+		int E = (EP < E3) ? EP : E3;
+
+		MP <<= EP - E;
+		M3 <<= E3 - E;
+
+		MP = (MP ^ (0 - (int64_t)(sbfpSign1 ^ sbfpSign2))) + (sbfpSign1 ^ sbfpSign2);
+		M3 = (M3 ^ (0 - (int64_t)sbfpSign3)) + sbfpSign3;
+
+		int64_t M        = MP + M3;
+		int64_t signMask = M >> 63;
+
+		//
+		// An exact zero result is negative only if both the product and the addend are, or
+		// if either is when rounding downward:
+		//
+		int sign = (int)(signMask & 1) | ((sbfpSign1 ^ sbfpSign2) & sbfpSign3) |
+		           (((sbfpSign1 ^ sbfpSign2) | sbfpSign3) & (M == 0) & (mode == SBFP_ROUND_DOWNWARD));
+
+		bitsResult = sbfp_core_pack_binary16_round(sign, (uint64_t)((M ^ signMask) - signMask), E, mode, 0);
+	}
+
+	return sbfp_core_from_binary16(bitsResult);
+}
+
+//
+// Multiplies two sbfp values and adds a third, rounding only once. The result is the exact
+// value of sbfpValue1 * sbfpValue2 + sbfpValue3 rounded like double_to_sbfp would round
+// it, which sbfp_mul followed by sbfp_add does not always give.
+//
+// [in] sbfpValue1 - the multiplicand
+// [in] sbfpValue2 - the multiplier
+// [in] sbfpValue3 - the addend
+//
+// Returns the result.
+//
+sbfp_t sbfp_fma(sbfp_t sbfpValue1, sbfp_t sbfpValue2, sbfp_t sbfpValue3)
+{
+	return multiply_add(sbfpValue1, sbfpValue2, sbfpValue3, SBFP_ROUND_NEAREST_EVEN);
+}
+
+//
+// Multiplies and adds arrays of sbfp values elementwise (see sbfp_fma). A stride of 0
+// repeats the same value for every element.
+//
+// [in]  sbfpValues1  - the multiplicands
+// [in]  sbfpStride1  - the distance, in elements, between consecutive multiplicands (1 if contiguous)
+// [in]  sbfpValues2  - the multipliers
+// [in]  sbfpStride2  - the distance, in elements, between consecutive multipliers (1 if contiguous)
+// [in]  sbfpValues3  - the addends
+// [in]  sbfpStride3  - the distance, in elements, between consecutive addends (1 if contiguous)
+// [out] sbfpResults  - the results (may be the same array as any operand)
+// [in]  resultStride - the distance, in elements, between consecutive results (1 if contiguous)
+// [in]  count        - the number of elements
+//
+void sbfp_fma_n(const sbfp_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	const sbfp_t *sbfpValues3, ptrdiff_t sbfpStride3, sbfp_t *sbfpResults, ptrdiff_t resultStride, size_t count)
+{
+	if (sbfpStride1 == 1 && sbfpStride2 == 1 && sbfpStride3 == 1 && resultStride == 1)
+	{
+		for (size_t index = 0; index < count; ++index)
+		{
+			sbfpResults[index] = multiply_add(sbfpValues1[index], sbfpValues2[index], sbfpValues3[index], SBFP_ROUND_NEAREST_EVEN);
+		}
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+		{
+			sbfpResults[index * resultStride] = multiply_add(sbfpValues1[index * sbfpStride1],
+				sbfpValues2[index * sbfpStride2], sbfpValues3[index * sbfpStride3], SBFP_ROUND_NEAREST_EVEN);
+		}
+	}
+}
+
+//
+// Multiplies and adds arrays of sbfp16_t values elementwise (see sbfp_fma_n).
+//
+// [in]  sbfpValues1  - the multiplicands
+// [in]  sbfpStride1  - the distance, in elements, between consecutive multiplicands (1 if contiguous)
+// [in]  sbfpValues2  - the multipliers
+// [in]  sbfpStride2  - the distance, in elements, between consecutive multipliers (1 if contiguous)
+// [in]  sbfpValues3  - the addends
+// [in]  sbfpStride3  - the distance, in elements, between consecutive addends (1 if contiguous)
+// [out] sbfpResults  - the results (may be the same array as any operand)
+// [in]  resultStride - the distance, in elements, between consecutive results (1 if contiguous)
+// [in]  count        - the number of elements
+//
+void sbfp16_fma_n(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	const sbfp16_t *sbfpValues3, ptrdiff_t sbfpStride3, sbfp16_t *sbfpResults, ptrdiff_t resultStride, size_t count)
+{
+	if (sbfpStride1 == 1 && sbfpStride2 == 1 && sbfpStride3 == 1 && resultStride == 1)
+	{
+		for (size_t index = 0; index < count; ++index)
+		{
+			sbfpResults[index] = (sbfp16_t)multiply_add(sbfpValues1[index], sbfpValues2[index], sbfpValues3[index], SBFP_ROUND_NEAREST_EVEN);
+		}
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+		{
+			sbfpResults[index * resultStride] = (sbfp16_t)multiply_add(sbfpValues1[index * sbfpStride1],
+				sbfpValues2[index * sbfpStride2], sbfpValues3[index * sbfpStride3], SBFP_ROUND_NEAREST_EVEN);
+		}
+	}
+}
+
+//
+// Reciprocals of every normal significand, floor(2^22 / (2^10 + frac)), indexed by frac
+// (see divide):
+//
+static const uint16_t sbfpRecipTable[1 << SBFP_BIT_COUNT_FRAC] =
+{
+	4096, 4092, 4088, 4084, 4080, 4076, 4072, 4068, 4064, 4060, 4056, 4052, 4048, 4044, 4040, 4036,
+	4032, 4029, 4025, 4021, 4017, 4013, 4009, 4006, 4002, 3998, 3994, 3990, 3986, 3983, 3979, 3975,
+	3971, 3968, 3964, 3960, 3956, 3953, 3949, 3945, 3942, 3938, 3934, 3930, 3927, 3923, 3919, 3916,
+	3912, 3908, 3905, 3901, 3898, 3894, 3890, 3887, 3883, 3880, 3876, 3872, 3869, 3865, 3862, 3858,
+	3855, 3851, 3847, 3844, 3840, 3837, 3833, 3830, 3826, 3823, 3819, 3816, 3813, 3809, 3806, 3802,
+	3799, 3795, 3792, 3788, 3785, 3782, 3778, 3775, 3771, 3768, 3765, 3761, 3758, 3754, 3751, 3748,
+	3744, 3741, 3738, 3734, 3731, 3728, 3724, 3721, 3718, 3715, 3711, 3708, 3705, 3701, 3698, 3695,
+	3692, 3688, 3685, 3682, 3679, 3675, 3672, 3669, 3666, 3663, 3659, 3656, 3653, 3650, 3647, 3644,
+	3640, 3637, 3634, 3631, 3628, 3625, 3622, 3618, 3615, 3612, 3609, 3606, 3603, 3600, 3597, 3594,
+	3591, 3587, 3584, 3581, 3578, 3575, 3572, 3569, 3566, 3563, 3560, 3557, 3554, 3551, 3548, 3545,
+	3542, 3539, 3536, 3533, 3530, 3527, 3524, 3521, 3518, 3515, 3512, 3509, 3506, 3504, 3501, 3498,
+	3495, 3492, 3489, 3486, 3483, 3480, 3477, 3474, 3472, 3469, 3466, 3463, 3460, 3457, 3454, 3452,
+	3449, 3446, 3443, 3440, 3437, 3435, 3432, 3429, 3426, 3423, 3421, 3418, 3415, 3412, 3410, 3407,
+	3404, 3401, 3398, 3396, 3393, 3390, 3387, 3385, 3382, 3379, 3377, 3374, 3371, 3368, 3366, 3363,
+	3360, 3358, 3355, 3352, 3350, 3347, 3344, 3342, 3339, 3336, 3334, 3331, 3328, 3326, 3323, 3320,
+	3318, 3315, 3313, 3310, 3307, 3305, 3302, 3300, 3297, 3294, 3292, 3289, 3287, 3284, 3281, 3279,
+	3276, 3274, 3271, 3269, 3266, 3264, 3261, 3258, 3256, 3253, 3251, 3248, 3246, 3243, 3241, 3238,
+	3236, 3233, 3231, 3228, 3226, 3223, 3221, 3218, 3216, 3214, 3211, 3209, 3206, 3204, 3201, 3199,
+	3196, 3194, 3192, 3189, 3187, 3184, 3182, 3179, 3177, 3175, 3172, 3170, 3167, 3165, 3163, 3160,
+	3158, 3155, 3153, 3151, 3148, 3146, 3144, 3141, 3139, 3137, 3134, 3132, 3130, 3127, 3125, 3123,
+	3120, 3118, 3116, 3113, 3111, 3109, 3106, 3104, 3102, 3100, 3097, 3095, 3093, 3090, 3088, 3086,
+	3084, 3081, 3079, 3077, 3075, 3072, 3070, 3068, 3066, 3063, 3061, 3059, 3057, 3054, 3052, 3050,
+	3048, 3045, 3043, 3041, 3039, 3037, 3034, 3032, 3030, 3028, 3026, 3024, 3021, 3019, 3017, 3015,
+	3013, 3010, 3008, 3006, 3004, 3002, 3000, 2998, 2995, 2993, 2991, 2989, 2987, 2985, 2983, 2981,
+	2978, 2976, 2974, 2972, 2970, 2968, 2966, 2964, 2962, 2959, 2957, 2955, 2953, 2951, 2949, 2947,
+	2945, 2943, 2941, 2939, 2937, 2935, 2933, 2931, 2928, 2926, 2924, 2922, 2920, 2918, 2916, 2914,
+	2912, 2910, 2908, 2906, 2904, 2902, 2900, 2898, 2896, 2894, 2892, 2890, 2888, 2886, 2884, 2882,
+	2880, 2878, 2876, 2874, 2872, 2870, 2868, 2866, 2864, 2863, 2861, 2859, 2857, 2855, 2853, 2851,
+	2849, 2847, 2845, 2843, 2841, 2839, 2837, 2835, 2833, 2832, 2830, 2828, 2826, 2824, 2822, 2820,
+	2818, 2816, 2814, 2813, 2811, 2809, 2807, 2805, 2803, 2801, 2799, 2798, 2796, 2794, 2792, 2790,
+	2788, 2786, 2785, 2783, 2781, 2779, 2777, 2775, 2774, 2772, 2770, 2768, 2766, 2764, 2763, 2761,
+	2759, 2757, 2755, 2753, 2752, 2750, 2748, 2746, 2744, 2743, 2741, 2739, 2737, 2736, 2734, 2732,
+	2730, 2728, 2727, 2725, 2723, 2721, 2720, 2718, 2716, 2714, 2713, 2711, 2709, 2707, 2706, 2704,
+	2702, 2700, 2699, 2697, 2695, 2693, 2692, 2690, 2688, 2686, 2685, 2683, 2681, 2680, 2678, 2676,
+	2674, 2673, 2671, 2669, 2668, 2666, 2664, 2663, 2661, 2659, 2657, 2656, 2654, 2652, 2651, 2649,
+	2647, 2646, 2644, 2642, 2641, 2639, 2637, 2636, 2634, 2632, 2631, 2629, 2628, 2626, 2624, 2623,
+	2621, 2619, 2618, 2616, 2614, 2613, 2611, 2610, 2608, 2606, 2605, 2603, 2601, 2600, 2598, 2597,
+	2595, 2593, 2592, 2590, 2589, 2587, 2585, 2584, 2582, 2581, 2579, 2577, 2576, 2574, 2573, 2571,
+	2570, 2568, 2566, 2565, 2563, 2562, 2560, 2559, 2557, 2555, 2554, 2552, 2551, 2549, 2548, 2546,
+	2545, 2543, 2542, 2540, 2538, 2537, 2535, 2534, 2532, 2531, 2529, 2528, 2526, 2525, 2523, 2522,
+	2520, 2519, 2517, 2516, 2514, 2513, 2511, 2510, 2508, 2507, 2505, 2504, 2502, 2501, 2499, 2498,
+	2496, 2495, 2493, 2492, 2490, 2489, 2487, 2486, 2484, 2483, 2481, 2480, 2478, 2477, 2475, 2474,
+	2473, 2471, 2470, 2468, 2467, 2465, 2464, 2462, 2461, 2460, 2458, 2457, 2455, 2454, 2452, 2451,
+	2449, 2448, 2447, 2445, 2444, 2442, 2441, 2439, 2438, 2437, 2435, 2434, 2432, 2431, 2430, 2428,
+	2427, 2425, 2424, 2423, 2421, 2420, 2418, 2417, 2416, 2414, 2413, 2411, 2410, 2409, 2407, 2406,
+	2404, 2403, 2402, 2400, 2399, 2398, 2396, 2395, 2394, 2392, 2391, 2389, 2388, 2387, 2385, 2384,
+	2383, 2381, 2380, 2379, 2377, 2376, 2375, 2373, 2372, 2371, 2369, 2368, 2366, 2365, 2364, 2362,
+	2361, 2360, 2359, 2357, 2356, 2355, 2353, 2352, 2351, 2349, 2348, 2347, 2345, 2344, 2343, 2341,
+	2340, 2339, 2337, 2336, 2335, 2334, 2332, 2331, 2330, 2328, 2327, 2326, 2325, 2323, 2322, 2321,
+	2319, 2318, 2317, 2316, 2314, 2313, 2312, 2310, 2309, 2308, 2307, 2305, 2304, 2303, 2302, 2300,
+	2299, 2298, 2296, 2295, 2294, 2293, 2291, 2290, 2289, 2288, 2286, 2285, 2284, 2283, 2281, 2280,
+	2279, 2278, 2277, 2275, 2274, 2273, 2272, 2270, 2269, 2268, 2267, 2265, 2264, 2263, 2262, 2261,
+	2259, 2258, 2257, 2256, 2255, 2253, 2252, 2251, 2250, 2248, 2247, 2246, 2245, 2244, 2242, 2241,
+	2240, 2239, 2238, 2236, 2235, 2234, 2233, 2232, 2231, 2229, 2228, 2227, 2226, 2225, 2223, 2222,
+	2221, 2220, 2219, 2218, 2216, 2215, 2214, 2213, 2212, 2211, 2209, 2208, 2207, 2206, 2205, 2204,
+	2202, 2201, 2200, 2199, 2198, 2197, 2195, 2194, 2193, 2192, 2191, 2190, 2189, 2187, 2186, 2185,
+	2184, 2183, 2182, 2181, 2179, 2178, 2177, 2176, 2175, 2174, 2173, 2172, 2170, 2169, 2168, 2167,
+	2166, 2165, 2164, 2163, 2162, 2160, 2159, 2158, 2157, 2156, 2155, 2154, 2153, 2152, 2150, 2149,
+	2148, 2147, 2146, 2145, 2144, 2143, 2142, 2141, 2139, 2138, 2137, 2136, 2135, 2134, 2133, 2132,
+	2131, 2130, 2129, 2128, 2126, 2125, 2124, 2123, 2122, 2121, 2120, 2119, 2118, 2117, 2116, 2115,
+	2114, 2112, 2111, 2110, 2109, 2108, 2107, 2106, 2105, 2104, 2103, 2102, 2101, 2100, 2099, 2098,
+	2097, 2096, 2095, 2094, 2092, 2091, 2090, 2089, 2088, 2087, 2086, 2085, 2084, 2083, 2082, 2081,
+	2080, 2079, 2078, 2077, 2076, 2075, 2074, 2073, 2072, 2071, 2070, 2069, 2068, 2067, 2066, 2065,
+	2064, 2063, 2062, 2061, 2060, 2059, 2058, 2057, 2056, 2055, 2054, 2053, 2052, 2051, 2050, 2049,
+};
+
+//
+// Outcomes of dividing operands by their classes, indexed as [dividend][divisor]:
+//
+static const unsigned char sbfpDivOutcomes[SBFP_CLASS_COUNT][SBFP_CLASS_COUNT] =
+{
+	//  zero                  subnormal             normal                inf                    NaN
+	{ SBFP_OUTCOME_NAN,     SBFP_OUTCOME_FINITE,  SBFP_OUTCOME_FINITE,  SBFP_OUTCOME_ZERO_XOR, SBFP_OUTCOME_NAN }, // zero
+	{ SBFP_OUTCOME_INF_XOR, SBFP_OUTCOME_FINITE,  SBFP_OUTCOME_FINITE,  SBFP_OUTCOME_ZERO_XOR, SBFP_OUTCOME_NAN }, // subnormal
+	{ SBFP_OUTCOME_INF_XOR, SBFP_OUTCOME_FINITE,  SBFP_OUTCOME_FINITE,  SBFP_OUTCOME_ZERO_XOR, SBFP_OUTCOME_NAN }, // normal
+	{ SBFP_OUTCOME_INF_XOR, SBFP_OUTCOME_INF_XOR, SBFP_OUTCOME_INF_XOR, SBFP_OUTCOME_NAN,      SBFP_OUTCOME_NAN }, // inf
+	{ SBFP_OUTCOME_NAN,     SBFP_OUTCOME_NAN,     SBFP_OUTCOME_NAN,     SBFP_OUTCOME_NAN,      SBFP_OUTCOME_NAN }, // NaN
+};
+
+//
+// Divides two sbfp values.
+//
+// Both significands are normalized to 11 bits, and the dividend's is scaled by 2^11, so the
+// integer quotient has at least 11 significant bits. It is estimated with the divisor's
+// reciprocal from sbfpRecipTable, which is never more than 1 below the exact integer
+// quotient, and corrected with the remainder. When truncating, the truncated quotient then
+// truncates like the exact one would. In the other modes, the remainder adds a bit for
+// half the divisor and a sticky bit below it, so that the quotient rounds like
+// double_to_sbfp_round would round the exact quotient.
+//
+// [in] sbfpValue1 - the dividend
+// [in] sbfpValue2 - the divisor
+// [in] mode       - the rounding mode (see SBFP_ROUND_NEAREST_EVEN)
+//
+// Returns the quotient.
+//
+static inline sbfp_t divide(sbfp_t sbfpValue1, sbfp_t sbfpValue2, int mode)
+{
+	int status = 0;
+
+	int bitsQuotient = 0;
+
+	//
+	// Extract the frac, expo and sign of both sbfp values:
+	//
+	int bits1 = sbfpValue1 & SBFP_BIT_MASK;
+	int bits2 = sbfpValue2 & SBFP_BIT_MASK;
+
+	int sbfpFrac1 = bits1 & SBFP_FRAC_MASK;
+	int sbfpExpo1 = (bits1 >> SBFP_BIT_COUNT_FRAC) & SBFP_EXPO_MASK;
+	int sbfpSign1 = bits1 >> (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC);
+
+	int sbfpFrac2 = bits2 & SBFP_FRAC_MASK;
+	int sbfpExpo2 = (bits2 >> SBFP_BIT_COUNT_FRAC) & SBFP_EXPO_MASK;
+	int sbfpSign2 = bits2 >> (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC);
+
+	//
+	// Handle if the sbfp values are infinity or NaN, or the divisor is zero:
+	//
+	if (status == 0)
+	{
+		if (sbfp_core_is_special(bits1) | sbfp_core_is_special(bits2) | ((sbfpExpo2 | sbfpFrac2) == 0))
+		{
+			int special1 = sbfp_core_to_binary16(sbfpValue1);
+			int special2 = sbfp_core_to_binary16(sbfpValue2);
+
+			bitsQuotient = sbfp_core_handle_special(sbfpDivOutcomes[sbfp_core_classify_binary16(special1)][sbfp_core_classify_binary16(special2)], special1, special2);
+
+			status = 1;
+		}
+	}
+
+	//
+	// Normalize the significands (with the implicit bit for normals), divide them, subtract
+	// the expos, and return:
+	//
+	if (status == 0)
+	{
+		const int recipShift = 2 * (SBFP_BIT_COUNT_FRAC + 1); // the scale of sbfpRecipTable
+
+		uint32_t M1 = (uint32_t)sbfpFrac1 | ((uint32_t)(sbfpExpo1 != 0) << SBFP_BIT_COUNT_FRAC);
+		uint32_t M2 = (uint32_t)sbfpFrac2 | ((uint32_t)(sbfpExpo2 != 0) << SBFP_BIT_COUNT_FRAC);
+
+		int shift1 = sbfp_core_count_leading_zeros((uint64_t)M1 | 1) - (63 - SBFP_BIT_COUNT_FRAC); // a zero dividend stays zero
+		int shift2 = sbfp_core_count_leading_zeros((uint64_t)M2) - (63 - SBFP_BIT_COUNT_FRAC);
+
+		int E1 = sbfpExpo1 + (sbfpExpo1 == 0) - SBFP_BIAS - SBFP_BIT_COUNT_FRAC - shift1;
+		int E2 = sbfpExpo2 + (sbfpExpo2 == 0) - SBFP_BIAS - SBFP_BIT_COUNT_FRAC - shift2;
+
+		M2 <<= shift2;
+
+		//
+		// The dividend is below 2^recipShift, so the estimate is the exact integer quotient
+		// or 1 below it:
+		//
+		uint64_t N = (uint64_t)(M1 << shift1) << (SBFP_BIT_COUNT_FRAC + 1);
+		uint64_t Q = (N * sbfpRecipTable[M2 & SBFP_FRAC_MASK]) >> recipShift;
+
+		Q += (N - Q * M2 >= M2);
+
+		int E = E1 - E2 - (SBFP_BIT_COUNT_FRAC + 1);
+
+		if (!sbfp_core_round_truncates(mode))
+		{
+			uint64_t R      = N - Q * M2;
+			uint64_t isHalf = (2 * R >= M2);
+
+			Q = (Q << 2) | (isHalf << 1) | (uint64_t)(2 * R - isHalf * M2 != 0);
+			E -= 2;
+		}
+
+		bitsQuotient = sbfp_core_pack_binary16_round(sbfpSign1 ^ sbfpSign2, Q, E, mode, 0);
+	}
+
+	return sbfp_core_from_binary16(bitsQuotient);
+}
+
+//
+// Divides two sbfp values. The result is the exact quotient rounded like double_to_sbfp
+// would round it.
+//
+// [in] sbfpValue1 - the dividend
+// [in] sbfpValue2 - the divisor
+//
+// Returns the quotient.
+//
+sbfp_t sbfp_div(sbfp_t sbfpValue1, sbfp_t sbfpValue2)
+{
+	return divide(sbfpValue1, sbfpValue2, SBFP_ROUND_NEAREST_EVEN);
+}
+
+//
+// Divides arrays of sbfp values elementwise (see sbfp_div). A stride of 0 repeats the same
+// value for every element.
+//
+// [in]  sbfpValues1  - the dividends
+// [in]  sbfpStride1  - the distance, in elements, between consecutive dividends (1 if contiguous)
+// [in]  sbfpValues2  - the divisors
+// [in]  sbfpStride2  - the distance, in elements, between consecutive divisors (1 if contiguous)
+// [out] sbfpResults  - the quotients (may be the same array as either operand)
+// [in]  resultStride - the distance, in elements, between consecutive quotients (1 if contiguous)
+// [in]  count        - the number of elements
+//
+void sbfp_div_n(const sbfp_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp_t *sbfpResults, ptrdiff_t resultStride, size_t count)
+{
+	if (sbfpStride1 == 1 && sbfpStride2 == 1 && resultStride == 1)
+	{
+		for (size_t index = 0; index < count; ++index)
+		{
+			sbfpResults[index] = divide(sbfpValues1[index], sbfpValues2[index], SBFP_ROUND_NEAREST_EVEN);
+		}
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+		{
+			sbfpResults[index * resultStride] = divide(sbfpValues1[index * sbfpStride1], sbfpValues2[index * sbfpStride2], SBFP_ROUND_NEAREST_EVEN);
+		}
+	}
+}
+
+//
+// Divides arrays of sbfp16_t values elementwise (see sbfp_div_n).
+//
+// [in]  sbfpValues1  - the dividends
+// [in]  sbfpStride1  - the distance, in elements, between consecutive dividends (1 if contiguous)
+// [in]  sbfpValues2  - the divisors
+// [in]  sbfpStride2  - the distance, in elements, between consecutive divisors (1 if contiguous)
+// [out] sbfpResults  - the quotients (may be the same array as either operand)
+// [in]  resultStride - the distance, in elements, between consecutive quotients (1 if contiguous)
+// [in]  count        - the number of elements
+//
+void sbfp16_div_n(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp16_t *sbfpResults, ptrdiff_t resultStride, size_t count)
+{
+	if (sbfpStride1 == 1 && sbfpStride2 == 1 && resultStride == 1)
+	{
+		for (size_t index = 0; index < count; ++index)
+		{
+			sbfpResults[index] = (sbfp16_t)divide(sbfpValues1[index], sbfpValues2[index], SBFP_ROUND_NEAREST_EVEN);
+		}
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+		{
+			sbfpResults[index * resultStride] = (sbfp16_t)divide(sbfpValues1[index * sbfpStride1], sbfpValues2[index * sbfpStride2], SBFP_ROUND_NEAREST_EVEN);
+		}
+	}
+}
+
+//
+// Storage class of variables of which each thread has its own copy:
+//
+#if defined(_MSC_VER)
+#define SBFP_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__)
+#define SBFP_THREAD_LOCAL __thread
+#else
+#define SBFP_THREAD_LOCAL _Thread_local
+#endif
+
+//
+// The rounding mode of each thread, which the functions given SBFP_ROUND_DYNAMIC round in.
+// Every thread starts out rounding to nearest even.
+//
+static SBFP_THREAD_LOCAL int sbfpRounding = SBFP_ROUND_NEAREST_EVEN;
+
+//
+// The random sequence of each thread for stochastic rounding: its seed, whether it has one,
+// and the position of the next random bits in it. A thread that rounds stochastically
+// without calling sbfp_seed_stochastic gets the next seed of sbfpStochasticStreams first.
+//
+static SBFP_THREAD_LOCAL uint64_t sbfpStochasticSeed    = 0;
+static SBFP_THREAD_LOCAL bool     sbfpStochasticSeeded  = false;
+static SBFP_THREAD_LOCAL uint64_t sbfpStochasticCounter = 0;
+
+//
+// The number of threads that have taken a default seed, each of which mixes its number
+// into a seed of its own (see claim_stochastic), so threads never share a sequence.
+//
+static atomic_uint_least64_t sbfpStochasticStreams = 0;
+
+//
+// Sets the rounding mode of the calling thread, which the functions with a _round suffix
+// use when given SBFP_ROUND_DYNAMIC. Other threads keep their own modes.
+//
+// [in] mode - the rounding mode (SBFP_ROUND_NEAREST_EVEN, SBFP_ROUND_TOWARD_ZERO,
+//             SBFP_ROUND_UPWARD, SBFP_ROUND_DOWNWARD or SBFP_ROUND_TRUNCATE)
+//
+// Returns 0 on success, or -1 if the mode is unknown.
+//
+int sbfp_set_rounding(int mode)
+{
+	int status = 0;
+
+	if (status == 0)
+	{
+		if (sbfp_core_check_rounding(mode) != mode)
+		{
+			status = -1;
+		}
+	}
+
+	if (status == 0)
+	{
+		sbfpRounding = mode;
+	}
+
+	return status;
+}
+
+//
+// Gives the rounding mode of the calling thread (see sbfp_set_rounding).
+//
+// Returns the rounding mode.
+//
+int sbfp_get_rounding(void)
+{
+	return sbfpRounding;
+}
+
+//
+// Resolves a rounding mode given to a function, replacing SBFP_ROUND_DYNAMIC with the
+// calling thread's mode and an unknown mode with rounding to nearest even (see
+// sbfp_core_check_rounding).
+//
+// [in] mode - the rounding mode given
+//
+// Returns the rounding mode to round in.
+//
+static inline int resolve_rounding(int mode)
+{
+	return sbfp_core_check_rounding((mode == SBFP_ROUND_DYNAMIC) ? sbfpRounding : mode);
+}
+
+//
+// Gives the random bits at a given position in the sequence of a given seed: the output of
+// SplitMix64 seeded with it, after as many steps. Each output is computed from its position
+// alone rather than from the one before it, so loops over this function can be vectorized
+// and every element of an array gets the same bits as it would one at a time.
+//
+// [in] seed    - the seed of the sequence
+// [in] counter - the position in the sequence
+//
+// Returns 64 uniformly random bits.
+//
+static inline uint64_t stochastic_bits(uint64_t seed, uint64_t counter)
+{
+	uint64_t bits = seed + (counter + 1) * 0x9E3779B97F4A7C15ULL;
+
+	bits = (bits ^ (bits >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	bits = (bits ^ (bits >> 27)) * 0x94D049BB133111EBULL;
+
+	return bits ^ (bits >> 31);
+}
+
+//
+// Claims positions in the calling thread's random sequence for stochastic rounding, so the
+// next call starts after them. A thread without a seed first takes the next number of
+// sbfpStochasticStreams, mixed like the random bits into a seed that no other thread has.
+//
+// [in]  count - the number of positions
+// [out] seed  - the seed of the sequence
+//
+// Returns the first position claimed.
+//
+static inline uint64_t claim_stochastic(size_t count, uint64_t *seed)
+{
+	if (!sbfpStochasticSeeded)
+	{
+		sbfpStochasticSeed   = stochastic_bits(0, atomic_fetch_add(&sbfpStochasticStreams, 1));
+		sbfpStochasticSeeded = true;
+	}
+
+	uint64_t counter = sbfpStochasticCounter;
+
+	sbfpStochasticCounter = counter + count;
+
+	*seed = sbfpStochasticSeed;
+
+	return counter;
+}
+
+//
+// Converts a given double value to the sbfp_t type, rounding it in a given mode. With
+// SBFP_ROUND_TOWARD_ZERO, the result is the same as double_to_sbfp's, except that it
+// saturates if SBFP_SATURATE_TOWARD_ZERO. Magnitudes that round to 2^16 or above become
+// infinity, or the largest finite value when rounded toward zero from their side (see
+// sbfp_core_round_saturates), and NaN becomes SBFP_NAN.
+//
+// [in] mode     - the rounding mode (see sbfp_set_rounding), or SBFP_ROUND_DYNAMIC for
+//                 the calling thread's mode
+// [in] dblValue - the double value to be converted
+//
+// Returns the converted value.
+//
+sbfp_t double_to_sbfp_round(int mode, double dblValue)
+{
+	return sbfp_core_encode_double_round(dblValue, resolve_rounding(mode), 0);
+}
+
+//
+// Converts a given float value to the sbfp_t type, rounding it in a given mode (see
+// double_to_sbfp_round).
+//
+// [in] mode     - the rounding mode (see sbfp_set_rounding), or SBFP_ROUND_DYNAMIC for
+//                 the calling thread's mode
+// [in] fltValue - the float value to be converted
+//
+// Returns the converted value.
+//
+sbfp_t float_to_sbfp_round(int mode, float fltValue)
+{
+	return sbfp_core_encode_float_round(fltValue, resolve_rounding(mode), 0);
+}
+
+//
+// Multiplies two sbfp values, rounding the exact product in a given mode.
+//
+// [in] mode       - the rounding mode (see sbfp_set_rounding), or SBFP_ROUND_DYNAMIC for
+//                   the calling thread's mode
+// [in] sbfpValue1 - the multiplicand
+// [in] sbfpValue2 - the multiplier
+//
+// Returns the product.
+//
+sbfp_t sbfp_mul_round(int mode, sbfp_t sbfpValue1, sbfp_t sbfpValue2)
+{
+	return sbfp_core_multiply_round(sbfpValue1, sbfpValue2, resolve_rounding(mode), 0);
+}
+
+//
+// Adds two sbfp values, rounding the exact sum in a given mode. An exact zero sum of
+// values with opposite signs is -0 when rounding downward (with SBFP_SIGNED_ZERO).
+//
+// [in] mode       - the rounding mode (see sbfp_set_rounding), or SBFP_ROUND_DYNAMIC for
+//                   the calling thread's mode
+// [in] sbfpValue1 - the augend
+// [in] sbfpValue2 - the addend
+//
+// Returns the sum.
+//
+sbfp_t sbfp_add_round(int mode, sbfp_t sbfpValue1, sbfp_t sbfpValue2)
+{
+	return sbfp_core_add_round(sbfpValue1, sbfpValue2, 0, resolve_rounding(mode), 0);
+}
+
+//
+// Subtracts one sbfp value from another, rounding the exact difference in a given mode
+// (see sbfp_add_round).
+//
+// [in] mode       - the rounding mode (see sbfp_set_rounding), or SBFP_ROUND_DYNAMIC for
+//                   the calling thread's mode
+// [in] sbfpValue1 - the minuend
+// [in] sbfpValue2 - the subtrahend
+//
+// Returns the difference.
+//
+sbfp_t sbfp_sub_round(int mode, sbfp_t sbfpValue1, sbfp_t sbfpValue2)
+{
+	return sbfp_core_add_round(sbfpValue1, sbfpValue2, 1, resolve_rounding(mode), 0);
+}
+
+//
+// Multiplies two sbfp values and adds a third, rounding the exact result once in a given
+// mode (see sbfp_fma).
+//
+// [in] mode       - the rounding mode (see sbfp_set_rounding), or SBFP_ROUND_DYNAMIC for
+//                   the calling thread's mode
+// [in] sbfpValue1 - the multiplicand
+// [in] sbfpValue2 - the multiplier
+// [in] sbfpValue3 - the addend
+//
+// Returns the result.
+//
+sbfp_t sbfp_fma_round(int mode, sbfp_t sbfpValue1, sbfp_t sbfpValue2, sbfp_t sbfpValue3)
+{
+	return multiply_add(sbfpValue1, sbfpValue2, sbfpValue3, resolve_rounding(mode));
+}
+
+//
+// Divides two sbfp values, rounding the exact quotient in a given mode.
+//
+// [in] mode       - the rounding mode (see sbfp_set_rounding), or SBFP_ROUND_DYNAMIC for
+//                   the calling thread's mode
+// [in] sbfpValue1 - the dividend
+// [in] sbfpValue2 - the divisor
+//
+// Returns the quotient.
+//
+sbfp_t sbfp_div_round(int mode, sbfp_t sbfpValue1, sbfp_t sbfpValue2)
+{
+	return divide(sbfpValue1, sbfpValue2, resolve_rounding(mode));
+}
+
+//
+// Converts an array of double values to the sbfp_t type in one rounding mode (see
+// double_to_sbfp_round_n). The mode is a constant in every call, so each gets a loop for
+// that mode alone. With SBFP_ROUND_STOCHASTIC, the element at a given index takes the
+// random bits at the position counter + index in the sequence of the seed.
+//
+static inline void encode_doubles_round(const double *dblValues, ptrdiff_t dblStride, sbfp_t *sbfpValues,
+	ptrdiff_t sbfpStride, size_t count, int mode, uint64_t seed, uint64_t counter)
+{
+	if (dblStride == 1 && sbfpStride == 1)
+	{
+		for (size_t index = 0; index < count; ++index)
+		{
+			uint64_t random = (mode == SBFP_ROUND_STOCHASTIC) ? stochastic_bits(seed, counter + index) : 0;
+
+			sbfpValues[index] = sbfp_core_encode_double_round(dblValues[index], mode, random);
+		}
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+		{
+			uint64_t random = (mode == SBFP_ROUND_STOCHASTIC) ? stochastic_bits(seed, counter + (uint64_t)index) : 0;
+
+			sbfpValues[index * sbfpStride] = sbfp_core_encode_double_round(dblValues[index * dblStride], mode, random);
+		}
+	}
+}
+
+//
+// Converts an array of double values to the sbfp_t type, rounding them in a given mode (see
+// double_to_sbfp_round). Rounding to nearest even uses the same kernels as double_to_sbfp_n.
+//
+// [in]  mode       - the rounding mode (see sbfp_set_rounding), or SBFP_ROUND_DYNAMIC for
+//                    the calling thread's mode
+// [in]  dblValues  - the double values to be converted
+// [in]  dblStride  - the distance, in elements, between consecutive double values (1 if contiguous)
+// [out] sbfpValues - the converted values
+// [in]  sbfpStride - the distance, in elements, between consecutive converted values (1 if contiguous)
+// [in]  count      - the number of values
+//
+void double_to_sbfp_round_n(int mode, const double *dblValues, ptrdiff_t dblStride, sbfp_t *sbfpValues,
+	ptrdiff_t sbfpStride, size_t count)
+{
+	mode = resolve_rounding(mode);
+
+	if (mode == SBFP_ROUND_UPWARD)
+	{
+		encode_doubles_round(dblValues, dblStride, sbfpValues, sbfpStride, count, SBFP_ROUND_UPWARD, 0, 0);
+	}
+	else if (mode == SBFP_ROUND_DOWNWARD)
+	{
+		encode_doubles_round(dblValues, dblStride, sbfpValues, sbfpStride, count, SBFP_ROUND_DOWNWARD, 0, 0);
+	}
+	else if (SBFP_SATURATE_TOWARD_ZERO && mode == SBFP_ROUND_TOWARD_ZERO)
+	{
+		encode_doubles_round(dblValues, dblStride, sbfpValues, sbfpStride, count, SBFP_ROUND_TOWARD_ZERO, 0, 0);
+	}
+	else if (mode != SBFP_ROUND_NEAREST_EVEN)
+	{
+		encode_doubles_round(dblValues, dblStride, sbfpValues, sbfpStride, count, SBFP_ROUND_TRUNCATE, 0, 0);
+	}
+	else
+	{
+		double_to_sbfp_n(dblValues, dblStride, sbfpValues, sbfpStride, count);
+	}
+}
+
+//
+// Converts an array of float values to the sbfp_t type in one rounding mode (see
+// encode_doubles_round).
+//
+static inline void encode_floats_round(const float *fltValues, ptrdiff_t fltStride, sbfp_t *sbfpValues,
+	ptrdiff_t sbfpStride, size_t count, int mode, uint64_t seed, uint64_t counter)
+{
+	if (fltStride == 1 && sbfpStride == 1)
+	{
+		for (size_t index = 0; index < count; ++index)
+		{
+			uint64_t random = (mode == SBFP_ROUND_STOCHASTIC) ? stochastic_bits(seed, counter + index) : 0;
+
+			sbfpValues[index] = sbfp_core_encode_float_round(fltValues[index], mode, random);
+		}
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+		{
+			uint64_t random = (mode == SBFP_ROUND_STOCHASTIC) ? stochastic_bits(seed, counter + (uint64_t)index) : 0;
+
+			sbfpValues[index * sbfpStride] = sbfp_core_encode_float_round(fltValues[index * fltStride], mode, random);
+		}
+	}
+}
+
+//
+// Converts an array of float values to the sbfp_t type, rounding them in a given mode (see
+// float_to_sbfp_round). Rounding to nearest even uses the same kernels as float_to_sbfp_n.
+//
+// [in]  mode       - the rounding mode (see sbfp_set_rounding), or SBFP_ROUND_DYNAMIC for
+//                    the calling thread's mode
+// [in]  fltValues  - the float values to be converted
+// [in]  fltStride  - the distance, in elements, between consecutive float values (1 if contiguous)
+// [out] sbfpValues - the converted values
+// [in]  sbfpStride - the distance, in elements, between consecutive converted values (1 if contiguous)
+// [in]  count      - the number of values
+//
+void float_to_sbfp_round_n(int mode, const float *fltValues, ptrdiff_t fltStride, sbfp_t *sbfpValues,
+	ptrdiff_t sbfpStride, size_t count)
+{
+	mode = resolve_rounding(mode);
+
+	if (mode == SBFP_ROUND_UPWARD)
+	{
+		encode_floats_round(fltValues, fltStride, sbfpValues, sbfpStride, count, SBFP_ROUND_UPWARD, 0, 0);
+	}
+	else if (mode == SBFP_ROUND_DOWNWARD)
+	{
+		encode_floats_round(fltValues, fltStride, sbfpValues, sbfpStride, count, SBFP_ROUND_DOWNWARD, 0, 0);
+	}
+	else if (SBFP_SATURATE_TOWARD_ZERO && mode == SBFP_ROUND_TOWARD_ZERO)
+	{
+		encode_floats_round(fltValues, fltStride, sbfpValues, sbfpStride, count, SBFP_ROUND_TOWARD_ZERO, 0, 0);
+	}
+	else if (mode != SBFP_ROUND_NEAREST_EVEN)
+	{
+		encode_floats_round(fltValues, fltStride, sbfpValues, sbfpStride, count, SBFP_ROUND_TRUNCATE, 0, 0);
+	}
+	else
+	{
+		float_to_sbfp_n(fltValues, fltStride, sbfpValues, sbfpStride, count);
+	}
+}
+
+//
+// Applies an operation to arrays of sbfp values elementwise in one rounding mode (see
+// sbfp_add_round_n). The operation and mode are constants in every call, so each gets a
+// loop for that operation and mode alone.
+//
+// [in]  sbfpValues1  - the first operands
+// [in]  sbfpStride1  - the distance, in elements, between consecutive first operands (1 if contiguous)
+// [in]  sbfpValues2  - the second operands
+// [in]  sbfpStride2  - the distance, in elements, between consecutive second operands (1 if contiguous)
+// [out] sbfpResults  - the results (may be the same array as either operand)
+// [in]  resultStride - the distance, in elements, between consecutive results (1 if contiguous)
+// [in]  count        - the number of elements
+// [in]  operation    - SBFP_OPERATION_ADD, SBFP_OPERATION_SUB or SBFP_OPERATION_MUL
+// [in]  mode         - the rounding mode
+// [in]  seed         - the seed of the random sequence (for SBFP_ROUND_STOCHASTIC)
+// [in]  counter      - the position of the first element's random bits in the sequence
+//
+static inline void operate_round(const sbfp_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp_t *sbfpValues2,
+	ptrdiff_t sbfpStride2, sbfp_t *sbfpResults, ptrdiff_t resultStride, size_t count, int operation, int mode,
+	uint64_t seed, uint64_t counter)
+{
+	for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+	{
+		sbfp_t sbfpValue1 = sbfpValues1[index * sbfpStride1];
+		sbfp_t sbfpValue2 = sbfpValues2[index * sbfpStride2];
+
+		uint64_t random = (mode == SBFP_ROUND_STOCHASTIC) ? stochastic_bits(seed, counter + (uint64_t)index) : 0;
+
+		sbfpResults[index * resultStride] = (operation == SBFP_OPERATION_MUL) ?
+			sbfp_core_multiply_round(sbfpValue1, sbfpValue2, mode, random) :
+			sbfp_core_add_round(sbfpValue1, sbfpValue2, operation == SBFP_OPERATION_SUB, mode, random);
+	}
+}
+
+//
+// Applies an operation to arrays of sbfp values elementwise, rounding in a given mode.
+// Rounding to nearest even uses the bulk function of the operation, with its kernels.
+//
+static inline void operate_round_n(int mode, const sbfp_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp_t *sbfpValues2,
+	ptrdiff_t sbfpStride2, sbfp_t *sbfpResults, ptrdiff_t resultStride, size_t count, int operation)
+{
+	mode = resolve_rounding(mode);
+
+	if (mode == SBFP_ROUND_UPWARD)
+	{
+		operate_round(sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, resultStride, count, operation, SBFP_ROUND_UPWARD, 0, 0);
+	}
+	else if (mode == SBFP_ROUND_DOWNWARD)
+	{
+		operate_round(sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, resultStride, count, operation, SBFP_ROUND_DOWNWARD, 0, 0);
+	}
+	else if (SBFP_SATURATE_TOWARD_ZERO && mode == SBFP_ROUND_TOWARD_ZERO)
+	{
+		operate_round(sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, resultStride, count, operation, SBFP_ROUND_TOWARD_ZERO, 0, 0);
+	}
+	else if (mode != SBFP_ROUND_NEAREST_EVEN)
+	{
+		operate_round(sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, resultStride, count, operation, SBFP_ROUND_TRUNCATE, 0, 0);
+	}
+	else if (operation == SBFP_OPERATION_MUL)
+	{
+		sbfp_mul_n(sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, resultStride, count);
+	}
+	else if (operation == SBFP_OPERATION_SUB)
+	{
+		sbfp_sub_n(sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, resultStride, count);
+	}
+	else
+	{
+		sbfp_add_n(sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, resultStride, count);
+	}
+}
+
+//
+// Multiplies arrays of sbfp values elementwise, rounding in a given mode (see
+// sbfp_mul_round and sbfp_mul_n).
+//
+// [in]  mode         - the rounding mode (see sbfp_set_rounding), or SBFP_ROUND_DYNAMIC for
+//                      the calling thread's mode
+// [in]  sbfpValues1  - the multiplicands
+// [in]  sbfpStride1  - the distance, in elements, between consecutive multiplicands (1 if contiguous)
+// [in]  sbfpValues2  - the multipliers
+// [in]  sbfpStride2  - the distance, in elements, between consecutive multipliers (1 if contiguous)
+// [out] sbfpResults  - the products (may be the same array as either operand)
+// [in]  resultStride - the distance, in elements, between consecutive products (1 if contiguous)
+// [in]  count        - the number of elements
+//
+void sbfp_mul_round_n(int mode, const sbfp_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp_t *sbfpValues2,
+	ptrdiff_t sbfpStride2, sbfp_t *sbfpResults, ptrdiff_t resultStride, size_t count)
+{
+	operate_round_n(mode, sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, resultStride, count, SBFP_OPERATION_MUL);
+}
+
+//
+// Adds arrays of sbfp values elementwise, rounding in a given mode (see sbfp_add_round and
+// sbfp_add_n).
+//
+// [in]  mode         - the rounding mode (see sbfp_set_rounding), or SBFP_ROUND_DYNAMIC for
+//                      the calling thread's mode
+// [in]  sbfpValues1  - the augends
+// [in]  sbfpStride1  - the distance, in elements, between consecutive augends (1 if contiguous)
+// [in]  sbfpValues2  - the addends
+// [in]  sbfpStride2  - the distance, in elements, between consecutive addends (1 if contiguous)
+// [out] sbfpResults  - the sums (may be the same array as either operand)
+// [in]  resultStride - the distance, in elements, between consecutive sums (1 if contiguous)
+// [in]  count        - the number of elements
+//
+void sbfp_add_round_n(int mode, const sbfp_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp_t *sbfpValues2,
+	ptrdiff_t sbfpStride2, sbfp_t *sbfpResults, ptrdiff_t resultStride, size_t count)
+{
+	operate_round_n(mode, sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, resultStride, count, SBFP_OPERATION_ADD);
+}
+
+//
+// Subtracts arrays of sbfp values elementwise, rounding in a given mode (see sbfp_sub_round
+// and sbfp_sub_n).
+//
+// [in]  mode         - the rounding mode (see sbfp_set_rounding), or SBFP_ROUND_DYNAMIC for
+//                      the calling thread's mode
+// [in]  sbfpValues1  - the minuends
+// [in]  sbfpStride1  - the distance, in elements, between consecutive minuends (1 if contiguous)
+// [in]  sbfpValues2  - the subtrahends
+// [in]  sbfpStride2  - the distance, in elements, between consecutive subtrahends (1 if contiguous)
+// [out] sbfpResults  - the differences (may be the same array as either operand)
+// [in]  resultStride - the distance, in elements, between consecutive differences (1 if contiguous)
+// [in]  count        - the number of elements
+//
+void sbfp_sub_round_n(int mode, const sbfp_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp_t *sbfpValues2,
+	ptrdiff_t sbfpStride2, sbfp_t *sbfpResults, ptrdiff_t resultStride, size_t count)
+{
+	operate_round_n(mode, sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, resultStride, count, SBFP_OPERATION_SUB);
+}
+
+//
+// Applies an operation to arrays of sbfp16_t values elementwise in one rounding mode (see
+// operate_round).
+//
+static inline void operate16_round(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2,
+	ptrdiff_t sbfpStride2, sbfp16_t *sbfpResults, ptrdiff_t resultStride, size_t count, int operation, int mode)
+{
+	for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+	{
+		sbfp_t sbfpValue1 = sbfpValues1[index * sbfpStride1];
+		sbfp_t sbfpValue2 = sbfpValues2[index * sbfpStride2];
+
+		sbfpResults[index * resultStride] = (sbfp16_t)((operation == SBFP_OPERATION_MUL) ?
+			sbfp_core_multiply_round(sbfpValue1, sbfpValue2, mode, 0) :
+			sbfp_core_add_round(sbfpValue1, sbfpValue2, operation == SBFP_OPERATION_SUB, mode, 0));
+	}
+}
+
+//
+// Applies an operation to arrays of sbfp16_t values elementwise, rounding in a given mode
+// (see operate_round_n).
+//
+static inline void operate16_round_n(int mode, const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2,
+	ptrdiff_t sbfpStride2, sbfp16_t *sbfpResults, ptrdiff_t resultStride, size_t count, int operation)
+{
+	mode = resolve_rounding(mode);
+
+	if (mode == SBFP_ROUND_UPWARD)
+	{
+		operate16_round(sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, resultStride, count, operation, SBFP_ROUND_UPWARD);
+	}
+	else if (mode == SBFP_ROUND_DOWNWARD)
+	{
+		operate16_round(sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, resultStride, count, operation, SBFP_ROUND_DOWNWARD);
+	}
+	else if (SBFP_SATURATE_TOWARD_ZERO && mode == SBFP_ROUND_TOWARD_ZERO)
+	{
+		operate16_round(sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, resultStride, count, operation, SBFP_ROUND_TOWARD_ZERO);
+	}
+	else if (mode != SBFP_ROUND_NEAREST_EVEN)
+	{
+		operate16_round(sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, resultStride, count, operation, SBFP_ROUND_TRUNCATE);
+	}
+	else if (operation == SBFP_OPERATION_MUL)
+	{
+		sbfp16_mul_n(sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, resultStride, count);
+	}
+	else if (operation == SBFP_OPERATION_SUB)
+	{
+		sbfp16_sub_n(sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, resultStride, count);
+	}
+	else
+	{
+		sbfp16_add_n(sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, resultStride, count);
+	}
+}
+
+//
+// Multiplies arrays of sbfp16_t values elementwise, rounding in a given mode (see
+// sbfp_mul_round_n).
+//
+// [in]  mode         - the rounding mode (see sbfp_set_rounding), or SBFP_ROUND_DYNAMIC for
+//                      the calling thread's mode
+// [in]  sbfpValues1  - the multiplicands
+// [in]  sbfpStride1  - the distance, in elements, between consecutive multiplicands (1 if contiguous)
+// [in]  sbfpValues2  - the multipliers
+// [in]  sbfpStride2  - the distance, in elements, between consecutive multipliers (1 if contiguous)
+// [out] sbfpResults  - the products (may be the same array as either operand)
+// [in]  resultStride - the distance, in elements, between consecutive products (1 if contiguous)
+// [in]  count        - the number of elements
+//
+void sbfp16_mul_round_n(int mode, const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2,
+	ptrdiff_t sbfpStride2, sbfp16_t *sbfpResults, ptrdiff_t resultStride, size_t count)
+{
+	operate16_round_n(mode, sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, resultStride, count, SBFP_OPERATION_MUL);
+}
+
+//
+// Adds arrays of sbfp16_t values elementwise, rounding in a given mode (see
+// sbfp_add_round_n).
+//
+// [in]  mode         - the rounding mode (see sbfp_set_rounding), or SBFP_ROUND_DYNAMIC for
+//                      the calling thread's mode
+// [in]  sbfpValues1  - the augends
+// [in]  sbfpStride1  - the distance, in elements, between consecutive augends (1 if contiguous)
+// [in]  sbfpValues2  - the addends
+// [in]  sbfpStride2  - the distance, in elements, between consecutive addends (1 if contiguous)
+// [out] sbfpResults  - the sums (may be the same array as either operand)
+// [in]  resultStride - the distance, in elements, between consecutive sums (1 if contiguous)
+// [in]  count        - the number of elements
+//
+void sbfp16_add_round_n(int mode, const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2,
+	ptrdiff_t sbfpStride2, sbfp16_t *sbfpResults, ptrdiff_t resultStride, size_t count)
+{
+	operate16_round_n(mode, sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, resultStride, count, SBFP_OPERATION_ADD);
+}
+
+//
+// Subtracts arrays of sbfp16_t values elementwise, rounding in a given mode (see
+// sbfp_sub_round_n).
+//
+// [in]  mode         - the rounding mode (see sbfp_set_rounding), or SBFP_ROUND_DYNAMIC for
+//                      the calling thread's mode
+// [in]  sbfpValues1  - the minuends
+// [in]  sbfpStride1  - the distance, in elements, between consecutive minuends (1 if contiguous)
+// [in]  sbfpValues2  - the subtrahends
+// [in]  sbfpStride2  - the distance, in elements, between consecutive subtrahends (1 if contiguous)
+// [out] sbfpResults  - the differences (may be the same array as either operand)
+// [in]  resultStride - the distance, in elements, between consecutive differences (1 if contiguous)
+// [in]  count        - the number of elements
+//
+void sbfp16_sub_round_n(int mode, const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2,
+	ptrdiff_t sbfpStride2, sbfp16_t *sbfpResults, ptrdiff_t resultStride, size_t count)
+{
+	operate16_round_n(mode, sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, resultStride, count, SBFP_OPERATION_SUB);
+}
+
+//
+// Multiplies and adds arrays of sbfp values elementwise, rounding each exact result once
+// in a given mode (see sbfp_fma_round and sbfp_fma_n).
+//
+// [in]  mode         - the rounding mode (see sbfp_set_rounding), or SBFP_ROUND_DYNAMIC for
+//                      the calling thread's mode
+// [in]  sbfpValues1  - the multiplicands
+// [in]  sbfpStride1  - the distance, in elements, between consecutive multiplicands (1 if contiguous)
+// [in]  sbfpValues2  - the multipliers
+// [in]  sbfpStride2  - the distance, in elements, between consecutive multipliers (1 if contiguous)
+// [in]  sbfpValues3  - the addends
+// [in]  sbfpStride3  - the distance, in elements, between consecutive addends (1 if contiguous)
+// [out] sbfpResults  - the results (may be the same array as any operand)
+// [in]  resultStride - the distance, in elements, between consecutive results (1 if contiguous)
+// [in]  count        - the number of elements
+//
+void sbfp_fma_round_n(int mode, const sbfp_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp_t *sbfpValues2,
+	ptrdiff_t sbfpStride2, const sbfp_t *sbfpValues3, ptrdiff_t sbfpStride3, sbfp_t *sbfpResults,
+	ptrdiff_t resultStride, size_t count)
+{
+	mode = resolve_rounding(mode);
+
+	if (mode == SBFP_ROUND_NEAREST_EVEN)
+	{
+		sbfp_fma_n(sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpValues3, sbfpStride3, sbfpResults, resultStride, count);
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+		{
+			sbfpResults[index * resultStride] = multiply_add(sbfpValues1[index * sbfpStride1],
+				sbfpValues2[index * sbfpStride2], sbfpValues3[index * sbfpStride3], mode);
+		}
+	}
+}
+
+//
+// Divides arrays of sbfp values elementwise, rounding each exact quotient in a given mode
+// (see sbfp_div_round and sbfp_div_n).
+//
+// [in]  mode         - the rounding mode (see sbfp_set_rounding), or SBFP_ROUND_DYNAMIC for
+//                      the calling thread's mode
+// [in]  sbfpValues1  - the dividends
+// [in]  sbfpStride1  - the distance, in elements, between consecutive dividends (1 if contiguous)
+// [in]  sbfpValues2  - the divisors
+// [in]  sbfpStride2  - the distance, in elements, between consecutive divisors (1 if contiguous)
+// [out] sbfpResults  - the quotients (may be the same array as either operand)
+// [in]  resultStride - the distance, in elements, between consecutive quotients (1 if contiguous)
+// [in]  count        - the number of elements
+//
+void sbfp_div_round_n(int mode, const sbfp_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp_t *sbfpValues2,
+	ptrdiff_t sbfpStride2, sbfp_t *sbfpResults, ptrdiff_t resultStride, size_t count)
+{
+	mode = resolve_rounding(mode);
+
+	if (mode == SBFP_ROUND_NEAREST_EVEN)
+	{
+		sbfp_div_n(sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, resultStride, count);
+	}
+	else
+	{
+		for (ptrdiff_t index = 0; index < (ptrdiff_t)count; ++index)
+		{
+			sbfpResults[index * resultStride] = divide(sbfpValues1[index * sbfpStride1], sbfpValues2[index * sbfpStride2], mode);
+		}
+	}
+}
+
+//
+// Seeds the calling thread's random sequence for stochastic rounding, and restarts it.
+// The same seed gives the same results from the same calls in the same order, whether
+// values are rounded one at a time or as arrays. Other threads keep their own sequences.
+// A thread that is not seeded gets a seed of its own when it first rounds stochastically,
+// which depends on how many threads did so before it, so results that must be reproduced
+// across runs with several threads need each thread to be seeded.
+//
+// [in] seed - the seed
+//
+void sbfp_seed_stochastic(uint64_t seed)
+{
+	sbfpStochasticSeed    = seed;
+	sbfpStochasticSeeded  = true;
+	sbfpStochasticCounter = 0;
+}
+
+//
+// Converts a given double value to the sbfp_t type, rounding it stochastically: its
+// magnitude rounds up with a probability of the fraction of a unit of the last frac bit
+// that truncation would drop, so the expected result is the value itself. The random bits
+// come from the calling thread's sequence (see sbfp_seed_stochastic). Magnitudes that
+// round to 2^16 or above become infinity, and NaN becomes SBFP_NAN.
+//
+// [in] dblValue - the double value to be converted
+//
+// Returns the converted value.
+//
+sbfp_t double_to_sbfp_stochastic(double dblValue)
+{
+	uint64_t seed    = 0;
+	uint64_t counter = claim_stochastic(1, &seed);
+	uint64_t random  = stochastic_bits(seed, counter);
+
+	return sbfp_core_encode_double_round(dblValue, SBFP_ROUND_STOCHASTIC, random);
+}
+
+//
+// Converts a given float value to the sbfp_t type, rounding it stochastically (see
+// double_to_sbfp_stochastic).
+//
+// [in] fltValue - the float value to be converted
+//
+// Returns the converted value.
+//
+sbfp_t float_to_sbfp_stochastic(float fltValue)
+{
+	uint64_t seed    = 0;
+	uint64_t counter = claim_stochastic(1, &seed);
+	uint64_t random  = stochastic_bits(seed, counter);
 
-	sbfpSum = double_to_sbfp(sbfpDblSum);
+	return sbfp_core_encode_float_round(fltValue, SBFP_ROUND_STOCHASTIC, random);
+}
+
+//
+// Multiplies two sbfp values, rounding the exact product stochastically (see
+// double_to_sbfp_stochastic).
+//
+// [in] sbfpValue1 - the multiplicand
+// [in] sbfpValue2 - the multiplier
+//
+// Returns the product.
+//
+sbfp_t sbfp_mul_stochastic(sbfp_t sbfpValue1, sbfp_t sbfpValue2)
+{
+	uint64_t seed    = 0;
+	uint64_t counter = claim_stochastic(1, &seed);
+	uint64_t random  = stochastic_bits(seed, counter);
+
+	return sbfp_core_multiply_round(sbfpValue1, sbfpValue2, SBFP_ROUND_STOCHASTIC, random);
+}
+
+//
+// Adds two sbfp values, rounding the exact sum stochastically (see
+// double_to_sbfp_stochastic). Small addends thus change a sum in proportion to their size
+// on average, rather than not at all.
+//
+// [in] sbfpValue1 - the augend
+// [in] sbfpValue2 - the addend
+//
+// Returns the sum.
+//
+sbfp_t sbfp_add_stochastic(sbfp_t sbfpValue1, sbfp_t sbfpValue2)
+{
+	uint64_t seed    = 0;
+	uint64_t counter = claim_stochastic(1, &seed);
+	uint64_t random  = stochastic_bits(seed, counter);
+
+	return sbfp_core_add_round(sbfpValue1, sbfpValue2, 0, SBFP_ROUND_STOCHASTIC, random);
+}
+
+//
+// Subtracts one sbfp value from another, rounding the exact difference stochastically (see
+// double_to_sbfp_stochastic).
+//
+// [in] sbfpValue1 - the minuend
+// [in] sbfpValue2 - the subtrahend
+//
+// Returns the difference.
+//
+sbfp_t sbfp_sub_stochastic(sbfp_t sbfpValue1, sbfp_t sbfpValue2)
+{
+	uint64_t seed    = 0;
+	uint64_t counter = claim_stochastic(1, &seed);
+	uint64_t random  = stochastic_bits(seed, counter);
+
+	return sbfp_core_add_round(sbfpValue1, sbfpValue2, 1, SBFP_ROUND_STOCHASTIC, random);
+}
+
+//
+// Converts an array of double values to the sbfp_t type, rounding them stochastically (see
+// double_to_sbfp_stochastic). The results are the same as converting the values one at a
+// time, in order.
+//
+// [in]  dblValues  - the double values to be converted
+// [in]  dblStride  - the distance, in elements, between consecutive double values (1 if contiguous)
+// [out] sbfpValues - the converted values
+// [in]  sbfpStride - the distance, in elements, between consecutive converted values (1 if contiguous)
+// [in]  count      - the number of values
+//
+void double_to_sbfp_stochastic_n(const double *dblValues, ptrdiff_t dblStride, sbfp_t *sbfpValues,
+	ptrdiff_t sbfpStride, size_t count)
+{
+	uint64_t seed    = 0;
+	uint64_t counter = claim_stochastic(count, &seed);
+
+	encode_doubles_round(dblValues, dblStride, sbfpValues, sbfpStride, count, SBFP_ROUND_STOCHASTIC,
+		seed, counter);
+}
+
+//
+// Converts an array of float values to the sbfp_t type, rounding them stochastically (see
+// double_to_sbfp_stochastic_n).
+//
+// [in]  fltValues  - the float values to be converted
+// [in]  fltStride  - the distance, in elements, between consecutive float values (1 if contiguous)
+// [out] sbfpValues - the converted values
+// [in]  sbfpStride - the distance, in elements, between consecutive converted values (1 if contiguous)
+// [in]  count      - the number of values
+//
+void float_to_sbfp_stochastic_n(const float *fltValues, ptrdiff_t fltStride, sbfp_t *sbfpValues,
+	ptrdiff_t sbfpStride, size_t count)
+{
+	uint64_t seed    = 0;
+	uint64_t counter = claim_stochastic(count, &seed);
+
+	encode_floats_round(fltValues, fltStride, sbfpValues, sbfpStride, count, SBFP_ROUND_STOCHASTIC,
+		seed, counter);
+}
+
+//
+// Multiplies arrays of sbfp values elementwise, rounding stochastically (see
+// sbfp_mul_stochastic). The results are the same as multiplying the elements one at a
+// time, in order.
+//
+// [in]  sbfpValues1  - the multiplicands
+// [in]  sbfpStride1  - the distance, in elements, between consecutive multiplicands (1 if contiguous)
+// [in]  sbfpValues2  - the multipliers
+// [in]  sbfpStride2  - the distance, in elements, between consecutive multipliers (1 if contiguous)
+// [out] sbfpResults  - the products (may be the same array as either operand)
+// [in]  resultStride - the distance, in elements, between consecutive products (1 if contiguous)
+// [in]  count        - the number of elements
+//
+void sbfp_mul_stochastic_n(const sbfp_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp_t *sbfpValues2,
+	ptrdiff_t sbfpStride2, sbfp_t *sbfpResults, ptrdiff_t resultStride, size_t count)
+{
+	uint64_t seed    = 0;
+	uint64_t counter = claim_stochastic(count, &seed);
+
+	operate_round(sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, resultStride, count,
+		SBFP_OPERATION_MUL, SBFP_ROUND_STOCHASTIC, seed, counter);
+}
+
+//
+// Adds arrays of sbfp values elementwise, rounding stochastically (see sbfp_add_stochastic
+// and sbfp_mul_stochastic_n).
+//
+// [in]  sbfpValues1  - the augends
+// [in]  sbfpStride1  - the distance, in elements, between consecutive augends (1 if contiguous)
+// [in]  sbfpValues2  - the addends
+// [in]  sbfpStride2  - the distance, in elements, between consecutive addends (1 if contiguous)
+// [out] sbfpResults  - the sums (may be the same array as either operand)
+// [in]  resultStride - the distance, in elements, between consecutive sums (1 if contiguous)
+// [in]  count        - the number of elements
+//
+void sbfp_add_stochastic_n(const sbfp_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp_t *sbfpValues2,
+	ptrdiff_t sbfpStride2, sbfp_t *sbfpResults, ptrdiff_t resultStride, size_t count)
+{
+	uint64_t seed    = 0;
+	uint64_t counter = claim_stochastic(count, &seed);
+
+	operate_round(sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, resultStride, count,
+		SBFP_OPERATION_ADD, SBFP_ROUND_STOCHASTIC, seed, counter);
+}
+
+//
+// Subtracts arrays of sbfp values elementwise, rounding stochastically (see
+// sbfp_sub_stochastic and sbfp_mul_stochastic_n).
+//
+// [in]  sbfpValues1  - the minuends
+// [in]  sbfpStride1  - the distance, in elements, between consecutive minuends (1 if contiguous)
+// [in]  sbfpValues2  - the subtrahends
+// [in]  sbfpStride2  - the distance, in elements, between consecutive subtrahends (1 if contiguous)
+// [out] sbfpResults  - the differences (may be the same array as either operand)
+// [in]  resultStride - the distance, in elements, between consecutive differences (1 if contiguous)
+// [in]  count        - the number of elements
+//
+void sbfp_sub_stochastic_n(const sbfp_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp_t *sbfpValues2,
+	ptrdiff_t sbfpStride2, sbfp_t *sbfpResults, ptrdiff_t resultStride, size_t count)
+{
+	uint64_t seed    = 0;
+	uint64_t counter = claim_stochastic(count, &seed);
 
-	return sbfpSum;
+	operate_round(sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, resultStride, count,
+		SBFP_OPERATION_SUB, SBFP_ROUND_STOCHASTIC, seed, counter);
 }
@@ -26,11 +26,233 @@
 #ifndef SBFP_LIB_H
 #define SBFP_LIB_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 typedef int sbfp_t;
+typedef uint16_t sbfp16_t; // sbfp_t bits stored in 16 bits, for packed arrays
+typedef uint8_t  sbfp8_t;  // an 8-bit value in the SBFP8_E4M3 or SBFP8_E5M2 format
+typedef uint16_t bf16_t;   // a bfloat16 value, the top 16 bits of a float
+
+//
+// Defining SBFP_INLINE before including this file defines the scalar conversions and
+// sbfp_mul, sbfp_add and sbfp_sub as static inline functions, so that calls to them can be
+// inlined and loops over them vectorized without link-time optimization. They give the
+// same results as the library functions, and the rest of the library is still linked.
+// So are their forms with a _round suffix, which compile to code for one rounding mode
+// alone when given it as a constant.
+//
+#ifdef SBFP_INLINE
+#include "sbfp_core.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int sbfp_set_rounding(int mode);
+int sbfp_get_rounding(void);
+
+#ifdef SBFP_INLINE
+static inline SBFP_CORE_CONSTEXPR sbfp_t double_to_sbfp(double value)
+{
+	return sbfp_core_encode_double(value);
+}
+
+static inline SBFP_CORE_CONSTEXPR double sbfp_to_double(sbfp_t value)
+{
+	return sbfp_core_decode_double(value);
+}
+
+static inline SBFP_CORE_CONSTEXPR sbfp_t float_to_sbfp(float value)
+{
+	return sbfp_core_encode_float(value);
+}
+
+static inline SBFP_CORE_CONSTEXPR float sbfp_to_float(sbfp_t value)
+{
+	return sbfp_core_decode_float(value);
+}
 
+static inline SBFP_CORE_CONSTEXPR sbfp_t sbfp_mul(sbfp_t value1, sbfp_t value2)
+{
+	return sbfp_core_multiply_arithmetic(value1, value2);
+}
+
+static inline SBFP_CORE_CONSTEXPR sbfp_t sbfp_add(sbfp_t value1, sbfp_t value2)
+{
+	return sbfp_core_add(value1, value2, 0);
+}
+
+static inline SBFP_CORE_CONSTEXPR sbfp_t sbfp_sub(sbfp_t value1, sbfp_t value2)
+{
+	return sbfp_core_add(value1, value2, 1);
+}
+
+static inline sbfp_t double_to_sbfp_round(int mode, double value)
+{
+	return sbfp_core_encode_double_round(value, sbfp_core_check_rounding((mode == SBFP_ROUND_DYNAMIC) ? sbfp_get_rounding() : mode), 0);
+}
+
+static inline sbfp_t float_to_sbfp_round(int mode, float value)
+{
+	return sbfp_core_encode_float_round(value, sbfp_core_check_rounding((mode == SBFP_ROUND_DYNAMIC) ? sbfp_get_rounding() : mode), 0);
+}
+
+static inline sbfp_t sbfp_mul_round(int mode, sbfp_t value1, sbfp_t value2)
+{
+	return sbfp_core_multiply_round(value1, value2, sbfp_core_check_rounding((mode == SBFP_ROUND_DYNAMIC) ? sbfp_get_rounding() : mode), 0);
+}
+
+static inline sbfp_t sbfp_add_round(int mode, sbfp_t value1, sbfp_t value2)
+{
+	return sbfp_core_add_round(value1, value2, 0, sbfp_core_check_rounding((mode == SBFP_ROUND_DYNAMIC) ? sbfp_get_rounding() : mode), 0);
+}
+
+static inline sbfp_t sbfp_sub_round(int mode, sbfp_t value1, sbfp_t value2)
+{
+	return sbfp_core_add_round(value1, value2, 1, sbfp_core_check_rounding((mode == SBFP_ROUND_DYNAMIC) ? sbfp_get_rounding() : mode), 0);
+}
+#else
 sbfp_t double_to_sbfp(double value);
 double sbfp_to_double(sbfp_t value);
+sbfp_t float_to_sbfp(float value);
+float sbfp_to_float(sbfp_t value);
 sbfp_t sbfp_mul(sbfp_t value1, sbfp_t value2);
 sbfp_t sbfp_add(sbfp_t value1, sbfp_t value2);
+sbfp_t sbfp_sub(sbfp_t value1, sbfp_t value2);
+sbfp_t double_to_sbfp_round(int mode, double value);
+sbfp_t float_to_sbfp_round(int mode, float value);
+sbfp_t sbfp_mul_round(int mode, sbfp_t value1, sbfp_t value2);
+sbfp_t sbfp_add_round(int mode, sbfp_t value1, sbfp_t value2);
+sbfp_t sbfp_sub_round(int mode, sbfp_t value1, sbfp_t value2);
+#endif
+
+void double_to_sbfp_n(const double *values, ptrdiff_t stride, sbfp_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp_to_double_n(const sbfp_t *values, ptrdiff_t stride, double *results, ptrdiff_t resultStride, size_t count);
+void float_to_sbfp_n(const float *values, ptrdiff_t stride, sbfp_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp_to_float_n(const sbfp_t *values, ptrdiff_t stride, float *results, ptrdiff_t resultStride, size_t count);
+void sbfp_to_sbfp16_n(const sbfp_t *values, ptrdiff_t stride, sbfp16_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp16_to_sbfp_n(const sbfp16_t *values, ptrdiff_t stride, sbfp_t *results, ptrdiff_t resultStride, size_t count);
+void double_to_sbfp16_n(const double *values, ptrdiff_t stride, sbfp16_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp16_to_double_n(const sbfp16_t *values, ptrdiff_t stride, double *results, ptrdiff_t resultStride, size_t count);
+void float_to_sbfp16_n(const float *values, ptrdiff_t stride, sbfp16_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp16_to_float_n(const sbfp16_t *values, ptrdiff_t stride, float *results, ptrdiff_t resultStride, size_t count);
+void sbfp_legacy_to_binary16_n(const sbfp16_t *values, ptrdiff_t stride, sbfp16_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp_binary16_to_legacy_n(const sbfp16_t *values, ptrdiff_t stride, sbfp16_t *results, ptrdiff_t resultStride, size_t count);
+const double *sbfp_double_table(void);
+const float *sbfp_float_table(void);
+const char *sbfp_backend(void);
+int sbfp_mul_init(int engine);
+void sbfp_mul_n(const sbfp_t *values1, ptrdiff_t stride1, const sbfp_t *values2, ptrdiff_t stride2,
+	sbfp_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp16_mul_n(const sbfp16_t *values1, ptrdiff_t stride1, const sbfp16_t *values2, ptrdiff_t stride2,
+	sbfp16_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp_add_n(const sbfp_t *values1, ptrdiff_t stride1, const sbfp_t *values2, ptrdiff_t stride2,
+	sbfp_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp16_add_n(const sbfp16_t *values1, ptrdiff_t stride1, const sbfp16_t *values2, ptrdiff_t stride2,
+	sbfp16_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp_sub_n(const sbfp_t *values1, ptrdiff_t stride1, const sbfp_t *values2, ptrdiff_t stride2,
+	sbfp_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp16_sub_n(const sbfp16_t *values1, ptrdiff_t stride1, const sbfp16_t *values2, ptrdiff_t stride2,
+	sbfp16_t *results, ptrdiff_t resultStride, size_t count);
+sbfp_t sbfp_fma(sbfp_t value1, sbfp_t value2, sbfp_t value3);
+void sbfp_fma_n(const sbfp_t *values1, ptrdiff_t stride1, const sbfp_t *values2, ptrdiff_t stride2,
+	const sbfp_t *values3, ptrdiff_t stride3, sbfp_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp16_fma_n(const sbfp16_t *values1, ptrdiff_t stride1, const sbfp16_t *values2, ptrdiff_t stride2,
+	const sbfp16_t *values3, ptrdiff_t stride3, sbfp16_t *results, ptrdiff_t resultStride, size_t count);
+sbfp_t sbfp_div(sbfp_t value1, sbfp_t value2);
+void sbfp_div_n(const sbfp_t *values1, ptrdiff_t stride1, const sbfp_t *values2, ptrdiff_t stride2,
+	sbfp_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp16_div_n(const sbfp16_t *values1, ptrdiff_t stride1, const sbfp16_t *values2, ptrdiff_t stride2,
+	sbfp16_t *results, ptrdiff_t resultStride, size_t count);
+sbfp8_t double_to_sbfp8(int format, double value);
+double sbfp8_to_double(int format, sbfp8_t value);
+sbfp8_t float_to_sbfp8(int format, float value);
+float sbfp8_to_float(int format, sbfp8_t value);
+sbfp8_t sbfp_to_sbfp8(int format, sbfp_t value);
+sbfp_t sbfp8_to_sbfp(int format, sbfp8_t value);
+sbfp8_t sbfp8_add(int format, sbfp8_t value1, sbfp8_t value2);
+sbfp8_t sbfp8_sub(int format, sbfp8_t value1, sbfp8_t value2);
+sbfp8_t sbfp8_mul(int format, sbfp8_t value1, sbfp8_t value2);
+void double_to_sbfp8_n(int format, const double *values, ptrdiff_t stride, sbfp8_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp8_to_double_n(int format, const sbfp8_t *values, ptrdiff_t stride, double *results, ptrdiff_t resultStride, size_t count);
+void float_to_sbfp8_n(int format, const float *values, ptrdiff_t stride, sbfp8_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp8_to_float_n(int format, const sbfp8_t *values, ptrdiff_t stride, float *results, ptrdiff_t resultStride, size_t count);
+void sbfp_to_sbfp8_n(int format, const sbfp_t *values, ptrdiff_t stride, sbfp8_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp8_to_sbfp_n(int format, const sbfp8_t *values, ptrdiff_t stride, sbfp_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp16_to_sbfp8_n(int format, const sbfp16_t *values, ptrdiff_t stride, sbfp8_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp8_to_sbfp16_n(int format, const sbfp8_t *values, ptrdiff_t stride, sbfp16_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp8_add_n(int format, const sbfp8_t *values1, ptrdiff_t stride1, const sbfp8_t *values2, ptrdiff_t stride2,
+	sbfp8_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp8_sub_n(int format, const sbfp8_t *values1, ptrdiff_t stride1, const sbfp8_t *values2, ptrdiff_t stride2,
+	sbfp8_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp8_mul_n(int format, const sbfp8_t *values1, ptrdiff_t stride1, const sbfp8_t *values2, ptrdiff_t stride2,
+	sbfp8_t *results, ptrdiff_t resultStride, size_t count);
+bf16_t double_to_bf16(double value);
+bf16_t double_to_bf16_rne(double value);
+double bf16_to_double(bf16_t value);
+bf16_t float_to_bf16(float value);
+bf16_t float_to_bf16_rne(float value);
+float bf16_to_float(bf16_t value);
+bf16_t sbfp_to_bf16(sbfp_t value);
+sbfp_t bf16_to_sbfp(bf16_t value);
+bf16_t bf16_add(bf16_t value1, bf16_t value2);
+bf16_t bf16_sub(bf16_t value1, bf16_t value2);
+bf16_t bf16_mul(bf16_t value1, bf16_t value2);
+void double_to_bf16_n(const double *values, ptrdiff_t stride, bf16_t *results, ptrdiff_t resultStride, size_t count);
+void double_to_bf16_rne_n(const double *values, ptrdiff_t stride, bf16_t *results, ptrdiff_t resultStride, size_t count);
+void bf16_to_double_n(const bf16_t *values, ptrdiff_t stride, double *results, ptrdiff_t resultStride, size_t count);
+void float_to_bf16_n(const float *values, ptrdiff_t stride, bf16_t *results, ptrdiff_t resultStride, size_t count);
+void float_to_bf16_rne_n(const float *values, ptrdiff_t stride, bf16_t *results, ptrdiff_t resultStride, size_t count);
+void bf16_to_float_n(const bf16_t *values, ptrdiff_t stride, float *results, ptrdiff_t resultStride, size_t count);
+void sbfp_to_bf16_n(const sbfp_t *values, ptrdiff_t stride, bf16_t *results, ptrdiff_t resultStride, size_t count);
+void bf16_to_sbfp_n(const bf16_t *values, ptrdiff_t stride, sbfp_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp16_to_bf16_n(const sbfp16_t *values, ptrdiff_t stride, bf16_t *results, ptrdiff_t resultStride, size_t count);
+void bf16_to_sbfp16_n(const bf16_t *values, ptrdiff_t stride, sbfp16_t *results, ptrdiff_t resultStride, size_t count);
+void bf16_add_n(const bf16_t *values1, ptrdiff_t stride1, const bf16_t *values2, ptrdiff_t stride2,
+	bf16_t *results, ptrdiff_t resultStride, size_t count);
+void bf16_sub_n(const bf16_t *values1, ptrdiff_t stride1, const bf16_t *values2, ptrdiff_t stride2,
+	bf16_t *results, ptrdiff_t resultStride, size_t count);
+void bf16_mul_n(const bf16_t *values1, ptrdiff_t stride1, const bf16_t *values2, ptrdiff_t stride2,
+	bf16_t *results, ptrdiff_t resultStride, size_t count);
+sbfp_t sbfp_fma_round(int mode, sbfp_t value1, sbfp_t value2, sbfp_t value3);
+sbfp_t sbfp_div_round(int mode, sbfp_t value1, sbfp_t value2);
+void double_to_sbfp_round_n(int mode, const double *values, ptrdiff_t stride, sbfp_t *results, ptrdiff_t resultStride, size_t count);
+void float_to_sbfp_round_n(int mode, const float *values, ptrdiff_t stride, sbfp_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp_mul_round_n(int mode, const sbfp_t *values1, ptrdiff_t stride1, const sbfp_t *values2, ptrdiff_t stride2,
+	sbfp_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp_add_round_n(int mode, const sbfp_t *values1, ptrdiff_t stride1, const sbfp_t *values2, ptrdiff_t stride2,
+	sbfp_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp_sub_round_n(int mode, const sbfp_t *values1, ptrdiff_t stride1, const sbfp_t *values2, ptrdiff_t stride2,
+	sbfp_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp16_mul_round_n(int mode, const sbfp16_t *values1, ptrdiff_t stride1, const sbfp16_t *values2, ptrdiff_t stride2,
+	sbfp16_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp16_add_round_n(int mode, const sbfp16_t *values1, ptrdiff_t stride1, const sbfp16_t *values2, ptrdiff_t stride2,
+	sbfp16_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp16_sub_round_n(int mode, const sbfp16_t *values1, ptrdiff_t stride1, const sbfp16_t *values2, ptrdiff_t stride2,
+	sbfp16_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp_fma_round_n(int mode, const sbfp_t *values1, ptrdiff_t stride1, const sbfp_t *values2, ptrdiff_t stride2,
+	const sbfp_t *values3, ptrdiff_t stride3, sbfp_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp_div_round_n(int mode, const sbfp_t *values1, ptrdiff_t stride1, const sbfp_t *values2, ptrdiff_t stride2,
+	sbfp_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp_seed_stochastic(uint64_t seed);
+sbfp_t double_to_sbfp_stochastic(double value);
+sbfp_t float_to_sbfp_stochastic(float value);
+sbfp_t sbfp_mul_stochastic(sbfp_t value1, sbfp_t value2);
+sbfp_t sbfp_add_stochastic(sbfp_t value1, sbfp_t value2);
+sbfp_t sbfp_sub_stochastic(sbfp_t value1, sbfp_t value2);
+void double_to_sbfp_stochastic_n(const double *values, ptrdiff_t stride, sbfp_t *results, ptrdiff_t resultStride, size_t count);
+void float_to_sbfp_stochastic_n(const float *values, ptrdiff_t stride, sbfp_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp_mul_stochastic_n(const sbfp_t *values1, ptrdiff_t stride1, const sbfp_t *values2, ptrdiff_t stride2,
+	sbfp_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp_add_stochastic_n(const sbfp_t *values1, ptrdiff_t stride1, const sbfp_t *values2, ptrdiff_t stride2,
+	sbfp_t *results, ptrdiff_t resultStride, size_t count);
+void sbfp_sub_stochastic_n(const sbfp_t *values1, ptrdiff_t stride1, const sbfp_t *values2, ptrdiff_t stride2,
+	sbfp_t *results, ptrdiff_t resultStride, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
 
 #endif
@@ -0,0 +1,332 @@
+//
+// sbfp_lib.hpp
+//
+// This file contains C++ wrappers of the scalar SBFP functions that can be evaluated at
+// compile time, and the _sbfp literal. They run the same code as the library functions
+// (see sbfp_core.h), so constants computed with them match the runtime results bit for
+// bit. Requires C++14 and a compiler with __builtin_bit_cast (GCC 11, Clang 9, MSVC 19.27
+// or later).
+//
+// The sbfp::rounding template rounds in another mode than to nearest even, and the
+// sbfp::format template applies the same kind of arithmetic to other widths (see
+// sbfp_format.h).
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2021 Luke Andrews.  All Rights Reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify, merge,
+// publish, distribute, sub-license, and/or sell copies of the Software, and to permit persons
+// to whom the Software is furnished to do so, subject to the following conditions:
+//
+// * The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+// PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR 
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+#ifndef SBFP_LIB_HPP
+#define SBFP_LIB_HPP
+
+#include "sbfp_lib.h"
+#include "sbfp_core.h"
+#include "sbfp_format.h"
+#include <array>
+#include <cstddef>
+#include <utility>
+
+namespace sbfp
+{
+
+//
+// Converts a given double value to the sbfp_t type (see double_to_sbfp).
+//
+// [in] dblValue - the double value to be converted
+//
+// Returns the converted value.
+//
+constexpr sbfp_t from_double(double dblValue)
+{
+	return sbfp_core_encode_double(dblValue);
+}
+
+//
+// Converts a given sbfp_t value to a double value (see sbfp_to_double).
+//
+// [in] sbfpValue - the sbfp_t value to be converted
+//
+// Returns the converted value.
+//
+constexpr double to_double(sbfp_t sbfpValue)
+{
+	return sbfp_core_decode_double(sbfpValue);
+}
+
+//
+// Converts a given float value to the sbfp_t type (see float_to_sbfp).
+//
+// [in] fltValue - the float value to be converted
+//
+// Returns the converted value.
+//
+constexpr sbfp_t from_float(float fltValue)
+{
+	return sbfp_core_encode_float(fltValue);
+}
+
+//
+// Converts a given sbfp_t value to a float value (see sbfp_to_float).
+//
+// [in] sbfpValue - the sbfp_t value to be converted
+//
+// Returns the converted value.
+//
+constexpr float to_float(sbfp_t sbfpValue)
+{
+	return sbfp_core_decode_float(sbfpValue);
+}
+
+//
+// Multiplies two sbfp values (see sbfp_mul).
+//
+// [in] sbfpValue1 - the multiplicand
+// [in] sbfpValue2 - the multiplier
+//
+// Returns the product.
+//
+constexpr sbfp_t mul(sbfp_t sbfpValue1, sbfp_t sbfpValue2)
+{
+	return sbfp_core_multiply_arithmetic(sbfpValue1, sbfpValue2);
+}
+
+//
+// Adds two sbfp values (see sbfp_add).
+//
+// [in] sbfpValue1 - the augend
+// [in] sbfpValue2 - the addend
+//
+// Returns the sum.
+//
+constexpr sbfp_t add(sbfp_t sbfpValue1, sbfp_t sbfpValue2)
+{
+	return sbfp_core_add(sbfpValue1, sbfpValue2, 0);
+}
+
+//
+// Subtracts one sbfp value from another (see sbfp_sub).
+//
+// [in] sbfpValue1 - the minuend
+// [in] sbfpValue2 - the subtrahend
+//
+// Returns the difference.
+//
+constexpr sbfp_t sub(sbfp_t sbfpValue1, sbfp_t sbfpValue2)
+{
+	return sbfp_core_add(sbfpValue1, sbfpValue2, 1);
+}
+
+namespace detail
+{
+
+template <std::size_t N, std::size_t... Index>
+constexpr std::array<sbfp_t, N> from_doubles(const double (&dblValues)[N], std::index_sequence<Index...>)
+{
+	return {{ from_double(dblValues[Index])... }};
+}
+
+}
+
+//
+// Converts an array of double values to the sbfp_t type, so that a table of coefficients
+// can be built at compile time:
+//
+//     constexpr auto table = sbfp::from_doubles({ 0.5, 0.25, 0.125 });
+//
+// [in] dblValues - the double values to be converted
+//
+// Returns the converted values.
+//
+template <std::size_t N>
+constexpr std::array<sbfp_t, N> from_doubles(const double (&dblValues)[N])
+{
+	return detail::from_doubles(dblValues, std::make_index_sequence<N>());
+}
+
+//
+// The scalar functions rounding in a given mode (see SBFP_ROUND_NEAREST_EVEN), which is
+// folded into each member, e.g. to round upward:
+//
+//     constexpr sbfp_t x = sbfp::upward::from_double(0.1);
+//     sbfp_t y = sbfp::upward::mul(x, x);
+//
+// The calling thread's mode is only known at run time, so SBFP_ROUND_DYNAMIC is not a mode
+// here (see double_to_sbfp_round).
+//
+template <int Mode>
+struct rounding
+{
+	static_assert((Mode >= 0 && Mode < SBFP_ROUND_MODE_COUNT) || Mode == SBFP_ROUND_TRUNCATE, "an unknown rounding mode");
+
+	static constexpr int mode = Mode;
+
+	//
+	// Converts a given double value to the sbfp_t type, rounding it in this mode.
+	//
+	static constexpr sbfp_t from_double(double dblValue)
+	{
+		return sbfp_core_encode_double_round(dblValue, Mode, 0);
+	}
+
+	//
+	// Converts a given float value to the sbfp_t type, rounding it in this mode.
+	//
+	static constexpr sbfp_t from_float(float fltValue)
+	{
+		return sbfp_core_encode_float_round(fltValue, Mode, 0);
+	}
+
+	//
+	// Multiplies two sbfp values, rounding the product in this mode.
+	//
+	static constexpr sbfp_t mul(sbfp_t sbfpValue1, sbfp_t sbfpValue2)
+	{
+		return sbfp_core_multiply_round(sbfpValue1, sbfpValue2, Mode, 0);
+	}
+
+	//
+	// Adds two sbfp values, rounding the sum in this mode.
+	//
+	static constexpr sbfp_t add(sbfp_t sbfpValue1, sbfp_t sbfpValue2)
+	{
+		return sbfp_core_add_round(sbfpValue1, sbfpValue2, 0, Mode, 0);
+	}
+
+	//
+	// Subtracts one sbfp value from another, rounding the difference in this mode.
+	//
+	static constexpr sbfp_t sub(sbfp_t sbfpValue1, sbfp_t sbfpValue2)
+	{
+		return sbfp_core_add_round(sbfpValue1, sbfpValue2, 1, Mode, 0);
+	}
+};
+
+using nearest_even = rounding<SBFP_ROUND_NEAREST_EVEN>; // the functions above
+using toward_zero  = rounding<SBFP_ROUND_TOWARD_ZERO>;  // truncate, saturating if SBFP_SATURATE_TOWARD_ZERO
+using upward       = rounding<SBFP_ROUND_UPWARD>;
+using downward     = rounding<SBFP_ROUND_DOWNWARD>;
+using truncate     = rounding<SBFP_ROUND_TRUNCATE>;
+
+//
+// A binary floating point format with the given widths and bias (see sbfp_format.h). Each
+// member is folded into code for this format alone, e.g. for bfloat16 values:
+//
+//     uint32_t x = sbfp::bfloat16::from_double(1.5);
+//     uint32_t y = sbfp::bfloat16::mul(x, x);
+//
+template <int ExpoBits, int FracBits, int Bias = (1 << (ExpoBits - 1)) - 1>
+struct format
+{
+	static_assert(ExpoBits >= 2 && ExpoBits <= 10, "a format has 2 to 10 expo bits");
+	static_assert(FracBits >= 1 && FracBits <= 30, "a format has 1 to 30 frac bits");
+	static_assert(1 + ExpoBits + FracBits <= 32, "a format has at most 32 bits");
+
+	static constexpr int expo_bits = ExpoBits;
+	static constexpr int frac_bits = FracBits;
+	static constexpr int bias      = Bias;
+
+	//
+	// Converts a given double value to this format, truncating it toward zero.
+	//
+	static constexpr uint32_t from_double(double dblValue)
+	{
+		return sbfp_format_encode_double(ExpoBits, FracBits, Bias, dblValue);
+	}
+
+	//
+	// Converts a value of this format to a double value.
+	//
+	static constexpr double to_double(uint32_t fmtBits)
+	{
+		return sbfp_format_decode_double(ExpoBits, FracBits, Bias, fmtBits);
+	}
+
+	//
+	// Multiplies two values of this format.
+	//
+	static constexpr uint32_t mul(uint32_t fmtBits1, uint32_t fmtBits2)
+	{
+		return sbfp_format_mul(ExpoBits, FracBits, Bias, fmtBits1, fmtBits2);
+	}
+
+	//
+	// Adds two values of this format.
+	//
+	static constexpr uint32_t add(uint32_t fmtBits1, uint32_t fmtBits2)
+	{
+		return sbfp_format_add(ExpoBits, FracBits, Bias, fmtBits1, fmtBits2, 0);
+	}
+
+	//
+	// Subtracts one value of this format from another.
+	//
+	static constexpr uint32_t sub(uint32_t fmtBits1, uint32_t fmtBits2)
+	{
+		return sbfp_format_add(ExpoBits, FracBits, Bias, fmtBits1, fmtBits2, 1);
+	}
+};
+
+using binary16 = format<5, 10>; // IEEE 754 binary16, as sbfp_t with SBFP_IEEE_BINARY16
+using bfloat16 = format<8, 7>;
+using e5m2     = format<5, 2>;
+
+namespace literals
+{
+
+//
+// Converts a floating literal to the sbfp_t type, as 0.125_sbfp, rounding its value like
+// double_to_sbfp. Rounding it to nearest double first could move it onto a tie between
+// two sbfp values, so a value that is not a double is rounded to odd instead: the double
+// next to it with an odd last bit is neither an sbfp value nor a tie between two, so it
+// rounds as the literal would.
+//
+// [in] value - the value of the literal, which is never negative
+//
+// Returns the converted value.
+//
+constexpr sbfp_t operator""_sbfp(long double value)
+{
+	double dblValue = static_cast<double>(value);
+
+	uint64_t dblBits = sbfp_core_double_bits(dblValue);
+
+	if (dblValue != value && (dblBits & 1) == 0)
+	{
+		dblValue = sbfp_core_bits_double((dblValue > value) ? dblBits - 1 : dblBits + 1);
+	}
+
+	return from_double(dblValue);
+}
+
+//
+// Converts an integer literal to the sbfp_t type, as 3_sbfp.
+//
+// [in] value - the value of the literal
+//
+// Returns the converted value.
+//
+constexpr sbfp_t operator""_sbfp(unsigned long long value)
+{
+	return from_double(static_cast<double>(value));
+}
+
+}
+
+}
+
+#endif
@@ -0,0 +1,3455 @@
+//
+// sbfp_x86.c
+//
+// This file contains the x86 SIMD backends of the bulk SBFP functions (see sbfp_x86.h).
+// Each backend is compiled for its instruction set with a target attribute, and its
+// kernels are only reached through sbfpX86Kernels, which is filled once at load time with
+// the kernels the CPU supports. The file itself builds with the default compiler flags.
+// 
+// The F16C backend converts eight values per instruction with VCVTPS2PH/VCVTPH2PS. Those
+// instructions implement IEEE binary16, so the results are translated to the sbfp
+// encoding: +-0 becomes +0, 2^-14 becomes one of its neighbours (see double_to_sbfp),
+// infinity becomes SBFP_POS_INF/SBFP_NEG_INF, and NaN becomes SBFP_NAN or the canonical
+// double/float NaN.
+//
+// The AVX2 backend serves CPUs without F16C. It runs the same steps as
+// sbfp_core_encode_double, sbfp_core_encode_float and sbfp_core_decode_float in
+// sbfp_core.h, four doubles or eight floats at a time in 256-bit integer lanes.
+//
+// The AVX-512 backend adds arithmetic kernels that widen sixteen values at a time.
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2021 Luke Andrews.  All Rights Reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify, merge,
+// publish, distribute, sub-license, and/or sell copies of the Software, and to permit persons
+// to whom the Software is furnished to do so, subject to the following conditions:
+//
+// * The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+// PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR 
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+#include "sbfp_const.h"
+#include "sbfp_x86.h"
+
+#ifdef SBFP_X86
+
+#include <immintrin.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SBFP_TARGET_SSE2   __attribute__((target("sse2")))
+#define SBFP_TARGET_AVX    __attribute__((target("avx")))
+#define SBFP_TARGET_F16C   __attribute__((target("avx,f16c")))
+#define SBFP_TARGET_AVX2   __attribute__((target("avx2")))
+#define SBFP_TARGET_AVX512 __attribute__((target("avx512f")))
+
+// Operations of the AVX-512 arithmetic kernels:
+#define SBFP_X86_OP_ADD 0
+#define SBFP_X86_OP_SUB 1
+#define SBFP_X86_OP_MUL 2
+
+static const char *const sbfpBackendNames[SBFP_BACKEND_COUNT] = { "scalar", "sse2", "avx2", "f16c", "avx512" };
+
+static int sbfpBackend = SBFP_BACKEND_SCALAR;
+
+sbfp_x86_kernels_t sbfpX86Kernels;
+
+//
+// Determines whether the CPU supports the SSE2 backend.
+//
+// Returns true if SSE2 is available.
+//
+static bool has_sse2(void)
+{
+	return __builtin_cpu_supports("sse2");
+}
+
+//
+// Determines whether the CPU and OS support the F16C backend.
+//
+// Returns true if AVX and F16C are available.
+//
+static bool has_f16c(void)
+{
+	return __builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c");
+}
+
+//
+// Determines whether the CPU and OS support the AVX2 backend.
+//
+// Returns true if AVX2 is available.
+//
+static bool has_avx2(void)
+{
+	return __builtin_cpu_supports("avx2");
+}
+
+//
+// Determines whether the CPU and OS support the AVX-512 backend.
+//
+// Returns true if AVX-512F is available.
+//
+static bool has_avx512(void)
+{
+	return __builtin_cpu_supports("avx512f");
+}
+
+//
+// Fills sbfpX86Kernels once, when the library is loaded. Each backend the CPU supports
+// replaces the kernels of the ones before it, so every bulk function ends up with the most
+// capable kernel available for it. The SBFP_BACKEND environment variable ("scalar", "sse2",
+// "avx2", "f16c" or "avx512") caps the backend for benchmarking. A backend the CPU lacks is
+// never selected, and an unknown name is ignored.
+//
+// Until this has run, the table is empty and the bulk functions use the portable code.
+//
+__attribute__((constructor))
+static void resolve_kernels(void)
+{
+	int maxBackend = SBFP_BACKEND_COUNT - 1;
+
+	const char *forcedName = getenv("SBFP_BACKEND");
+
+	for (int backend = 0; forcedName != NULL && backend < SBFP_BACKEND_COUNT; ++backend)
+	{
+		if (strcmp(forcedName, sbfpBackendNames[backend]) == 0)
+		{
+			maxBackend = backend;
+		}
+	}
+
+	if (maxBackend >= SBFP_BACKEND_SSE2 && has_sse2())
+	{
+		sbfpX86Kernels.sbfp16_add = sbfp_sse2_sbfp16_add;
+		sbfpX86Kernels.sbfp16_sub = sbfp_sse2_sbfp16_sub;
+		sbfpX86Kernels.sbfp16_mul = sbfp_sse2_sbfp16_mul;
+
+		sbfpBackend = SBFP_BACKEND_SSE2;
+	}
+
+	if (maxBackend >= SBFP_BACKEND_AVX2 && has_avx2())
+	{
+		sbfpX86Kernels.double_to_sbfp    = sbfp_avx2_double_to_sbfp;
+		sbfpX86Kernels.sbfp_to_double    = sbfp_avx2_sbfp_to_double;
+		sbfpX86Kernels.float_to_sbfp     = sbfp_avx2_float_to_sbfp;
+		sbfpX86Kernels.sbfp_to_float     = sbfp_avx2_sbfp_to_float;
+		sbfpX86Kernels.double_to_sbfp16  = sbfp_avx2_double_to_sbfp16;
+		sbfpX86Kernels.sbfp16_to_double  = sbfp_avx2_sbfp16_to_double;
+		sbfpX86Kernels.float_to_sbfp16   = sbfp_avx2_float_to_sbfp16;
+		sbfpX86Kernels.sbfp16_to_float   = sbfp_avx2_sbfp16_to_float;
+		sbfpX86Kernels.float_to_e4m3     = sbfp_avx2_float_to_e4m3;
+		sbfpX86Kernels.e4m3_to_float     = sbfp_avx2_e4m3_to_float;
+		sbfpX86Kernels.float_to_e5m2     = sbfp_avx2_float_to_e5m2;
+		sbfpX86Kernels.e5m2_to_float     = sbfp_avx2_e5m2_to_float;
+		sbfpX86Kernels.float_to_bf16     = sbfp_avx2_float_to_bf16;
+		sbfpX86Kernels.float_to_bf16_rne = sbfp_avx2_float_to_bf16_rne;
+		sbfpX86Kernels.bf16_to_float     = sbfp_avx2_bf16_to_float;
+		sbfpX86Kernels.sbfp_to_bf16      = sbfp_avx2_sbfp_to_bf16;
+		sbfpX86Kernels.bf16_to_sbfp      = sbfp_avx2_bf16_to_sbfp;
+		sbfpX86Kernels.sbfp16_to_bf16    = sbfp_avx2_sbfp16_to_bf16;
+		sbfpX86Kernels.bf16_to_sbfp16    = sbfp_avx2_bf16_to_sbfp16;
+		sbfpX86Kernels.bf16_add          = sbfp_avx2_bf16_add;
+		sbfpX86Kernels.bf16_sub          = sbfp_avx2_bf16_sub;
+		sbfpX86Kernels.bf16_mul          = sbfp_avx2_bf16_mul;
+		sbfpX86Kernels.sbfp16_add        = sbfp_avx2_sbfp16_add;
+		sbfpX86Kernels.sbfp16_sub        = sbfp_avx2_sbfp16_sub;
+		sbfpX86Kernels.sbfp16_mul        = sbfp_avx2_sbfp16_mul;
+
+		sbfpBackend = SBFP_BACKEND_AVX2;
+	}
+
+	if (maxBackend >= SBFP_BACKEND_F16C && has_f16c())
+	{
+		sbfpX86Kernels.double_to_sbfp   = sbfp_f16c_double_to_sbfp;
+		sbfpX86Kernels.sbfp_to_double   = sbfp_f16c_sbfp_to_double;
+		sbfpX86Kernels.float_to_sbfp    = sbfp_f16c_float_to_sbfp;
+		sbfpX86Kernels.sbfp_to_float    = sbfp_f16c_sbfp_to_float;
+		sbfpX86Kernels.double_to_sbfp16 = sbfp_f16c_double_to_sbfp16;
+		sbfpX86Kernels.sbfp16_to_double = sbfp_f16c_sbfp16_to_double;
+		sbfpX86Kernels.float_to_sbfp16  = sbfp_f16c_float_to_sbfp16;
+		sbfpX86Kernels.sbfp16_to_float  = sbfp_f16c_sbfp16_to_float;
+		sbfpX86Kernels.sbfp_add         = sbfp_f16c_sbfp_add;
+		sbfpX86Kernels.sbfp_sub         = sbfp_f16c_sbfp_sub;
+		sbfpX86Kernels.sbfp_mul         = sbfp_f16c_sbfp_mul;
+		sbfpX86Kernels.sbfp16_add       = sbfp_f16c_sbfp16_add;
+		sbfpX86Kernels.sbfp16_sub       = sbfp_f16c_sbfp16_sub;
+		sbfpX86Kernels.sbfp16_mul       = sbfp_f16c_sbfp16_mul;
+
+		sbfpBackend = SBFP_BACKEND_F16C;
+	}
+
+	//
+	// AVX-512 adds arithmetic kernels only. The conversions keep the F16C kernels, which
+	// every AVX-512 CPU also supports.
+	//
+	if (maxBackend >= SBFP_BACKEND_AVX512 && has_avx512() && has_f16c())
+	{
+		sbfpX86Kernels.sbfp_add   = sbfp_avx512_sbfp_add;
+		sbfpX86Kernels.sbfp_sub   = sbfp_avx512_sbfp_sub;
+		sbfpX86Kernels.sbfp_mul   = sbfp_avx512_sbfp_mul;
+		sbfpX86Kernels.sbfp16_add = sbfp_avx512_sbfp16_add;
+		sbfpX86Kernels.sbfp16_sub = sbfp_avx512_sbfp16_sub;
+		sbfpX86Kernels.sbfp16_mul = sbfp_avx512_sbfp16_mul;
+
+		sbfpBackend = SBFP_BACKEND_AVX512;
+	}
+}
+
+//
+// Gives the name of the most capable backend in sbfpX86Kernels (see sbfp_backend).
+//
+// Returns "scalar", "sse2", "avx2", "f16c" or "avx512".
+//
+const char *sbfp_x86_backend_name(void)
+{
+	return sbfpBackendNames[sbfpBackend];
+}
+
+//
+// Selects between the bits of two vectors. Used instead of the blendv intrinsics, which gcc
+// may expand to scalar code inside target-attributed functions.
+//
+// [in] mask      - the lanes to take from trueBits (all bits set) or falseBits (all clear)
+// [in] trueBits  - the bits selected where mask is set
+// [in] falseBits - the bits selected where mask is clear
+//
+// Returns the selected bits.
+//
+SBFP_TARGET_SSE2
+static inline __m128i select_si128(__m128i mask, __m128i trueBits, __m128i falseBits)
+{
+	return _mm_or_si128(_mm_and_si128(mask, trueBits), _mm_andnot_si128(mask, falseBits));
+}
+
+//
+// Widens eight float values to doubles and stores them.
+//
+// [in]  fltValues - the float values
+// [out] dblValues - where to store them
+//
+SBFP_TARGET_AVX
+static inline void store_doubles(__m256 fltValues, double *dblValues)
+{
+	_mm256_storeu_pd(dblValues, _mm256_cvtps_pd(_mm256_castps256_ps128(fltValues)));
+	_mm256_storeu_pd(dblValues + 4, _mm256_cvtps_pd(_mm256_extractf128_ps(fltValues, 1)));
+}
+
+//
+// Translates eight binary16 values, rounded to nearest even from the given floats, to the
+// sbfp encoding. Signed zeros are not translated here (see zero_mask_float and
+// zero_mask_double).
+//
+// [in] halves    - the binary16 values
+// [in] fltValues - the float values they were converted from
+//
+// Returns the sbfp values.
+//
+SBFP_TARGET_F16C
+static inline __m128i translate_halves(__m128i halves, __m256 fltValues)
+{
+	__m128i fltMagnitudeMask = _mm_set1_epi32(FLOAT_MAGNITUDE_MASK);
+	__m128i fltLow           = _mm_and_si128(_mm_castps_si128(_mm256_castps256_ps128(fltValues)), fltMagnitudeMask);
+	__m128i fltHigh          = _mm_and_si128(_mm_castps_si128(_mm256_extractf128_ps(fltValues, 1)), fltMagnitudeMask);
+
+	__m128i sbfpMagnitude = _mm_and_si128(halves, _mm_set1_epi16(SBFP_BIT_MASK >> SBFP_BIT_COUNT_SIGN));
+
+#if SBFP_ZERO_MIN_NORMAL
+	//
+	// Magnitudes that round to 2^-14 become the largest subnormal, or the next value up if
+	// they are above 2^-14:
+	//
+	__m128i minNormalBits = _mm_set1_epi32(FLOAT_SBFP_MIN_NORMAL_BITS);
+	__m128i isAbove       = _mm_packs_epi32(_mm_cmpgt_epi32(fltLow, minNormalBits), _mm_cmpgt_epi32(fltHigh, minNormalBits));
+	__m128i isMinNormal   = _mm_cmpeq_epi16(sbfpMagnitude, _mm_set1_epi16(1 << SBFP_BIT_COUNT_FRAC));
+	__m128i neighbour     = select_si128(isAbove, _mm_set1_epi16((1 << SBFP_BIT_COUNT_FRAC) + 1), _mm_set1_epi16(SBFP_FRAC_MASK));
+
+	halves = select_si128(isMinNormal, _mm_or_si128(neighbour, _mm_xor_si128(halves, sbfpMagnitude)), halves);
+#endif
+
+	//
+	// Infinity, including magnitudes that round to 2^16 or above, and NaN:
+	//
+	__m128i isInf = _mm_cmpeq_epi16(sbfpMagnitude, _mm_set1_epi16(BINARY16_POS_INF));
+
+	__m128i infBits = _mm_set1_epi32(FLOAT_INF_BITS);
+	__m128i isNan   = _mm_packs_epi32(_mm_cmpgt_epi32(fltLow, infBits), _mm_cmpgt_epi32(fltHigh, infBits));
+
+	__m128i isNegative = _mm_srai_epi16(halves, 15);
+	__m128i sbfpInf    = select_si128(isNegative, _mm_set1_epi16(SBFP_NEG_INF), _mm_set1_epi16(SBFP_POS_INF));
+
+	halves = select_si128(isInf, sbfpInf, halves);
+	halves = select_si128(isNan, _mm_set1_epi16(SBFP_NAN), halves);
+
+	return halves;
+}
+
+//
+// Determines which of eight float values are +-0.
+//
+// [in] fltValues - the float values
+//
+// Returns a mask with all 16 bits set in the lanes of the zeros.
+//
+SBFP_TARGET_F16C
+static inline __m128i zero_mask_float(__m256 fltValues)
+{
+	__m128i fltMagnitudeMask = _mm_set1_epi32(FLOAT_MAGNITUDE_MASK);
+	__m128i fltLow           = _mm_and_si128(_mm_castps_si128(_mm256_castps256_ps128(fltValues)), fltMagnitudeMask);
+	__m128i fltHigh          = _mm_and_si128(_mm_castps_si128(_mm256_extractf128_ps(fltValues, 1)), fltMagnitudeMask);
+
+	return _mm_packs_epi32(_mm_cmpeq_epi32(fltLow, _mm_setzero_si128()), _mm_cmpeq_epi32(fltHigh, _mm_setzero_si128()));
+}
+
+//
+// Determines which of eight double values are +-0.
+//
+// [in] dblValues1 - the first four double values
+// [in] dblValues2 - the last four double values
+//
+// Returns a mask with all 16 bits set in the lanes of the zeros.
+//
+SBFP_TARGET_F16C
+static inline __m128i zero_mask_double(__m256d dblValues1, __m256d dblValues2)
+{
+	__m128i dblMagnitudeMask = _mm_set1_epi64x((long long)DOUBLE_MAGNITUDE_MASK);
+
+	__m128i isZero[4];
+
+	isZero[0] = _mm_and_si128(_mm_castpd_si128(_mm256_castpd256_pd128(dblValues1)), dblMagnitudeMask);
+	isZero[1] = _mm_and_si128(_mm_castpd_si128(_mm256_extractf128_pd(dblValues1, 1)), dblMagnitudeMask);
+	isZero[2] = _mm_and_si128(_mm_castpd_si128(_mm256_castpd256_pd128(dblValues2)), dblMagnitudeMask);
+	isZero[3] = _mm_and_si128(_mm_castpd_si128(_mm256_extractf128_pd(dblValues2, 1)), dblMagnitudeMask);
+
+	for (int part = 0; part < 4; ++part)
+	{
+		isZero[part] = _mm_cmpeq_epi64(isZero[part], _mm_setzero_si128());
+	}
+
+	//
+	// Narrow the 64-bit lanes to 32 bits, then to 16 bits:
+	//
+	__m128 isZeroLow  = _mm_shuffle_ps(_mm_castsi128_ps(isZero[0]), _mm_castsi128_ps(isZero[1]), _MM_SHUFFLE(2, 0, 2, 0));
+	__m128 isZeroHigh = _mm_shuffle_ps(_mm_castsi128_ps(isZero[2]), _mm_castsi128_ps(isZero[3]), _MM_SHUFFLE(2, 0, 2, 0));
+
+	return _mm_packs_epi32(_mm_castps_si128(isZeroLow), _mm_castps_si128(isZeroHigh));
+}
+
+//
+// Widens eight 16-bit sbfp values to sbfp_t and stores them.
+//
+// [in]  halves     - the sbfp values
+// [out] sbfpValues - where to store them
+//
+SBFP_TARGET_F16C
+static inline void store_halves(__m128i halves, sbfp_t *sbfpValues)
+{
+	_mm_storeu_si128((__m128i *)sbfpValues, _mm_unpacklo_epi16(halves, _mm_setzero_si128()));
+	_mm_storeu_si128((__m128i *)(sbfpValues + 4), _mm_unpackhi_epi16(halves, _mm_setzero_si128()));
+}
+
+//
+// Loads eight sbfp_t values and narrows them to their low 16 bits.
+//
+// [in] sbfpValues - the sbfp values
+//
+// Returns the 16-bit sbfp values.
+//
+SBFP_TARGET_F16C
+static inline __m128i load_halves(const sbfp_t *sbfpValues)
+{
+	__m128i sbfpMask = _mm_set1_epi32(SBFP_BIT_MASK);
+	__m128i low      = _mm_and_si128(_mm_loadu_si128((const __m128i *)sbfpValues), sbfpMask);
+	__m128i high     = _mm_and_si128(_mm_loadu_si128((const __m128i *)(sbfpValues + 4)), sbfpMask);
+
+	return _mm_packus_epi32(low, high);
+}
+
+//
+// Decodes eight 16-bit sbfp values to floats, with NaN decoded as FLOAT_NAN_BITS (see
+// sbfp_to_float).
+//
+// [in] halves - the sbfp values
+//
+// Returns the float values.
+//
+SBFP_TARGET_F16C
+static inline __m256 decode_halves(__m128i halves)
+{
+	__m128i sbfpMagnitude = _mm_and_si128(halves, _mm_set1_epi16(SBFP_BIT_MASK >> SBFP_BIT_COUNT_SIGN));
+	__m128i isNan         = _mm_cmpgt_epi16(sbfpMagnitude, _mm_set1_epi16(SBFP_EXPO_MASK << SBFP_BIT_COUNT_FRAC));
+
+	__m256 isNanWide = _mm256_set_m128(_mm_castsi128_ps(_mm_unpackhi_epi16(isNan, isNan)),
+	                                   _mm_castsi128_ps(_mm_unpacklo_epi16(isNan, isNan)));
+
+	__m256 fltNan = _mm256_castsi256_ps(_mm256_set1_epi32((int)FLOAT_NAN_BITS));
+
+	return _mm256_or_ps(_mm256_andnot_ps(isNanWide, _mm256_cvtph_ps(halves)), _mm256_and_ps(isNanWide, fltNan));
+}
+
+//
+// Narrows four double values to float, rounding them to odd. Clearing the low 29 frac bits
+// truncates each double to float precision, so the conversion to float is exact, and the
+// values that were not already exact get the lowest float frac bit. A float has 13 more
+// significant bits than a binary16 value, so rounding it to nearest even then rounds like
+// the double would. A NaN compares unequal to itself, so it keeps the lowest float frac
+// bit as well, and does not become infinity when its payload lies only in the low bits.
+//
+// [in] dblValues - the double values to be narrowed
+//
+// Returns the float values.
+//
+SBFP_TARGET_F16C
+static inline __m128 narrow_doubles_f16c(__m256d dblValues)
+{
+	__m256d truncMask = _mm256_castsi256_pd(_mm256_set1_epi64x(
+		(long long)~((1ULL << (DOUBLE_BIT_COUNT_FRAC - FLOAT_BIT_COUNT_FRAC)) - 1)));
+	__m256d oddBit    = _mm256_castsi256_pd(_mm256_set1_epi64x(
+		(long long)(1ULL << (DOUBLE_BIT_COUNT_FRAC - FLOAT_BIT_COUNT_FRAC))));
+
+	__m256d truncated = _mm256_and_pd(dblValues, truncMask);
+	__m256d isInexact = _mm256_cmp_pd(truncated, dblValues, _CMP_NEQ_UQ);
+
+	return _mm256_cvtpd_ps(_mm256_or_pd(truncated, _mm256_and_pd(isInexact, oddBit)));
+}
+
+//
+// Converts eight double values to 16-bit sbfp values with F16C (see double_to_sbfp).
+//
+// [in] dblValues - the double values to be converted
+//
+// Returns the sbfp values.
+//
+SBFP_TARGET_F16C
+static inline __m128i encode_doubles_f16c(const double *dblValues)
+{
+	//
+	// Round the doubles to odd float values, which VCVTPS2PH rounds as it would the doubles:
+	//
+	__m256d dblValues1 = _mm256_loadu_pd(dblValues);
+	__m256d dblValues2 = _mm256_loadu_pd(dblValues + 4);
+
+	__m256 fltValues = _mm256_set_m128(narrow_doubles_f16c(dblValues2), narrow_doubles_f16c(dblValues1));
+
+	__m128i halves = _mm256_cvtps_ph(fltValues, _MM_FROUND_TO_NEAREST_INT);
+
+#if !SBFP_SIGNED_ZERO
+	halves = _mm_andnot_si128(zero_mask_double(dblValues1, dblValues2), halves);
+#endif
+
+	return translate_halves(halves, fltValues);
+}
+
+//
+// Converts eight float values to 16-bit sbfp values with F16C (see float_to_sbfp).
+//
+// [in] fltValues - the float values to be converted
+//
+// Returns the sbfp values.
+//
+SBFP_TARGET_F16C
+static inline __m128i encode_floats_f16c(const float *fltValues)
+{
+	__m256 fltValues8 = _mm256_loadu_ps(fltValues);
+
+	__m128i halves = _mm256_cvtps_ph(fltValues8, _MM_FROUND_TO_NEAREST_INT);
+
+#if !SBFP_SIGNED_ZERO
+	halves = _mm_andnot_si128(zero_mask_float(fltValues8), halves);
+#endif
+
+	return translate_halves(halves, fltValues8);
+}
+
+//
+// Converts an array of double values to the sbfp_t type with F16C (see double_to_sbfp).
+//
+// [in]  dblValues  - the double values to be converted
+// [out] sbfpValues - the converted values
+// [in]  count      - the number of values available
+//
+// Returns the number of values converted, a multiple of 8. The caller converts the rest.
+//
+SBFP_TARGET_F16C
+size_t sbfp_f16c_double_to_sbfp(const double *dblValues, sbfp_t *sbfpValues, size_t count)
+{
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		store_halves(encode_doubles_f16c(dblValues + index), sbfpValues + index);
+	}
+
+	return index;
+}
+
+//
+// Converts an array of sbfp_t values to double values with F16C (see sbfp_to_double).
+//
+// [in]  sbfpValues - the sbfp values to be converted
+// [out] dblValues  - the converted values
+// [in]  count      - the number of values available
+//
+// Returns the number of values converted, a multiple of 8. The caller converts the rest.
+//
+SBFP_TARGET_F16C
+size_t sbfp_f16c_sbfp_to_double(const sbfp_t *sbfpValues, double *dblValues, size_t count)
+{
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		store_doubles(decode_halves(load_halves(sbfpValues + index)), dblValues + index);
+	}
+
+	return index;
+}
+
+//
+// Converts an array of float values to the sbfp_t type with F16C (see float_to_sbfp).
+//
+// [in]  fltValues  - the float values to be converted
+// [out] sbfpValues - the converted values
+// [in]  count      - the number of values available
+//
+// Returns the number of values converted, a multiple of 8. The caller converts the rest.
+//
+SBFP_TARGET_F16C
+size_t sbfp_f16c_float_to_sbfp(const float *fltValues, sbfp_t *sbfpValues, size_t count)
+{
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		store_halves(encode_floats_f16c(fltValues + index), sbfpValues + index);
+	}
+
+	return index;
+}
+
+//
+// Converts an array of sbfp_t values to float values with F16C (see sbfp_to_float).
+//
+// [in]  sbfpValues - the sbfp values to be converted
+// [out] fltValues  - the converted values
+// [in]  count      - the number of values available
+//
+// Returns the number of values converted, a multiple of 8. The caller converts the rest.
+//
+SBFP_TARGET_F16C
+size_t sbfp_f16c_sbfp_to_float(const sbfp_t *sbfpValues, float *fltValues, size_t count)
+{
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		_mm256_storeu_ps(fltValues + index, decode_halves(load_halves(sbfpValues + index)));
+	}
+
+	return index;
+}
+
+//
+// Converts an array of double values to the sbfp16_t type with F16C (see double_to_sbfp).
+//
+// [in]  dblValues  - the double values to be converted
+// [out] sbfpValues - the converted values
+// [in]  count      - the number of values available
+//
+// Returns the number of values converted, a multiple of 8. The caller converts the rest.
+//
+SBFP_TARGET_F16C
+size_t sbfp_f16c_double_to_sbfp16(const double *dblValues, sbfp16_t *sbfpValues, size_t count)
+{
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		_mm_storeu_si128((__m128i *)(sbfpValues + index), encode_doubles_f16c(dblValues + index));
+	}
+
+	return index;
+}
+
+//
+// Converts an array of sbfp16_t values to double values with F16C (see sbfp_to_double).
+//
+// [in]  sbfpValues - the sbfp values to be converted
+// [out] dblValues  - the converted values
+// [in]  count      - the number of values available
+//
+// Returns the number of values converted, a multiple of 8. The caller converts the rest.
+//
+SBFP_TARGET_F16C
+size_t sbfp_f16c_sbfp16_to_double(const sbfp16_t *sbfpValues, double *dblValues, size_t count)
+{
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		store_doubles(decode_halves(_mm_loadu_si128((const __m128i *)(sbfpValues + index))), dblValues + index);
+	}
+
+	return index;
+}
+
+//
+// Converts an array of float values to the sbfp16_t type with F16C (see float_to_sbfp).
+//
+// [in]  fltValues  - the float values to be converted
+// [out] sbfpValues - the converted values
+// [in]  count      - the number of values available
+//
+// Returns the number of values converted, a multiple of 8. The caller converts the rest.
+//
+SBFP_TARGET_F16C
+size_t sbfp_f16c_float_to_sbfp16(const float *fltValues, sbfp16_t *sbfpValues, size_t count)
+{
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		_mm_storeu_si128((__m128i *)(sbfpValues + index), encode_floats_f16c(fltValues + index));
+	}
+
+	return index;
+}
+
+//
+// Converts an array of sbfp16_t values to float values with F16C (see sbfp_to_float).
+//
+// [in]  sbfpValues - the sbfp values to be converted
+// [out] fltValues  - the converted values
+// [in]  count      - the number of values available
+//
+// Returns the number of values converted, a multiple of 8. The caller converts the rest.
+//
+SBFP_TARGET_F16C
+size_t sbfp_f16c_sbfp16_to_float(const sbfp16_t *sbfpValues, float *fltValues, size_t count)
+{
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		_mm256_storeu_ps(fltValues + index, decode_halves(_mm_loadu_si128((const __m128i *)(sbfpValues + index))));
+	}
+
+	return index;
+}
+
+//
+// Encodes four double values in 64-bit lanes (see sbfp_core_encode_double).
+//
+// [in] dblValues - the double values
+//
+// Returns the sbfp values, one per 64-bit lane.
+//
+SBFP_TARGET_AVX2
+static inline __m256i encode_double_avx2(__m256d dblValues)
+{
+	__m256i dblBits = _mm256_castpd_si256(dblValues);
+
+	//
+	// Extract the magnitude, expo and sign (treating 0 as positive unless SBFP_SIGNED_ZERO):
+	//
+	__m256i dblMagnitude = _mm256_and_si256(dblBits, _mm256_set1_epi64x((long long)DOUBLE_MAGNITUDE_MASK));
+	__m256i dblExpo      = _mm256_srli_epi64(dblMagnitude, DOUBLE_BIT_COUNT_FRAC);
+
+	__m256i sbfpSign = _mm256_srli_epi64(dblBits, DOUBLE_BIT_COUNT_EXPO + DOUBLE_BIT_COUNT_FRAC);
+
+#if !SBFP_SIGNED_ZERO
+	sbfpSign = _mm256_andnot_si256(_mm256_cmpeq_epi64(dblMagnitude, _mm256_setzero_si256()), sbfpSign);
+#endif
+
+	//
+	// Normal: rebias the expo and keep the top frac bits, rounded to nearest even by adding
+	// the last kept bit and just under half of it before the shift. A carry out of the frac
+	// simply moves to the next expo:
+	//
+	const int dropNormal = DOUBLE_BIT_COUNT_FRAC - SBFP_BIT_COUNT_FRAC;
+
+	__m256i one = _mm256_set1_epi64x(1);
+
+	__m256i lsbNormal  = _mm256_and_si256(_mm256_srli_epi64(dblMagnitude, dropNormal), one);
+	__m256i sbfpNormal = _mm256_add_epi64(dblMagnitude, _mm256_add_epi64(lsbNormal, _mm256_set1_epi64x((1LL << (dropNormal - 1)) - 1)));
+
+	sbfpNormal = _mm256_sub_epi64(_mm256_srli_epi64(sbfpNormal, dropNormal),
+	                              _mm256_set1_epi64x((long long)(DOUBLE_BIAS - SBFP_BIAS) << SBFP_BIT_COUNT_FRAC));
+
+	//
+	// Subnormal: shift the full significand down to units of 2^-24, rounded the same way.
+	// VPSRLVQ and VPSLLVQ yield 0 for shifts of 64 and above, so values far below the sbfp
+	// range become 0 without a clamp:
+	//
+	__m256i dblSig   = _mm256_or_si256(_mm256_and_si256(dblMagnitude, _mm256_set1_epi64x((long long)DOUBLE_FRAC_MASK)),
+	                                   _mm256_set1_epi64x((long long)(1ULL << DOUBLE_BIT_COUNT_FRAC)));
+	__m256i subShift = _mm256_sub_epi64(_mm256_set1_epi64x(DOUBLE_SBFP_SUBNORMAL_SHIFT), dblExpo);
+
+	__m256i lsbSubnormal  = _mm256_and_si256(_mm256_srlv_epi64(dblSig, subShift), one);
+	__m256i halfSubnormal = _mm256_sub_epi64(_mm256_sllv_epi64(one, _mm256_sub_epi64(subShift, one)), one);
+	__m256i sbfpSubnormal = _mm256_srlv_epi64(_mm256_add_epi64(dblSig, _mm256_add_epi64(lsbSubnormal, halfSubnormal)), subShift);
+
+	__m256i isNormal = _mm256_cmpgt_epi64(dblExpo, _mm256_set1_epi64x(DOUBLE_BIAS - SBFP_BIAS));
+	__m256i sbfpBits = _mm256_blendv_epi8(sbfpSubnormal, sbfpNormal, isNormal);
+
+	//
+	// Magnitudes that round to 2^16 or above overflow:
+	//
+	__m256i isOverflow = _mm256_cmpgt_epi64(sbfpBits, _mm256_set1_epi64x(BINARY16_MAX));
+
+#if SBFP_ZERO_MIN_NORMAL
+	//
+	// Magnitudes that round to 2^-14 become the largest subnormal, or the next value up if
+	// they are above 2^-14:
+	//
+	__m256i isMinNormal = _mm256_cmpeq_epi64(sbfpBits, _mm256_set1_epi64x(1 << SBFP_BIT_COUNT_FRAC));
+	__m256i isAbove     = _mm256_cmpgt_epi64(dblMagnitude, _mm256_set1_epi64x((long long)DOUBLE_SBFP_MIN_NORMAL_BITS));
+	__m256i neighbour   = _mm256_blendv_epi8(_mm256_set1_epi64x(SBFP_FRAC_MASK), _mm256_set1_epi64x((1 << SBFP_BIT_COUNT_FRAC) + 1), isAbove);
+
+	sbfpBits = _mm256_blendv_epi8(sbfpBits, neighbour, isMinNormal);
+#endif
+
+	//
+	// Concatenate the sign:
+	//
+	sbfpBits = _mm256_or_si256(sbfpBits, _mm256_slli_epi64(sbfpSign, SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC));
+
+	//
+	// Determine infinity and NaN:
+	//
+	__m256i isNan      = _mm256_cmpgt_epi64(dblMagnitude, _mm256_set1_epi64x((long long)DOUBLE_INF_BITS));
+	__m256i isNegative = _mm256_cmpeq_epi64(sbfpSign, _mm256_set1_epi64x(1));
+
+	__m256i sbfpInf = _mm256_blendv_epi8(_mm256_set1_epi64x(SBFP_POS_INF), _mm256_set1_epi64x(SBFP_NEG_INF), isNegative);
+
+	sbfpBits = _mm256_blendv_epi8(sbfpBits, sbfpInf, isOverflow);
+	sbfpBits = _mm256_blendv_epi8(sbfpBits, _mm256_set1_epi64x(SBFP_NAN), isNan);
+
+	return sbfpBits;
+}
+
+//
+// Encodes eight float values in 32-bit lanes (see sbfp_core_encode_float).
+//
+// [in] fltValues - the float values
+//
+// Returns the sbfp values, one per 32-bit lane.
+//
+SBFP_TARGET_AVX2
+static inline __m256i encode_float_avx2(__m256 fltValues)
+{
+	__m256i fltBits = _mm256_castps_si256(fltValues);
+
+	//
+	// Extract the magnitude, expo and sign (treating 0 as positive unless SBFP_SIGNED_ZERO):
+	//
+	__m256i fltMagnitude = _mm256_and_si256(fltBits, _mm256_set1_epi32(FLOAT_MAGNITUDE_MASK));
+	__m256i fltExpo      = _mm256_srli_epi32(fltMagnitude, FLOAT_BIT_COUNT_FRAC);
+
+	__m256i sbfpSign = _mm256_srli_epi32(fltBits, FLOAT_BIT_COUNT_EXPO + FLOAT_BIT_COUNT_FRAC);
+
+#if !SBFP_SIGNED_ZERO
+	sbfpSign = _mm256_andnot_si256(_mm256_cmpeq_epi32(fltMagnitude, _mm256_setzero_si256()), sbfpSign);
+#endif
+
+	//
+	// Normal: rebias the expo and keep the top frac bits, rounded to nearest even (see
+	// encode_double_avx2):
+	//
+	const int dropNormal = FLOAT_BIT_COUNT_FRAC - SBFP_BIT_COUNT_FRAC;
+
+	__m256i one = _mm256_set1_epi32(1);
+
+	__m256i lsbNormal  = _mm256_and_si256(_mm256_srli_epi32(fltMagnitude, dropNormal), one);
+	__m256i sbfpNormal = _mm256_add_epi32(fltMagnitude, _mm256_add_epi32(lsbNormal, _mm256_set1_epi32((1 << (dropNormal - 1)) - 1)));
+
+	sbfpNormal = _mm256_sub_epi32(_mm256_srli_epi32(sbfpNormal, dropNormal),
+	                              _mm256_set1_epi32((FLOAT_BIAS - SBFP_BIAS) << SBFP_BIT_COUNT_FRAC));
+
+	//
+	// Subnormal: shift the full significand down to units of 2^-24, rounded the same way.
+	// VPSRLVD and VPSLLVD yield 0 for shifts of 32 and above, so values far below the sbfp
+	// range become 0 without a clamp:
+	//
+	__m256i fltSig   = _mm256_or_si256(_mm256_and_si256(fltMagnitude, _mm256_set1_epi32(FLOAT_FRAC_MASK)),
+	                                   _mm256_set1_epi32(1 << FLOAT_BIT_COUNT_FRAC));
+	__m256i subShift = _mm256_sub_epi32(_mm256_set1_epi32(FLOAT_SBFP_SUBNORMAL_SHIFT), fltExpo);
+
+	__m256i lsbSubnormal  = _mm256_and_si256(_mm256_srlv_epi32(fltSig, subShift), one);
+	__m256i halfSubnormal = _mm256_sub_epi32(_mm256_sllv_epi32(one, _mm256_sub_epi32(subShift, one)), one);
+	__m256i sbfpSubnormal = _mm256_srlv_epi32(_mm256_add_epi32(fltSig, _mm256_add_epi32(lsbSubnormal, halfSubnormal)), subShift);
+
+	__m256i isNormal = _mm256_cmpgt_epi32(fltExpo, _mm256_set1_epi32(FLOAT_BIAS - SBFP_BIAS));
+	__m256i sbfpBits = _mm256_blendv_epi8(sbfpSubnormal, sbfpNormal, isNormal);
+
+	//
+	// Magnitudes that round to 2^16 or above overflow:
+	//
+	__m256i isOverflow = _mm256_cmpgt_epi32(sbfpBits, _mm256_set1_epi32(BINARY16_MAX));
+
+#if SBFP_ZERO_MIN_NORMAL
+	//
+	// Magnitudes that round to 2^-14 become the largest subnormal, or the next value up if
+	// they are above 2^-14:
+	//
+	__m256i isMinNormal = _mm256_cmpeq_epi32(sbfpBits, _mm256_set1_epi32(1 << SBFP_BIT_COUNT_FRAC));
+	__m256i isAbove     = _mm256_cmpgt_epi32(fltMagnitude, _mm256_set1_epi32(FLOAT_SBFP_MIN_NORMAL_BITS));
+	__m256i neighbour   = _mm256_blendv_epi8(_mm256_set1_epi32(SBFP_FRAC_MASK), _mm256_set1_epi32((1 << SBFP_BIT_COUNT_FRAC) + 1), isAbove);
+
+	sbfpBits = _mm256_blendv_epi8(sbfpBits, neighbour, isMinNormal);
+#endif
+
+	//
+	// Concatenate the sign:
+	//
+	sbfpBits = _mm256_or_si256(sbfpBits, _mm256_slli_epi32(sbfpSign, SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC));
+
+	//
+	// Determine infinity and NaN:
+	//
+	__m256i isNan      = _mm256_cmpgt_epi32(fltMagnitude, _mm256_set1_epi32(FLOAT_INF_BITS));
+	__m256i isNegative = _mm256_cmpeq_epi32(sbfpSign, _mm256_set1_epi32(1));
+
+	__m256i sbfpInf = _mm256_blendv_epi8(_mm256_set1_epi32(SBFP_POS_INF), _mm256_set1_epi32(SBFP_NEG_INF), isNegative);
+
+	sbfpBits = _mm256_blendv_epi8(sbfpBits, sbfpInf, isOverflow);
+	sbfpBits = _mm256_blendv_epi8(sbfpBits, _mm256_set1_epi32(SBFP_NAN), isNan);
+
+	return sbfpBits;
+}
+
+//
+// Decodes eight sbfp_t values in 32-bit lanes to floats (see sbfp_core_decode_float).
+//
+// [in] sbfpValues - the sbfp values
+//
+// Returns the float values.
+//
+SBFP_TARGET_AVX2
+static inline __m256 decode_float_avx2(__m256i sbfpValues)
+{
+	//
+	// Extract the magnitude, frac, expo and sign:
+	//
+	__m256i sbfpMagnitude = _mm256_and_si256(sbfpValues, _mm256_set1_epi32(SBFP_BIT_MASK >> SBFP_BIT_COUNT_SIGN));
+	__m256i sbfpFrac      = _mm256_and_si256(sbfpMagnitude, _mm256_set1_epi32(SBFP_FRAC_MASK));
+	__m256i sbfpExpo      = _mm256_srli_epi32(sbfpMagnitude, SBFP_BIT_COUNT_FRAC);
+
+	__m256i fltSign = _mm256_and_si256(_mm256_slli_epi32(sbfpValues, 16), _mm256_set1_epi32((int)(1U << 31)));
+
+	//
+	// Normal: move the expo and frac into place together and rebias the expo:
+	//
+	__m256i fltNormal = _mm256_add_epi32(_mm256_slli_epi32(sbfpMagnitude, FLOAT_BIT_COUNT_FRAC - SBFP_BIT_COUNT_FRAC),
+	                                     _mm256_set1_epi32((FLOAT_BIAS - SBFP_BIAS) << FLOAT_BIT_COUNT_FRAC));
+
+	//
+	// Subnormal: the frac counts units of 2^-24, which converts to float exactly:
+	//
+	__m256i fltSubnormal = _mm256_castps_si256(_mm256_mul_ps(_mm256_cvtepi32_ps(sbfpFrac),
+	                                           _mm256_set1_ps(1.0F / (1 << (SBFP_BIAS - 1 + SBFP_BIT_COUNT_FRAC)))));
+
+	//
+	// Select the case, concatenate the sign (NaN has none) and return:
+	//
+	__m256i isSubnormal = _mm256_cmpeq_epi32(sbfpExpo, _mm256_setzero_si256());
+	__m256i isSpecial   = _mm256_cmpeq_epi32(sbfpExpo, _mm256_set1_epi32(SBFP_EXPO_MASK));
+	__m256i isNan       = _mm256_andnot_si256(_mm256_cmpeq_epi32(sbfpFrac, _mm256_setzero_si256()), isSpecial);
+
+	__m256i fltBits = _mm256_blendv_epi8(fltNormal, fltSubnormal, isSubnormal);
+
+	fltBits = _mm256_blendv_epi8(fltBits, _mm256_set1_epi32((int)FLOAT_INF_BITS), isSpecial);
+	fltBits = _mm256_or_si256(fltBits, fltSign);
+	fltBits = _mm256_blendv_epi8(fltBits, _mm256_set1_epi32((int)FLOAT_NAN_BITS), isNan);
+
+	return _mm256_castsi256_ps(fltBits);
+}
+
+//
+// Converts eight double values to sbfp values in 32-bit lanes with AVX2 (see
+// double_to_sbfp).
+//
+// [in] dblValues - the double values to be converted
+//
+// Returns the sbfp values.
+//
+SBFP_TARGET_AVX2
+static inline __m256i encode_doubles_avx2(const double *dblValues)
+{
+	//
+	// Gathers the low halves of the 64-bit lanes of two vectors into one vector of 32-bit
+	// lanes:
+	//
+	__m256i lowIndices = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+
+	__m256i sbfpBits1 = encode_double_avx2(_mm256_loadu_pd(dblValues));
+	__m256i sbfpBits2 = encode_double_avx2(_mm256_loadu_pd(dblValues + 4));
+
+	return _mm256_blend_epi32(_mm256_permutevar8x32_epi32(sbfpBits1, lowIndices),
+	                          _mm256_permutevar8x32_epi32(sbfpBits2, lowIndices), 0xF0);
+}
+
+//
+// Narrows eight sbfp values in 32-bit lanes to 16 bits and stores them.
+//
+// [in]  sbfpBits   - the sbfp values
+// [out] sbfpValues - where to store them
+//
+SBFP_TARGET_AVX2
+static inline void store_sbfp16_avx2(__m256i sbfpBits, sbfp16_t *sbfpValues)
+{
+	_mm_storeu_si128((__m128i *)sbfpValues, _mm_packus_epi32(_mm256_castsi256_si128(sbfpBits), _mm256_extracti128_si256(sbfpBits, 1)));
+}
+
+//
+// Loads eight sbfp16_t values and widens them to 32-bit lanes.
+//
+// [in] sbfpValues - the sbfp values
+//
+// Returns the sbfp values in 32-bit lanes.
+//
+SBFP_TARGET_AVX2
+static inline __m256i load_sbfp16_avx2(const sbfp16_t *sbfpValues)
+{
+	return _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)sbfpValues));
+}
+
+//
+// Converts an array of double values to the sbfp_t type with AVX2 (see double_to_sbfp).
+//
+// [in]  dblValues  - the double values to be converted
+// [out] sbfpValues - the converted values
+// [in]  count      - the number of values available
+//
+// Returns the number of values converted, a multiple of 8. The caller converts the rest.
+//
+SBFP_TARGET_AVX2
+size_t sbfp_avx2_double_to_sbfp(const double *dblValues, sbfp_t *sbfpValues, size_t count)
+{
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		_mm256_storeu_si256((__m256i *)(sbfpValues + index), encode_doubles_avx2(dblValues + index));
+	}
+
+	return index;
+}
+
+//
+// Converts an array of sbfp_t values to double values with AVX2 (see sbfp_to_double).
+//
+// [in]  sbfpValues - the sbfp values to be converted
+// [out] dblValues  - the converted values
+// [in]  count      - the number of values available
+//
+// Returns the number of values converted, a multiple of 8. The caller converts the rest.
+//
+SBFP_TARGET_AVX2
+size_t sbfp_avx2_sbfp_to_double(const sbfp_t *sbfpValues, double *dblValues, size_t count)
+{
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		store_doubles(decode_float_avx2(_mm256_loadu_si256((const __m256i *)(sbfpValues + index))), dblValues + index);
+	}
+
+	return index;
+}
+
+//
+// Converts an array of float values to the sbfp_t type with AVX2 (see float_to_sbfp).
+//
+// [in]  fltValues  - the float values to be converted
+// [out] sbfpValues - the converted values
+// [in]  count      - the number of values available
+//
+// Returns the number of values converted, a multiple of 8. The caller converts the rest.
+//
+SBFP_TARGET_AVX2
+size_t sbfp_avx2_float_to_sbfp(const float *fltValues, sbfp_t *sbfpValues, size_t count)
+{
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		_mm256_storeu_si256((__m256i *)(sbfpValues + index), encode_float_avx2(_mm256_loadu_ps(fltValues + index)));
+	}
+
+	return index;
+}
+
+//
+// Converts an array of sbfp_t values to float values with AVX2 (see sbfp_to_float).
+//
+// [in]  sbfpValues - the sbfp values to be converted
+// [out] fltValues  - the converted values
+// [in]  count      - the number of values available
+//
+// Returns the number of values converted, a multiple of 8. The caller converts the rest.
+//
+SBFP_TARGET_AVX2
+size_t sbfp_avx2_sbfp_to_float(const sbfp_t *sbfpValues, float *fltValues, size_t count)
+{
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		_mm256_storeu_ps(fltValues + index, decode_float_avx2(_mm256_loadu_si256((const __m256i *)(sbfpValues + index))));
+	}
+
+	return index;
+}
+
+//
+// Converts an array of double values to the sbfp16_t type with AVX2 (see double_to_sbfp).
+//
+// [in]  dblValues  - the double values to be converted
+// [out] sbfpValues - the converted values
+// [in]  count      - the number of values available
+//
+// Returns the number of values converted, a multiple of 8. The caller converts the rest.
+//
+SBFP_TARGET_AVX2
+size_t sbfp_avx2_double_to_sbfp16(const double *dblValues, sbfp16_t *sbfpValues, size_t count)
+{
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		store_sbfp16_avx2(encode_doubles_avx2(dblValues + index), sbfpValues + index);
+	}
+
+	return index;
+}
+
+//
+// Converts an array of sbfp16_t values to double values with AVX2 (see sbfp_to_double).
+//
+// [in]  sbfpValues - the sbfp values to be converted
+// [out] dblValues  - the converted values
+// [in]  count      - the number of values available
+//
+// Returns the number of values converted, a multiple of 8. The caller converts the rest.
+//
+SBFP_TARGET_AVX2
+size_t sbfp_avx2_sbfp16_to_double(const sbfp16_t *sbfpValues, double *dblValues, size_t count)
+{
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		store_doubles(decode_float_avx2(load_sbfp16_avx2(sbfpValues + index)), dblValues + index);
+	}
+
+	return index;
+}
+
+//
+// Converts an array of float values to the sbfp16_t type with AVX2 (see float_to_sbfp).
+//
+// [in]  fltValues  - the float values to be converted
+// [out] sbfpValues - the converted values
+// [in]  count      - the number of values available
+//
+// Returns the number of values converted, a multiple of 8. The caller converts the rest.
+//
+SBFP_TARGET_AVX2
+size_t sbfp_avx2_float_to_sbfp16(const float *fltValues, sbfp16_t *sbfpValues, size_t count)
+{
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		store_sbfp16_avx2(encode_float_avx2(_mm256_loadu_ps(fltValues + index)), sbfpValues + index);
+	}
+
+	return index;
+}
+
+//
+// Converts an array of sbfp16_t values to float values with AVX2 (see sbfp_to_float).
+//
+// [in]  sbfpValues - the sbfp values to be converted
+// [out] fltValues  - the converted values
+// [in]  count      - the number of values available
+//
+// Returns the number of values converted, a multiple of 8. The caller converts the rest.
+//
+SBFP_TARGET_AVX2
+size_t sbfp_avx2_sbfp16_to_float(const sbfp16_t *sbfpValues, float *fltValues, size_t count)
+{
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		_mm256_storeu_ps(fltValues + index, decode_float_avx2(load_sbfp16_avx2(sbfpValues + index)));
+	}
+
+	return index;
+}
+
+//
+// Encodes eight float values in 32-bit lanes to an 8-bit format (see float_to_sbfp8).
+//
+// [in] fltValues - the float values
+// [in] format    - SBFP8_E4M3 or SBFP8_E5M2 (a constant, so that the kernel is specialized)
+//
+// Returns the sbfp8_t values, one per 32-bit lane.
+//
+SBFP_TARGET_AVX2
+static inline __m256i encode_sbfp8_avx2(__m256 fltValues, int format)
+{
+	const int fracBits = (format == SBFP8_E5M2) ? E5M2_BIT_COUNT_FRAC : E4M3_BIT_COUNT_FRAC;
+	const int expoBits = (format == SBFP8_E5M2) ? E5M2_BIT_COUNT_EXPO : E4M3_BIT_COUNT_EXPO;
+	const int bias     = (format == SBFP8_E5M2) ? E5M2_BIAS : E4M3_BIAS;
+	const int maxBits  = (format == SBFP8_E5M2) ? E5M2_MAX : E4M3_MAX;
+
+	__m256i fltBits = _mm256_castps_si256(fltValues);
+
+	//
+	// Extract the magnitude, expo and sign:
+	//
+	__m256i fltMagnitude = _mm256_and_si256(fltBits, _mm256_set1_epi32(FLOAT_MAGNITUDE_MASK));
+	__m256i fltExpo      = _mm256_srli_epi32(fltMagnitude, FLOAT_BIT_COUNT_FRAC);
+
+	__m256i sbfp8Sign = _mm256_srli_epi32(fltBits, FLOAT_BIT_COUNT_EXPO + FLOAT_BIT_COUNT_FRAC);
+
+	//
+	// Normal: rebias the expo and keep the top frac bits:
+	//
+	__m256i sbfp8Normal = _mm256_sub_epi32(_mm256_srli_epi32(fltMagnitude, FLOAT_BIT_COUNT_FRAC - fracBits),
+	                                       _mm256_set1_epi32((FLOAT_BIAS - bias) << fracBits));
+
+	//
+	// Subnormal: shift the full significand down to units of the smallest subnormal:
+	//
+	__m256i fltSig   = _mm256_or_si256(_mm256_and_si256(fltMagnitude, _mm256_set1_epi32(FLOAT_FRAC_MASK)),
+	                                   _mm256_set1_epi32(1 << FLOAT_BIT_COUNT_FRAC));
+	__m256i subShift = _mm256_sub_epi32(_mm256_set1_epi32(FLOAT_BIAS + FLOAT_BIT_COUNT_FRAC - (bias - 1) - fracBits), fltExpo);
+
+	__m256i sbfp8Subnormal = _mm256_srlv_epi32(fltSig, subShift);
+
+	__m256i isNormal  = _mm256_cmpgt_epi32(fltExpo, _mm256_set1_epi32(FLOAT_BIAS - bias));
+	__m256i sbfp8Bits = _mm256_blendv_epi8(sbfp8Subnormal, sbfp8Normal, isNormal);
+
+	//
+	// Beyond the largest finite value, E5M2 overflows to infinity and E4M3, which has none,
+	// saturates. Infinity takes the same path:
+	//
+	__m256i isOverflow = _mm256_cmpgt_epi32(sbfp8Bits, _mm256_set1_epi32(maxBits));
+	__m256i isNan      = _mm256_cmpgt_epi32(fltMagnitude, _mm256_set1_epi32(FLOAT_INF_BITS));
+
+	sbfp8Bits = _mm256_blendv_epi8(sbfp8Bits, _mm256_set1_epi32((format == SBFP8_E5M2) ? E5M2_POS_INF : E4M3_MAX), isOverflow);
+
+	//
+	// Concatenate the sign, and determine NaN:
+	//
+	sbfp8Bits = _mm256_or_si256(sbfp8Bits, _mm256_slli_epi32(sbfp8Sign, expoBits + fracBits));
+	sbfp8Bits = _mm256_blendv_epi8(sbfp8Bits, _mm256_set1_epi32((format == SBFP8_E5M2) ? E5M2_NAN : E4M3_NAN), isNan);
+
+	return sbfp8Bits;
+}
+
+//
+// Decodes eight values of an 8-bit format in 32-bit lanes to float values (see
+// sbfp8_to_float).
+//
+// [in] sbfp8Values - the sbfp8_t values, one per 32-bit lane
+// [in] format      - SBFP8_E4M3 or SBFP8_E5M2 (a constant, so that the kernel is specialized)
+//
+// Returns the float values.
+//
+SBFP_TARGET_AVX2
+static inline __m256 decode_sbfp8_avx2(__m256i sbfp8Values, int format)
+{
+	const int fracBits = (format == SBFP8_E5M2) ? E5M2_BIT_COUNT_FRAC : E4M3_BIT_COUNT_FRAC;
+	const int expoBits = (format == SBFP8_E5M2) ? E5M2_BIT_COUNT_EXPO : E4M3_BIT_COUNT_EXPO;
+	const int bias     = (format == SBFP8_E5M2) ? E5M2_BIAS : E4M3_BIAS;
+
+	//
+	// Extract the magnitude, frac, expo and sign:
+	//
+	__m256i sbfp8Magnitude = _mm256_and_si256(sbfp8Values, _mm256_set1_epi32((1 << (expoBits + fracBits)) - 1));
+	__m256i sbfp8Frac      = _mm256_and_si256(sbfp8Magnitude, _mm256_set1_epi32((1 << fracBits) - 1));
+	__m256i sbfp8Expo      = _mm256_srli_epi32(sbfp8Magnitude, fracBits);
+
+	__m256i fltSign = _mm256_slli_epi32(_mm256_srli_epi32(sbfp8Values, expoBits + fracBits), 31);
+
+	//
+	// Normal: move the expo and frac into place together and rebias the expo:
+	//
+	__m256i fltNormal = _mm256_add_epi32(_mm256_slli_epi32(sbfp8Magnitude, FLOAT_BIT_COUNT_FRAC - fracBits),
+	                                     _mm256_set1_epi32((FLOAT_BIAS - bias) << FLOAT_BIT_COUNT_FRAC));
+
+	//
+	// Subnormal: the frac counts units of the smallest subnormal, which converts to float
+	// exactly:
+	//
+	__m256i fltSubnormal = _mm256_castps_si256(_mm256_mul_ps(_mm256_cvtepi32_ps(sbfp8Frac),
+	                                           _mm256_set1_ps(1.0F / (1 << (bias - 1 + fracBits)))));
+
+	__m256i isSubnormal = _mm256_cmpeq_epi32(sbfp8Expo, _mm256_setzero_si256());
+
+	__m256i fltBits = _mm256_blendv_epi8(fltNormal, fltSubnormal, isSubnormal);
+
+	//
+	// Determine infinity, which only E5M2 has, and NaN:
+	//
+	__m256i isSpecial = _mm256_setzero_si256();
+	__m256i isNan     = _mm256_cmpeq_epi32(sbfp8Magnitude, _mm256_set1_epi32(E4M3_NAN));
+
+	if (format == SBFP8_E5M2)
+	{
+		isSpecial = _mm256_cmpeq_epi32(sbfp8Expo, _mm256_set1_epi32((1 << expoBits) - 1));
+		isNan     = _mm256_andnot_si256(_mm256_cmpeq_epi32(sbfp8Frac, _mm256_setzero_si256()), isSpecial);
+	}
+
+	//
+	// Select the case, concatenate the sign (NaN has its own) and return:
+	//
+	fltBits = _mm256_blendv_epi8(fltBits, _mm256_set1_epi32((int)FLOAT_INF_BITS), isSpecial);
+	fltBits = _mm256_or_si256(fltBits, fltSign);
+	fltBits = _mm256_blendv_epi8(fltBits, _mm256_set1_epi32((int)FLOAT_NAN_BITS), isNan);
+
+	return _mm256_castsi256_ps(fltBits);
+}
+
+//
+// Stores eight sbfp8_t values from 32-bit lanes.
+//
+// [in]  sbfp8Bits   - the values, one per 32-bit lane
+// [out] sbfp8Values - the destination of the values
+//
+SBFP_TARGET_AVX2
+static inline void store_sbfp8_avx2(__m256i sbfp8Bits, sbfp8_t *sbfp8Values)
+{
+	__m128i packed = _mm_packus_epi32(_mm256_castsi256_si128(sbfp8Bits), _mm256_extracti128_si256(sbfp8Bits, 1));
+
+	_mm_storel_epi64((__m128i *)sbfp8Values, _mm_packus_epi16(packed, packed));
+}
+
+//
+// Loads eight sbfp8_t values into 32-bit lanes.
+//
+// [in] sbfp8Values - the values
+//
+// Returns the values, one per 32-bit lane.
+//
+SBFP_TARGET_AVX2
+static inline __m256i load_sbfp8_avx2(const sbfp8_t *sbfp8Values)
+{
+	return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)sbfp8Values));
+}
+
+//
+// Converts an array of float values to the E4M3 format with AVX2 (see float_to_sbfp8).
+//
+// [in]  fltValues   - the float values to be converted
+// [out] sbfp8Values - the converted values
+// [in]  count       - the number of values available
+//
+// Returns the number of values converted, a multiple of 8. The caller converts the rest.
+//
+SBFP_TARGET_AVX2
+size_t sbfp_avx2_float_to_e4m3(const float *fltValues, sbfp8_t *sbfp8Values, size_t count)
+{
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		store_sbfp8_avx2(encode_sbfp8_avx2(_mm256_loadu_ps(fltValues + index), SBFP8_E4M3), sbfp8Values + index);
+	}
+
+	return index;
+}
+
+//
+// Converts an array of E4M3 values to float values with AVX2 (see sbfp8_to_float).
+//
+// [in]  sbfp8Values - the E4M3 values to be converted
+// [out] fltValues   - the converted values
+// [in]  count       - the number of values available
+//
+// Returns the number of values converted, a multiple of 8. The caller converts the rest.
+//
+SBFP_TARGET_AVX2
+size_t sbfp_avx2_e4m3_to_float(const sbfp8_t *sbfp8Values, float *fltValues, size_t count)
+{
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		_mm256_storeu_ps(fltValues + index, decode_sbfp8_avx2(load_sbfp8_avx2(sbfp8Values + index), SBFP8_E4M3));
+	}
+
+	return index;
+}
+
+//
+// Converts an array of float values to the E5M2 format with AVX2 (see float_to_sbfp8).
+//
+// [in]  fltValues   - the float values to be converted
+// [out] sbfp8Values - the converted values
+// [in]  count       - the number of values available
+//
+// Returns the number of values converted, a multiple of 8. The caller converts the rest.
+//
+SBFP_TARGET_AVX2
+size_t sbfp_avx2_float_to_e5m2(const float *fltValues, sbfp8_t *sbfp8Values, size_t count)
+{
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		store_sbfp8_avx2(encode_sbfp8_avx2(_mm256_loadu_ps(fltValues + index), SBFP8_E5M2), sbfp8Values + index);
+	}
+
+	return index;
+}
+
+//
+// Converts an array of E5M2 values to float values with AVX2 (see sbfp8_to_float).
+//
+// [in]  sbfp8Values - the E5M2 values to be converted
+// [out] fltValues   - the converted values
+// [in]  count       - the number of values available
+//
+// Returns the number of values converted, a multiple of 8. The caller converts the rest.
+//
+SBFP_TARGET_AVX2
+size_t sbfp_avx2_e5m2_to_float(const sbfp8_t *sbfp8Values, float *fltValues, size_t count)
+{
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		_mm256_storeu_ps(fltValues + index, decode_sbfp8_avx2(load_sbfp8_avx2(sbfp8Values + index), SBFP8_E5M2));
+	}
+
+	return index;
+}
+
+//
+// The bfloat16 kernels below rely on a bf16_t being the top 16 bits of a float: widening
+// is a shift, and truncating a float drops its low 16 bits. Only NaN needs care, because
+// its payload may lie in the bits that are dropped.
+//
+
+//
+// Truncates eight float values in 32-bit lanes to bfloat16 (see float_to_bf16).
+//
+// [in] fltValues - the float values
+//
+// Returns the bf16_t values, one per 32-bit lane.
+//
+SBFP_TARGET_AVX2
+static inline __m256i truncate_bf16_avx2(__m256 fltValues)
+{
+	__m256i fltBits      = _mm256_castps_si256(fltValues);
+	__m256i fltMagnitude = _mm256_and_si256(fltBits, _mm256_set1_epi32(FLOAT_MAGNITUDE_MASK));
+
+	__m256i isNan = _mm256_cmpgt_epi32(fltMagnitude, _mm256_set1_epi32(FLOAT_INF_BITS));
+
+	return _mm256_blendv_epi8(_mm256_srli_epi32(fltBits, 16), _mm256_set1_epi32(BF16_NAN), isNan);
+}
+
+//
+// Rounds eight float values in 32-bit lanes to the nearest bfloat16, ties to even (see
+// float_to_bf16_rne).
+//
+// [in] fltValues - the float values
+//
+// Returns the bf16_t values, one per 32-bit lane.
+//
+SBFP_TARGET_AVX2
+static inline __m256i round_bf16_avx2(__m256 fltValues)
+{
+	__m256i fltBits      = _mm256_castps_si256(fltValues);
+	__m256i fltMagnitude = _mm256_and_si256(fltBits, _mm256_set1_epi32(FLOAT_MAGNITUDE_MASK));
+
+	//
+	// Adding just under half of the dropped bits' range, plus the kept LSB, carries into
+	// the kept bits exactly when the value rounds up. A carry out of the largest finite
+	// value gives infinity:
+	//
+	__m256i lsb     = _mm256_and_si256(_mm256_srli_epi32(fltBits, 16), _mm256_set1_epi32(1));
+	__m256i rounded = _mm256_add_epi32(fltBits, _mm256_add_epi32(_mm256_set1_epi32(0x7FFF), lsb));
+
+	__m256i isNan = _mm256_cmpgt_epi32(fltMagnitude, _mm256_set1_epi32(FLOAT_INF_BITS));
+
+	return _mm256_blendv_epi8(_mm256_srli_epi32(rounded, 16), _mm256_set1_epi32(BF16_NAN), isNan);
+}
+
+//
+// Widens eight bfloat16 values in 32-bit lanes to float values (see bf16_to_float).
+//
+// [in] bf16Values - the bf16_t values, one per 32-bit lane
+//
+// Returns the float values.
+//
+SBFP_TARGET_AVX2
+static inline __m256 widen_bf16_avx2(__m256i bf16Values)
+{
+	__m256i fltBits      = _mm256_slli_epi32(bf16Values, 16);
+	__m256i fltMagnitude = _mm256_and_si256(fltBits, _mm256_set1_epi32(FLOAT_MAGNITUDE_MASK));
+
+	__m256i isNan = _mm256_cmpgt_epi32(fltMagnitude, _mm256_set1_epi32(FLOAT_INF_BITS));
+
+	return _mm256_castsi256_ps(_mm256_blendv_epi8(fltBits, _mm256_set1_epi32((int)FLOAT_NAN_BITS), isNan));
+}
+
+//
+// Converts an array of float values to bfloat16 with AVX2, truncating them (see
+// float_to_bf16).
+//
+// [in]  fltValues  - the float values to be converted
+// [out] bf16Values - the converted values
+// [in]  count      - the number of values available
+//
+// Returns the number of values converted, a multiple of 8. The caller converts the rest.
+//
+SBFP_TARGET_AVX2
+size_t sbfp_avx2_float_to_bf16(const float *fltValues, bf16_t *bf16Values, size_t count)
+{
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		store_sbfp16_avx2(truncate_bf16_avx2(_mm256_loadu_ps(fltValues + index)), bf16Values + index);
+	}
+
+	return index;
+}
+
+//
+// Converts an array of float values to bfloat16 with AVX2, rounding them to nearest even
+// (see float_to_bf16_rne).
+//
+// [in]  fltValues  - the float values to be converted
+// [out] bf16Values - the converted values
+// [in]  count      - the number of values available
+//
+// Returns the number of values converted, a multiple of 8. The caller converts the rest.
+//
+SBFP_TARGET_AVX2
+size_t sbfp_avx2_float_to_bf16_rne(const float *fltValues, bf16_t *bf16Values, size_t count)
+{
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		store_sbfp16_avx2(round_bf16_avx2(_mm256_loadu_ps(fltValues + index)), bf16Values + index);
+	}
+
+	return index;
+}
+
+//
+// Converts an array of bfloat16 values to float values with AVX2 (see bf16_to_float).
+//
+// [in]  bf16Values - the bfloat16 values to be converted
+// [out] fltValues  - the converted values
+// [in]  count      - the number of values available
+//
+// Returns the number of values converted, a multiple of 8. The caller converts the rest.
+//
+SBFP_TARGET_AVX2
+size_t sbfp_avx2_bf16_to_float(const bf16_t *bf16Values, float *fltValues, size_t count)
+{
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		_mm256_storeu_ps(fltValues + index, widen_bf16_avx2(load_sbfp16_avx2(bf16Values + index)));
+	}
+
+	return index;
+}
+
+//
+// Transcodes an array of sbfp_t values to bfloat16 with AVX2, through float, which holds
+// every sbfp value exactly (see sbfp_to_bf16).
+//
+// [in]  sbfpValues - the sbfp values to be converted
+// [out] bf16Values - the converted values
+// [in]  count      - the number of values available
+//
+// Returns the number of values converted, a multiple of 8. The caller converts the rest.
+//
+SBFP_TARGET_AVX2
+size_t sbfp_avx2_sbfp_to_bf16(const sbfp_t *sbfpValues, bf16_t *bf16Values, size_t count)
+{
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		__m256 fltValues = decode_float_avx2(_mm256_loadu_si256((const __m256i *)(sbfpValues + index)));
+
+		store_sbfp16_avx2(truncate_bf16_avx2(fltValues), bf16Values + index);
+	}
+
+	return index;
+}
+
+//
+// Transcodes an array of bfloat16 values to the sbfp_t type with AVX2, through float (see
+// bf16_to_sbfp).
+//
+// [in]  bf16Values - the bfloat16 values to be converted
+// [out] sbfpValues - the converted values
+// [in]  count      - the number of values available
+//
+// Returns the number of values converted, a multiple of 8. The caller converts the rest.
+//
+SBFP_TARGET_AVX2
+size_t sbfp_avx2_bf16_to_sbfp(const bf16_t *bf16Values, sbfp_t *sbfpValues, size_t count)
+{
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		__m256 fltValues = widen_bf16_avx2(load_sbfp16_avx2(bf16Values + index));
+
+		_mm256_storeu_si256((__m256i *)(sbfpValues + index), encode_float_avx2(fltValues));
+	}
+
+	return index;
+}
+
+//
+// Transcodes an array of sbfp16_t values to bfloat16 with AVX2 (see sbfp_avx2_sbfp_to_bf16).
+//
+// [in]  sbfpValues - the sbfp values to be converted
+// [out] bf16Values - the converted values
+// [in]  count      - the number of values available
+//
+// Returns the number of values converted, a multiple of 8. The caller converts the rest.
+//
+SBFP_TARGET_AVX2
+size_t sbfp_avx2_sbfp16_to_bf16(const sbfp16_t *sbfpValues, bf16_t *bf16Values, size_t count)
+{
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		store_sbfp16_avx2(truncate_bf16_avx2(decode_float_avx2(load_sbfp16_avx2(sbfpValues + index))), bf16Values + index);
+	}
+
+	return index;
+}
+
+//
+// Transcodes an array of bfloat16 values to the sbfp16_t type with AVX2 (see
+// sbfp_avx2_bf16_to_sbfp).
+//
+// [in]  bf16Values - the bfloat16 values to be converted
+// [out] sbfpValues - the converted values
+// [in]  count      - the number of values available
+//
+// Returns the number of values converted, a multiple of 8. The caller converts the rest.
+//
+SBFP_TARGET_AVX2
+size_t sbfp_avx2_bf16_to_sbfp16(const bf16_t *bf16Values, sbfp16_t *sbfpValues, size_t count)
+{
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		store_sbfp16_avx2(encode_float_avx2(widen_bf16_avx2(load_sbfp16_avx2(bf16Values + index))), sbfpValues + index);
+	}
+
+	return index;
+}
+
+//
+// The bfloat16 arithmetic kernels below widen the operands to float, operate on the floats
+// with MXCSR rounding toward zero, and truncate the results. The bfloat16 values lie on
+// the float grid, so truncating to float and then to bfloat16 gives the truncation of the
+// exact result. Rounding toward zero turns an overflow into the largest float, which no
+// exact sum or product of two bfloat16 values can equal, so it is mapped to infinity.
+//
+
+//
+// Truncates eight float results of bfloat16 operands to bfloat16, mapping overflow to
+// infinity (see above).
+//
+// [in] fltResults - the float results
+//
+// Returns the bf16_t values, one per 32-bit lane.
+//
+SBFP_TARGET_AVX2
+static inline __m256i narrow_bf16_avx2(__m256 fltResults)
+{
+	__m256i fltBits      = _mm256_castps_si256(fltResults);
+	__m256i fltMagnitude = _mm256_and_si256(fltBits, _mm256_set1_epi32(FLOAT_MAGNITUDE_MASK));
+
+	__m256i isOverflow = _mm256_cmpeq_epi32(fltMagnitude, _mm256_set1_epi32(FLOAT_INF_BITS - 1));
+
+	fltBits = _mm256_add_epi32(fltBits, _mm256_and_si256(isOverflow, _mm256_set1_epi32(1)));
+
+	return truncate_bf16_avx2(_mm256_castsi256_ps(fltBits));
+}
+
+//
+// Applies an operation to arrays of bfloat16 values with AVX2.
+//
+// [in]  bf16Values1 - the first operands
+// [in]  bf16Values2 - the second operands
+// [out] bf16Results - the results
+// [in]  count       - the number of elements available
+// [in]  operation   - SBFP_X86_OP_ADD, SBFP_X86_OP_SUB or SBFP_X86_OP_MUL (a constant)
+//
+// Returns the number of elements computed, a multiple of 8. The caller computes the rest.
+//
+SBFP_TARGET_AVX2
+static inline size_t operate_bf16_avx2(const bf16_t *bf16Values1, const bf16_t *bf16Values2, bf16_t *bf16Results,
+	size_t count, int operation)
+{
+	unsigned int roundingMode = _MM_GET_ROUNDING_MODE();
+
+	_MM_SET_ROUNDING_MODE(_MM_ROUND_TOWARD_ZERO);
+
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		__m256 fltValues1 = widen_bf16_avx2(load_sbfp16_avx2(bf16Values1 + index));
+		__m256 fltValues2 = widen_bf16_avx2(load_sbfp16_avx2(bf16Values2 + index));
+
+		__m256 fltResults = (operation == SBFP_X86_OP_ADD) ? _mm256_add_ps(fltValues1, fltValues2) :
+		                    (operation == SBFP_X86_OP_SUB) ? _mm256_sub_ps(fltValues1, fltValues2) :
+		                                                     _mm256_mul_ps(fltValues1, fltValues2);
+
+		store_sbfp16_avx2(narrow_bf16_avx2(fltResults), bf16Results + index);
+	}
+
+	_MM_SET_ROUNDING_MODE(roundingMode);
+
+	return index;
+}
+
+//
+// Adds arrays of bfloat16 values with AVX2 (see bf16_add).
+//
+// [in]  bf16Values1 - the augends
+// [in]  bf16Values2 - the addends
+// [out] bf16Results - the sums
+// [in]  count       - the number of elements available
+//
+// Returns the number of elements computed, a multiple of 8. The caller computes the rest.
+//
+SBFP_TARGET_AVX2
+size_t sbfp_avx2_bf16_add(const bf16_t *bf16Values1, const bf16_t *bf16Values2, bf16_t *bf16Results, size_t count)
+{
+	return operate_bf16_avx2(bf16Values1, bf16Values2, bf16Results, count, SBFP_X86_OP_ADD);
+}
+
+//
+// Subtracts arrays of bfloat16 values with AVX2 (see bf16_sub).
+//
+// [in]  bf16Values1 - the minuends
+// [in]  bf16Values2 - the subtrahends
+// [out] bf16Results - the differences
+// [in]  count       - the number of elements available
+//
+// Returns the number of elements computed, a multiple of 8. The caller computes the rest.
+//
+SBFP_TARGET_AVX2
+size_t sbfp_avx2_bf16_sub(const bf16_t *bf16Values1, const bf16_t *bf16Values2, bf16_t *bf16Results, size_t count)
+{
+	return operate_bf16_avx2(bf16Values1, bf16Values2, bf16Results, count, SBFP_X86_OP_SUB);
+}
+
+//
+// Multiplies arrays of bfloat16 values with AVX2 (see bf16_mul).
+//
+// [in]  bf16Values1 - the multiplicands
+// [in]  bf16Values2 - the multipliers
+// [out] bf16Results - the products
+// [in]  count       - the number of elements available
+//
+// Returns the number of elements computed, a multiple of 8. The caller computes the rest.
+//
+SBFP_TARGET_AVX2
+size_t sbfp_avx2_bf16_mul(const bf16_t *bf16Values1, const bf16_t *bf16Values2, bf16_t *bf16Results, size_t count)
+{
+	return operate_bf16_avx2(bf16Values1, bf16Values2, bf16Results, count, SBFP_X86_OP_MUL);
+}
+
+//
+// The integer kernels below work on sbfp16_t values in 16-bit lanes with the steps of the
+// scalar sbfp_add and sbfp_mul, on binary16 bits. A shift by a different amount in each
+// lane is a multiplication by a power of two: _mm_mulhi_epu16 by 2^(16 - n) shifts right by
+// n, and _mm_mullo_epi16 by the same power keeps the bits shifted out. Zeros, subnormals,
+// infinity and NaN are computed in every lane and selected with masks, so no lane takes a
+// branch.
+//
+
+//
+// Gives the source of the operands of an integer kernel. A stride of 0 repeats the first
+// value, so the value is copied into every lane of a buffer that the kernel loads from
+// without advancing.
+//
+// [in]  sbfpValues - the operands
+// [in]  sbfpStride - 1 if the operands are contiguous, or 0 to repeat the first one
+// [out] repeated   - a buffer of laneCount values, filled if sbfpStride is 0
+// [in]  laneCount  - the number of lanes in a vector
+// [in]  count      - the number of elements available
+//
+// Returns the array to load from, at the index of an element times sbfpStride.
+//
+static inline const sbfp16_t *lane_source(const sbfp16_t *sbfpValues, ptrdiff_t sbfpStride, sbfp16_t *repeated, size_t laneCount, size_t count)
+{
+	if (sbfpStride != 0 || count < laneCount)
+	{
+		return sbfpValues;
+	}
+
+	for (size_t lane = 0; lane < laneCount; ++lane)
+	{
+		repeated[lane] = sbfpValues[0];
+	}
+
+	return repeated;
+}
+
+//
+// Computes 2^n in 16-bit lanes with SSE2.
+//
+// [in] n - the powers, each from 0 to 15
+//
+// Returns the powers of two.
+//
+SBFP_TARGET_SSE2
+static inline __m128i pow2_sse2(__m128i n)
+{
+	//
+	// Build floats with the powers as expos, in the even and odd lanes separately:
+	//
+	__m128i nEven = _mm_and_si128(n, _mm_set1_epi32(0xFFFF));
+	__m128i nOdd  = _mm_srli_epi32(n, 16);
+
+	__m128i powEven = _mm_cvttps_epi32(_mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(nEven, _mm_set1_epi32(FLOAT_BIAS)), FLOAT_BIT_COUNT_FRAC)));
+	__m128i powOdd  = _mm_cvttps_epi32(_mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(nOdd, _mm_set1_epi32(FLOAT_BIAS)), FLOAT_BIT_COUNT_FRAC)));
+
+	return _mm_or_si128(_mm_and_si128(powEven, _mm_set1_epi32(0xFFFF)), _mm_slli_epi32(powOdd, 16));
+}
+
+//
+// Computes floor(log2(x)) in 16-bit lanes with SSE2, through the expo of a float.
+//
+// [in] x - the values (a zero lane gives an unspecified result)
+//
+// Returns the logarithms.
+//
+SBFP_TARGET_SSE2
+static inline __m128i log2_sse2(__m128i x)
+{
+	__m128i fltEven = _mm_castps_si128(_mm_cvtepi32_ps(_mm_and_si128(x, _mm_set1_epi32(0xFFFF))));
+	__m128i fltOdd  = _mm_castps_si128(_mm_cvtepi32_ps(_mm_srli_epi32(x, 16)));
+
+	__m128i fltExpo = _mm_or_si128(_mm_srli_epi32(fltEven, FLOAT_BIT_COUNT_FRAC),
+	                               _mm_and_si128(_mm_srli_epi32(fltOdd, FLOAT_BIT_COUNT_FRAC - 16), _mm_set1_epi32((int)0xFFFF0000)));
+
+	return _mm_sub_epi16(fltExpo, _mm_set1_epi16(FLOAT_BIAS));
+}
+
+//
+// Selects between the bits of two vectors in 16-bit lanes with SSE2.
+//
+// [in] mask      - the lanes to take from trueBits (all bits set) or falseBits (all clear)
+// [in] trueBits  - the bits selected where mask is set
+// [in] falseBits - the bits selected where mask is clear
+//
+// Returns the selected bits.
+//
+SBFP_TARGET_SSE2
+static inline __m128i select_sse2(__m128i mask, __m128i trueBits, __m128i falseBits)
+{
+	return select_si128(mask, trueBits, falseBits);
+}
+
+//
+// Translates sbfp values in 16-bit lanes to binary16 with SSE2 (see sbfp_core_to_binary16).
+//
+// [in] bits - the sbfp values
+//
+// Returns the binary16 bits.
+//
+SBFP_TARGET_SSE2
+static inline __m128i to_binary16_sse2(__m128i bits)
+{
+#ifdef SBFP_IEEE_BINARY16
+	return bits;
+#else
+	__m128i isPosInf = _mm_cmpeq_epi16(bits, _mm_set1_epi16(SBFP_LEGACY_POS_INF));
+	__m128i isNegInf = _mm_cmpeq_epi16(bits, _mm_set1_epi16(SBFP_LEGACY_NEG_INF));
+	__m128i isNan    = _mm_cmpeq_epi16(bits, _mm_set1_epi16(SBFP_LEGACY_NAN));
+
+	__m128i flipBits = _mm_or_si128(_mm_or_si128(_mm_and_si128(isPosInf, _mm_set1_epi16(SBFP_LEGACY_POS_INF ^ BINARY16_POS_INF)),
+	                                             _mm_and_si128(isNegInf, _mm_set1_epi16((short)(SBFP_LEGACY_NEG_INF ^ BINARY16_NEG_INF)))),
+	                                _mm_and_si128(isNan, _mm_set1_epi16(SBFP_LEGACY_NAN ^ BINARY16_NAN)));
+
+	return _mm_xor_si128(bits, flipBits);
+#endif
+}
+
+//
+// Selects infinity with the given signs in 16-bit lanes with SSE2.
+//
+// [in] sign - the signs, in bit 15 of each lane
+//
+// Returns SBFP_NEG_INF where the sign is set, and SBFP_POS_INF elsewhere.
+//
+SBFP_TARGET_SSE2
+static inline __m128i signed_inf_sse2(__m128i sign)
+{
+#ifdef SBFP_IEEE_BINARY16
+	return _mm_or_si128(_mm_set1_epi16(SBFP_POS_INF), sign);
+#else
+	return select_sse2(_mm_srai_epi16(sign, 15), _mm_set1_epi16(SBFP_NEG_INF), _mm_set1_epi16(SBFP_POS_INF));
+#endif
+}
+
+//
+// Packs positive magnitudes into binary16 bits in 16-bit lanes with SSE2, rounding to
+// nearest even like sbfp_core_pack_binary16. The significand is shifted down to the frac of
+// a normal or subnormal result, and magnitudes that round to 2^16 or above become infinity.
+//
+// [in] sig    - the significands, normalized so that bit 15 is their leading bit
+// [in] expo   - the biased expos of bit 15 of the significands
+// [in] sticky - 1 where nonzero bits lie below the significands, 0 elsewhere
+//
+// Returns the binary16 bits, without a sign.
+//
+SBFP_TARGET_SSE2
+static inline __m128i pack_binary16_sse2(__m128i sig, __m128i expo, __m128i sticky)
+{
+	const int sigShift = 16 - (15 - SBFP_BIT_COUNT_FRAC); // the shift of a normal frac, as a power for _mm_mulhi_epu16
+
+	__m128i zero = _mm_setzero_si128();
+	__m128i one  = _mm_set1_epi16(1);
+
+	__m128i sbfpExpo = _mm_max_epi16(expo, one);
+	__m128i subShift = _mm_sub_epi16(sbfpExpo, expo);
+	__m128i power    = pow2_sse2(_mm_sub_epi16(_mm_set1_epi16(sigShift), _mm_min_epi16(subShift, _mm_set1_epi16(sigShift))));
+
+	//
+	// Split the significand into the frac kept and the bits dropped, which are aligned to bit
+	// 15 with the sticky bit below them. A shift beyond the significand leaves less than half
+	// of the smallest subnormal, so nothing is kept or rounded up:
+	//
+	__m128i kept    = _mm_mulhi_epu16(sig, power);
+	__m128i dropped = _mm_or_si128(_mm_mullo_epi16(sig, power), sticky);
+
+	dropped = _mm_andnot_si128(_mm_cmpgt_epi16(subShift, _mm_set1_epi16(sigShift)), dropped);
+
+	//
+	// Round up above half, or at half to an even frac, comparing the dropped bits unsigned
+	// by flipping bit 15. A carry out of the frac simply moves to the next expo:
+	//
+	__m128i roundUp = _mm_cmpgt_epi16(_mm_xor_si128(dropped, _mm_set1_epi16((short)0x8000)), _mm_sub_epi16(zero, _mm_and_si128(kept, one)));
+
+	__m128i bits = _mm_add_epi16(_mm_slli_epi16(_mm_sub_epi16(sbfpExpo, one), SBFP_BIT_COUNT_FRAC), kept);
+
+	bits = _mm_sub_epi16(bits, roundUp);
+
+#if SBFP_ZERO_MIN_NORMAL
+	//
+	// Magnitudes that round to 2^-14 become the largest subnormal, or the next value up if
+	// they are above 2^-14:
+	//
+	__m128i isNotAbove = _mm_or_si128(_mm_cmpeq_epi16(dropped, zero), roundUp);
+	__m128i neighbour  = _mm_add_epi16(_mm_set1_epi16(SBFP_FRAC_MASK), _mm_andnot_si128(isNotAbove, _mm_set1_epi16(2)));
+
+	bits = select_sse2(_mm_cmpeq_epi16(bits, _mm_set1_epi16(1 << SBFP_BIT_COUNT_FRAC)), neighbour, bits);
+#endif
+
+	return select_sse2(_mm_cmpgt_epi16(expo, _mm_set1_epi16(SBFP_EXPO_MASK - 1)), _mm_set1_epi16(BINARY16_POS_INF), bits);
+}
+
+//
+// Multiplies sbfp values in 16-bit lanes with SSE2 (see sbfp_mul).
+//
+// The smaller significand is the only one that can be subnormal in a product that does not
+// round to zero, so only it is normalized, with its leading bit at bit 15. The high half
+// of its product with the other significand then has its leading bit at bit 14 or 15, and
+// the low half, like the bit the high half may be shifted by, only decides the sticky bit.
+//
+// [in] bits1 - the multiplicands
+// [in] bits2 - the multipliers
+//
+// Returns the products.
+//
+SBFP_TARGET_SSE2
+static inline __m128i multiply_sse2(__m128i bits1, __m128i bits2)
+{
+	__m128i zero     = _mm_setzero_si128();
+	__m128i one      = _mm_set1_epi16(1);
+	__m128i fracMask = _mm_set1_epi16(SBFP_FRAC_MASK);
+	__m128i infBits  = _mm_set1_epi16(BINARY16_POS_INF);
+
+	bits1 = to_binary16_sse2(bits1);
+	bits2 = to_binary16_sse2(bits2);
+
+	//
+	// Extract the magnitude, frac and expo of both sbfp values, and the sign of the product:
+	//
+	__m128i magnitude1 = _mm_and_si128(bits1, _mm_set1_epi16(SBFP_BIT_MASK >> SBFP_BIT_COUNT_SIGN));
+	__m128i magnitude2 = _mm_and_si128(bits2, _mm_set1_epi16(SBFP_BIT_MASK >> SBFP_BIT_COUNT_SIGN));
+
+	__m128i sbfpExpo1 = _mm_srli_epi16(magnitude1, SBFP_BIT_COUNT_FRAC);
+	__m128i sbfpExpo2 = _mm_srli_epi16(magnitude2, SBFP_BIT_COUNT_FRAC);
+
+	__m128i sign = _mm_and_si128(_mm_xor_si128(bits1, bits2), _mm_set1_epi16((short)(1 << (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC))));
+
+	//
+	// Determine the significands (with the implicit bit for normals), and normalize the
+	// smaller one:
+	//
+	__m128i M1 = _mm_or_si128(_mm_and_si128(magnitude1, fracMask), _mm_slli_epi16(_mm_min_epi16(sbfpExpo1, one), SBFP_BIT_COUNT_FRAC));
+	__m128i M2 = _mm_or_si128(_mm_and_si128(magnitude2, fracMask), _mm_slli_epi16(_mm_min_epi16(sbfpExpo2, one), SBFP_BIT_COUNT_FRAC));
+
+	__m128i MLow  = _mm_min_epi16(M1, M2);
+	__m128i MHigh = _mm_max_epi16(M1, M2);
+
+	__m128i log2Low = log2_sse2(MLow);
+
+	MLow  = _mm_mullo_epi16(MLow, pow2_sse2(_mm_sub_epi16(_mm_set1_epi16(15), log2Low)));
+	MHigh = _mm_slli_epi16(MHigh, 15 - SBFP_BIT_COUNT_FRAC);
+
+	//
+	// Multiply the significands, and move the leading bit of the product to bit 15. The
+	// expo of bit 15 is the sum of the expos, less the normalization of MLow:
+	//
+	__m128i product = _mm_mulhi_epu16(MLow, MHigh);
+	__m128i carry   = _mm_srai_epi16(product, 15);
+	__m128i sticky  = _mm_add_epi16(_mm_cmpeq_epi16(_mm_mullo_epi16(MLow, MHigh), zero), one);
+
+	product = select_sse2(carry, product, _mm_slli_epi16(product, 1));
+
+	__m128i expo = _mm_add_epi16(_mm_max_epi16(sbfpExpo1, one), _mm_max_epi16(sbfpExpo2, one));
+
+	expo = _mm_sub_epi16(_mm_add_epi16(expo, log2Low), carry);
+	expo = _mm_sub_epi16(expo, _mm_set1_epi16(SBFP_BIAS + SBFP_BIT_COUNT_FRAC));
+
+	__m128i bits = pack_binary16_sse2(product, expo, sticky);
+
+	//
+	// Select zero, infinity and NaN, and concatenate the sign (an exact zero has none unless
+	// SBFP_SIGNED_ZERO):
+	//
+	__m128i isZero = _mm_or_si128(_mm_cmpeq_epi16(magnitude1, zero), _mm_cmpeq_epi16(magnitude2, zero));
+	__m128i isInf  = _mm_or_si128(_mm_cmpeq_epi16(magnitude1, infBits), _mm_cmpeq_epi16(magnitude2, infBits));
+	__m128i isNan  = _mm_or_si128(_mm_or_si128(_mm_cmpgt_epi16(magnitude1, infBits), _mm_cmpgt_epi16(magnitude2, infBits)),
+	                              _mm_and_si128(isInf, isZero));
+
+	isInf = _mm_or_si128(isInf, _mm_andnot_si128(isZero, _mm_cmpeq_epi16(bits, infBits)));
+	bits  = _mm_andnot_si128(isZero, bits);
+
+#if !SBFP_SIGNED_ZERO
+	sign = _mm_andnot_si128(isZero, sign);
+#endif
+
+	bits = _mm_or_si128(bits, sign);
+	bits = select_sse2(isInf, signed_inf_sse2(sign), bits);
+
+	return select_sse2(isNan, _mm_set1_epi16(SBFP_NAN), bits);
+}
+
+//
+// Adds sbfp values in 16-bit lanes with SSE2, or subtracts the second from the first (see
+// sbfp_add).
+//
+// The operands are ordered by magnitude, and the smaller one's significand is aligned to
+// the larger one's with 3 guard bits. The bits shifted out of it are kept as a sticky bit,
+// which a subtraction takes away, and which the rounding of the sum then sees, so the sum
+// rounds as the exact one would.
+//
+// [in] bits1   - the augends
+// [in] bits2   - the addends
+// [in] negate2 - 1 to subtract the addends, 0 to add them
+//
+// Returns the sums.
+//
+SBFP_TARGET_SSE2
+static inline __m128i add_sse2(__m128i bits1, __m128i bits2, int negate2)
+{
+	const int guardBits = 3;
+
+	__m128i zero     = _mm_setzero_si128();
+	__m128i one      = _mm_set1_epi16(1);
+	__m128i fracMask = _mm_set1_epi16(SBFP_FRAC_MASK);
+	__m128i signMask = _mm_set1_epi16((short)(1 << (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC)));
+	__m128i infBits  = _mm_set1_epi16(BINARY16_POS_INF);
+
+	bits1 = to_binary16_sse2(bits1);
+	bits2 = _mm_xor_si128(to_binary16_sse2(bits2), _mm_and_si128(signMask, _mm_set1_epi16((short)-negate2)));
+
+	//
+	// Extract the magnitudes, ordered so that X is the larger one, the sign of X, and
+	// whether the signs differ:
+	//
+	__m128i magnitude1 = _mm_and_si128(bits1, _mm_set1_epi16(SBFP_BIT_MASK >> SBFP_BIT_COUNT_SIGN));
+	__m128i magnitude2 = _mm_and_si128(bits2, _mm_set1_epi16(SBFP_BIT_MASK >> SBFP_BIT_COUNT_SIGN));
+
+	__m128i magnitudeX = _mm_max_epi16(magnitude1, magnitude2);
+	__m128i magnitudeY = _mm_min_epi16(magnitude1, magnitude2);
+
+	__m128i signX         = _mm_and_si128(select_sse2(_mm_cmpgt_epi16(magnitude2, magnitude1), bits2, bits1), signMask);
+	__m128i isSubtraction = _mm_srai_epi16(_mm_xor_si128(bits1, bits2), 15);
+
+	//
+	// Determine the significands (with the implicit bit for normals) and expos:
+	//
+	__m128i sbfpExpoX = _mm_srli_epi16(magnitudeX, SBFP_BIT_COUNT_FRAC);
+	__m128i sbfpExpoY = _mm_srli_epi16(magnitudeY, SBFP_BIT_COUNT_FRAC);
+
+	__m128i MX = _mm_or_si128(_mm_and_si128(magnitudeX, fracMask), _mm_slli_epi16(_mm_min_epi16(sbfpExpoX, one), SBFP_BIT_COUNT_FRAC));
+	__m128i MY = _mm_or_si128(_mm_and_si128(magnitudeY, fracMask), _mm_slli_epi16(_mm_min_epi16(sbfpExpoY, one), SBFP_BIT_COUNT_FRAC));
+
+	sbfpExpoX = _mm_max_epi16(sbfpExpoX, one);
+	sbfpExpoY = _mm_max_epi16(sbfpExpoY, one);
+
+	//
+	// Align MY to MX. A shift of 15 or more leaves only the sticky bit:
+	//
+	__m128i alignPower = pow2_sse2(_mm_sub_epi16(_mm_set1_epi16(15), _mm_min_epi16(_mm_sub_epi16(sbfpExpoX, sbfpExpoY), _mm_set1_epi16(15))));
+
+	MY = _mm_slli_epi16(MY, guardBits + 1);
+
+	__m128i sticky = _mm_add_epi16(_mm_cmpeq_epi16(_mm_mullo_epi16(MY, alignPower), zero), one);
+
+	MY = _mm_mulhi_epu16(MY, alignPower);
+	MX = _mm_slli_epi16(MX, guardBits);
+
+	__m128i M = select_sse2(isSubtraction, _mm_sub_epi16(_mm_sub_epi16(MX, MY), sticky), _mm_add_epi16(MX, MY));
+
+	//
+	// Move the leading bit of the sum to bit 15, and pack it:
+	//
+	__m128i log2Sum = log2_sse2(M);
+	__m128i expo    = _mm_add_epi16(sbfpExpoX, _mm_sub_epi16(log2Sum, _mm_set1_epi16(SBFP_BIT_COUNT_FRAC + guardBits)));
+
+	__m128i bits = pack_binary16_sse2(_mm_mullo_epi16(M, pow2_sse2(_mm_sub_epi16(_mm_set1_epi16(15), log2Sum))), expo, sticky);
+
+	//
+	// Concatenate the sign (an exact zero sum is negative only if both operands are, and
+	// has no sign unless SBFP_SIGNED_ZERO), and select infinity and NaN:
+	//
+	__m128i isZero = _mm_cmpeq_epi16(M, zero);
+	__m128i isInf1 = _mm_cmpeq_epi16(magnitude1, infBits);
+	__m128i isInf2 = _mm_cmpeq_epi16(magnitude2, infBits);
+	__m128i isNan  = _mm_or_si128(_mm_or_si128(_mm_cmpgt_epi16(magnitude1, infBits), _mm_cmpgt_epi16(magnitude2, infBits)),
+	                              _mm_and_si128(_mm_and_si128(isInf1, isInf2), isSubtraction));
+
+	__m128i isInf = _mm_or_si128(_mm_or_si128(isInf1, isInf2), _mm_andnot_si128(isZero, _mm_cmpeq_epi16(bits, infBits)));
+
+	bits = _mm_or_si128(bits, signX);
+
+#if SBFP_SIGNED_ZERO
+	bits = select_sse2(isZero, _mm_and_si128(_mm_and_si128(bits1, bits2), signMask), bits);
+#else
+	bits = _mm_andnot_si128(isZero, bits);
+#endif
+
+	bits = select_sse2(isInf, signed_inf_sse2(signX), bits);
+
+	return select_sse2(isNan, _mm_set1_epi16(SBFP_NAN), bits);
+}
+
+//
+// Adds arrays of sbfp16_t values with SSE2, or subtracts the second from the first.
+//
+// [in]  sbfpValues1 - the augends
+// [in]  sbfpStride1 - 1 if the augends are contiguous, or 0 to repeat the first one
+// [in]  sbfpValues2 - the addends
+// [in]  sbfpStride2 - 1 if the addends are contiguous, or 0 to repeat the first one
+// [out] sbfpResults - the sums
+// [in]  count       - the number of elements available
+// [in]  negate2     - 1 to subtract the addends, 0 to add them
+//
+// Returns the number of elements computed, a multiple of 8.
+//
+SBFP_TARGET_SSE2
+static size_t add_arrays_sse2(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp16_t *sbfpResults, size_t count, int negate2)
+{
+	sbfp16_t repeated1[8];
+	sbfp16_t repeated2[8];
+
+	const sbfp16_t *sbfpSource1 = lane_source(sbfpValues1, sbfpStride1, repeated1, 8, count);
+	const sbfp16_t *sbfpSource2 = lane_source(sbfpValues2, sbfpStride2, repeated2, 8, count);
+
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		__m128i bits1 = _mm_loadu_si128((const __m128i *)(sbfpSource1 + index * sbfpStride1));
+		__m128i bits2 = _mm_loadu_si128((const __m128i *)(sbfpSource2 + index * sbfpStride2));
+
+		_mm_storeu_si128((__m128i *)(sbfpResults + index), add_sse2(bits1, bits2, negate2));
+	}
+
+	return index;
+}
+
+//
+// Adds arrays of sbfp16_t values with SSE2 (see sbfp_add).
+//
+// [in]  sbfpValues1 - the augends
+// [in]  sbfpStride1 - 1 if the augends are contiguous, or 0 to repeat the first one
+// [in]  sbfpValues2 - the addends
+// [in]  sbfpStride2 - 1 if the addends are contiguous, or 0 to repeat the first one
+// [out] sbfpResults - the sums
+// [in]  count       - the number of elements available
+//
+// Returns the number of elements computed, a multiple of 8. The caller computes the rest.
+//
+SBFP_TARGET_SSE2
+size_t sbfp_sse2_sbfp16_add(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp16_t *sbfpResults, size_t count)
+{
+	return add_arrays_sse2(sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, count, 0);
+}
+
+//
+// Subtracts arrays of sbfp16_t values with SSE2 (see sbfp_sub).
+//
+// [in]  sbfpValues1 - the minuends
+// [in]  sbfpStride1 - 1 if the minuends are contiguous, or 0 to repeat the first one
+// [in]  sbfpValues2 - the subtrahends
+// [in]  sbfpStride2 - 1 if the subtrahends are contiguous, or 0 to repeat the first one
+// [out] sbfpResults - the differences
+// [in]  count       - the number of elements available
+//
+// Returns the number of elements computed, a multiple of 8. The caller computes the rest.
+//
+SBFP_TARGET_SSE2
+size_t sbfp_sse2_sbfp16_sub(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp16_t *sbfpResults, size_t count)
+{
+	return add_arrays_sse2(sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, count, 1);
+}
+
+//
+// Multiplies arrays of sbfp16_t values with SSE2 (see sbfp_mul).
+//
+// [in]  sbfpValues1 - the multiplicands
+// [in]  sbfpStride1 - 1 if the multiplicands are contiguous, or 0 to repeat the first one
+// [in]  sbfpValues2 - the multipliers
+// [in]  sbfpStride2 - 1 if the multipliers are contiguous, or 0 to repeat the first one
+// [out] sbfpResults - the products
+// [in]  count       - the number of elements available
+//
+// Returns the number of elements computed, a multiple of 8. The caller computes the rest.
+//
+SBFP_TARGET_SSE2
+size_t sbfp_sse2_sbfp16_mul(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp16_t *sbfpResults, size_t count)
+{
+	sbfp16_t repeated1[8];
+	sbfp16_t repeated2[8];
+
+	const sbfp16_t *sbfpSource1 = lane_source(sbfpValues1, sbfpStride1, repeated1, 8, count);
+	const sbfp16_t *sbfpSource2 = lane_source(sbfpValues2, sbfpStride2, repeated2, 8, count);
+
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		__m128i bits1 = _mm_loadu_si128((const __m128i *)(sbfpSource1 + index * sbfpStride1));
+		__m128i bits2 = _mm_loadu_si128((const __m128i *)(sbfpSource2 + index * sbfpStride2));
+
+		_mm_storeu_si128((__m128i *)(sbfpResults + index), multiply_sse2(bits1, bits2));
+	}
+
+	return index;
+}
+
+//
+// Computes 2^n in 16-bit lanes with AVX2.
+//
+// [in] n - the powers, each from 0 to 15
+//
+// Returns the powers of two.
+//
+SBFP_TARGET_AVX2
+static inline __m256i pow2_avx2(__m256i n)
+{
+	//
+	// Look up the low byte of 2^n at index n and the high byte at index n ^ 8:
+	//
+	__m256i powers = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0,
+	                                  1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+
+	__m256i indices = _mm256_xor_si256(_mm256_or_si256(n, _mm256_slli_epi16(n, 8)), _mm256_set1_epi16(0x0800));
+
+	return _mm256_shuffle_epi8(powers, indices);
+}
+
+//
+// Computes floor(log2(x)) in 16-bit lanes with AVX2, through the expo of a float.
+//
+// [in] x - the values (a zero lane gives an unspecified result)
+//
+// Returns the logarithms.
+//
+SBFP_TARGET_AVX2
+static inline __m256i log2_avx2(__m256i x)
+{
+	__m256i fltEven = _mm256_castps_si256(_mm256_cvtepi32_ps(_mm256_and_si256(x, _mm256_set1_epi32(0xFFFF))));
+	__m256i fltOdd  = _mm256_castps_si256(_mm256_cvtepi32_ps(_mm256_srli_epi32(x, 16)));
+
+	__m256i fltExpo = _mm256_blend_epi16(_mm256_srli_epi32(fltEven, FLOAT_BIT_COUNT_FRAC),
+	                                     _mm256_srli_epi32(fltOdd, FLOAT_BIT_COUNT_FRAC - 16), 0xAA);
+
+	return _mm256_sub_epi16(fltExpo, _mm256_set1_epi16(FLOAT_BIAS));
+}
+
+//
+// Selects between the bits of two vectors in 16-bit lanes with AVX2.
+//
+// [in] mask      - the lanes to take from trueBits (all bits set) or falseBits (all clear)
+// [in] trueBits  - the bits selected where mask is set
+// [in] falseBits - the bits selected where mask is clear
+//
+// Returns the selected bits.
+//
+SBFP_TARGET_AVX2
+static inline __m256i select_avx2(__m256i mask, __m256i trueBits, __m256i falseBits)
+{
+	return _mm256_blendv_epi8(falseBits, trueBits, mask);
+}
+
+//
+// Translates sbfp values in 16-bit lanes to binary16 with AVX2 (see sbfp_core_to_binary16).
+//
+// [in] bits - the sbfp values
+//
+// Returns the binary16 bits.
+//
+SBFP_TARGET_AVX2
+static inline __m256i to_binary16_avx2(__m256i bits)
+{
+#ifdef SBFP_IEEE_BINARY16
+	return bits;
+#else
+	__m256i isPosInf = _mm256_cmpeq_epi16(bits, _mm256_set1_epi16(SBFP_LEGACY_POS_INF));
+	__m256i isNegInf = _mm256_cmpeq_epi16(bits, _mm256_set1_epi16(SBFP_LEGACY_NEG_INF));
+	__m256i isNan    = _mm256_cmpeq_epi16(bits, _mm256_set1_epi16(SBFP_LEGACY_NAN));
+
+	__m256i flipBits = _mm256_or_si256(_mm256_or_si256(_mm256_and_si256(isPosInf, _mm256_set1_epi16(SBFP_LEGACY_POS_INF ^ BINARY16_POS_INF)),
+	                                                   _mm256_and_si256(isNegInf, _mm256_set1_epi16((short)(SBFP_LEGACY_NEG_INF ^ BINARY16_NEG_INF)))),
+	                                   _mm256_and_si256(isNan, _mm256_set1_epi16(SBFP_LEGACY_NAN ^ BINARY16_NAN)));
+
+	return _mm256_xor_si256(bits, flipBits);
+#endif
+}
+
+//
+// Selects infinity with the given signs in 16-bit lanes with AVX2.
+//
+// [in] sign - the signs, in bit 15 of each lane
+//
+// Returns SBFP_NEG_INF where the sign is set, and SBFP_POS_INF elsewhere.
+//
+SBFP_TARGET_AVX2
+static inline __m256i signed_inf_avx2(__m256i sign)
+{
+#ifdef SBFP_IEEE_BINARY16
+	return _mm256_or_si256(_mm256_set1_epi16(SBFP_POS_INF), sign);
+#else
+	return select_avx2(_mm256_srai_epi16(sign, 15), _mm256_set1_epi16(SBFP_NEG_INF), _mm256_set1_epi16(SBFP_POS_INF));
+#endif
+}
+
+//
+// Packs positive magnitudes into binary16 bits in 16-bit lanes with AVX2, rounding to
+// nearest even like sbfp_core_pack_binary16. The significand is shifted down to the frac of
+// a normal or subnormal result, and magnitudes that round to 2^16 or above become infinity.
+//
+// [in] sig    - the significands, normalized so that bit 15 is their leading bit
+// [in] expo   - the biased expos of bit 15 of the significands
+// [in] sticky - 1 where nonzero bits lie below the significands, 0 elsewhere
+//
+// Returns the binary16 bits, without a sign.
+//
+SBFP_TARGET_AVX2
+static inline __m256i pack_binary16_avx2(__m256i sig, __m256i expo, __m256i sticky)
+{
+	const int sigShift = 16 - (15 - SBFP_BIT_COUNT_FRAC); // the shift of a normal frac, as a power for _mm_mulhi_epu16
+
+	__m256i zero = _mm256_setzero_si256();
+	__m256i one  = _mm256_set1_epi16(1);
+
+	__m256i sbfpExpo = _mm256_max_epi16(expo, one);
+	__m256i subShift = _mm256_sub_epi16(sbfpExpo, expo);
+	__m256i power    = pow2_avx2(_mm256_sub_epi16(_mm256_set1_epi16(sigShift), _mm256_min_epi16(subShift, _mm256_set1_epi16(sigShift))));
+
+	//
+	// Split the significand into the frac kept and the bits dropped, which are aligned to bit
+	// 15 with the sticky bit below them. A shift beyond the significand leaves less than half
+	// of the smallest subnormal, so nothing is kept or rounded up:
+	//
+	__m256i kept    = _mm256_mulhi_epu16(sig, power);
+	__m256i dropped = _mm256_or_si256(_mm256_mullo_epi16(sig, power), sticky);
+
+	dropped = _mm256_andnot_si256(_mm256_cmpgt_epi16(subShift, _mm256_set1_epi16(sigShift)), dropped);
+
+	//
+	// Round up above half, or at half to an even frac, comparing the dropped bits unsigned
+	// by flipping bit 15. A carry out of the frac simply moves to the next expo:
+	//
+	__m256i roundUp = _mm256_cmpgt_epi16(_mm256_xor_si256(dropped, _mm256_set1_epi16((short)0x8000)), _mm256_sub_epi16(zero, _mm256_and_si256(kept, one)));
+
+	__m256i bits = _mm256_add_epi16(_mm256_slli_epi16(_mm256_sub_epi16(sbfpExpo, one), SBFP_BIT_COUNT_FRAC), kept);
+
+	bits = _mm256_sub_epi16(bits, roundUp);
+
+#if SBFP_ZERO_MIN_NORMAL
+	//
+	// Magnitudes that round to 2^-14 become the largest subnormal, or the next value up if
+	// they are above 2^-14:
+	//
+	__m256i isNotAbove = _mm256_or_si256(_mm256_cmpeq_epi16(dropped, zero), roundUp);
+	__m256i neighbour  = _mm256_add_epi16(_mm256_set1_epi16(SBFP_FRAC_MASK), _mm256_andnot_si256(isNotAbove, _mm256_set1_epi16(2)));
+
+	bits = select_avx2(_mm256_cmpeq_epi16(bits, _mm256_set1_epi16(1 << SBFP_BIT_COUNT_FRAC)), neighbour, bits);
+#endif
+
+	return select_avx2(_mm256_cmpgt_epi16(expo, _mm256_set1_epi16(SBFP_EXPO_MASK - 1)), _mm256_set1_epi16(BINARY16_POS_INF), bits);
+}
+
+//
+// Packs positive magnitudes into binary16 bits in 16-bit lanes with AVX2, like
+// pack_binary16_avx2 but only for lanes whose expo lies from 2 to SBFP_EXPO_MASK - 2, so
+// that the result is normal and finite even after rounding up (and is not 2^-14).
+//
+// [in] sig    - the significands, normalized so that bit 15 is their leading bit
+// [in] expo   - the biased expos of bit 15 of the significands
+// [in] sticky - 1 where nonzero bits lie below the significands, 0 elsewhere
+//
+// Returns the binary16 bits, without a sign.
+//
+SBFP_TARGET_AVX2
+static inline __m256i pack_normal_avx2(__m256i sig, __m256i expo, __m256i sticky)
+{
+	const int droppedBits = 15 - SBFP_BIT_COUNT_FRAC;
+
+	__m256i one = _mm256_set1_epi16(1);
+
+	//
+	// Round up above half, or at half to an even frac. The sticky bit lies below the half
+	// bit, so it can share the dropped bits, and adding just under half (plus the low bit of
+	// the frac) carries into the bit above them exactly when the value rounds up:
+	//
+	__m256i kept    = _mm256_srli_epi16(sig, droppedBits);
+	__m256i dropped = _mm256_and_si256(_mm256_or_si256(sig, sticky), _mm256_set1_epi16((1 << droppedBits) - 1));
+	__m256i roundUp = _mm256_add_epi16(_mm256_add_epi16(dropped, _mm256_set1_epi16((1 << (droppedBits - 1)) - 1)), _mm256_and_si256(kept, one));
+
+	kept = _mm256_add_epi16(kept, _mm256_srli_epi16(roundUp, droppedBits));
+
+	return _mm256_add_epi16(_mm256_slli_epi16(_mm256_sub_epi16(expo, one), SBFP_BIT_COUNT_FRAC), kept);
+}
+
+//
+// Finds the lanes in 16-bit lanes with AVX2 whose operands or result are not normal, or
+// whose result may round up to infinity, for pack_normal_avx2.
+//
+// [in] sbfpExpoLow  - the lower expo of the operands
+// [in] sbfpExpoHigh - the higher expo of the operands
+// [in] expo         - the biased expo of bit 15 of the significand of the result
+//
+// Returns all bits set in those lanes, and all clear elsewhere.
+//
+SBFP_TARGET_AVX2
+static inline __m256i is_not_normal_avx2(__m256i sbfpExpoLow, __m256i sbfpExpoHigh, __m256i expo)
+{
+	__m256i one = _mm256_set1_epi16(1);
+
+	__m256i isBelow = _mm256_cmpgt_epi16(one, _mm256_min_epi16(sbfpExpoLow, _mm256_sub_epi16(expo, one)));
+	__m256i isAbove = _mm256_cmpgt_epi16(_mm256_max_epi16(sbfpExpoHigh, _mm256_add_epi16(expo, one)), _mm256_set1_epi16(SBFP_EXPO_MASK - 1));
+
+	return _mm256_or_si256(isBelow, isAbove);
+}
+
+//
+// Finds the infinities and NaN of the original encoding in 16-bit lanes with AVX2 that
+// have the expo of a normal value, SBFP_LEGACY_POS_INF and SBFP_LEGACY_NAN.
+//
+// [in] bits - the sbfp values
+//
+// Returns all bits set in those lanes, and all clear elsewhere (always clear with
+// SBFP_IEEE_BINARY16).
+//
+SBFP_TARGET_AVX2
+static inline __m256i is_legacy_special_avx2(__m256i bits)
+{
+#ifdef SBFP_IEEE_BINARY16
+	(void)bits;
+
+	return _mm256_setzero_si256();
+#else
+	return _mm256_cmpeq_epi16(_mm256_and_si256(bits, _mm256_set1_epi16(~1)), _mm256_set1_epi16(SBFP_LEGACY_POS_INF));
+#endif
+}
+
+//
+// Multiplies sbfp values in 16-bit lanes with AVX2 (see sbfp_mul).
+//
+// The smaller significand is the only one that can be subnormal in a product that does not
+// round to zero, so only it is normalized, with its leading bit at bit 15. The high half
+// of its product with the other significand then has its leading bit at bit 14 or 15, and
+// the low half, like the bit the high half may be shifted by, only decides the sticky bit.
+//
+// [in] bits1 - the multiplicands
+// [in] bits2 - the multipliers
+//
+// Returns the products.
+//
+SBFP_TARGET_AVX2
+static inline __m256i multiply_avx2(__m256i bits1, __m256i bits2)
+{
+	__m256i zero     = _mm256_setzero_si256();
+	__m256i one      = _mm256_set1_epi16(1);
+	__m256i fracMask = _mm256_set1_epi16(SBFP_FRAC_MASK);
+	__m256i infBits  = _mm256_set1_epi16(BINARY16_POS_INF);
+
+	bits1 = to_binary16_avx2(bits1);
+	bits2 = to_binary16_avx2(bits2);
+
+	//
+	// Extract the magnitude, frac and expo of both sbfp values, and the sign of the product:
+	//
+	__m256i magnitude1 = _mm256_and_si256(bits1, _mm256_set1_epi16(SBFP_BIT_MASK >> SBFP_BIT_COUNT_SIGN));
+	__m256i magnitude2 = _mm256_and_si256(bits2, _mm256_set1_epi16(SBFP_BIT_MASK >> SBFP_BIT_COUNT_SIGN));
+
+	__m256i sbfpExpo1 = _mm256_srli_epi16(magnitude1, SBFP_BIT_COUNT_FRAC);
+	__m256i sbfpExpo2 = _mm256_srli_epi16(magnitude2, SBFP_BIT_COUNT_FRAC);
+
+	__m256i sign = _mm256_and_si256(_mm256_xor_si256(bits1, bits2), _mm256_set1_epi16((short)(1 << (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC))));
+
+	//
+	// Determine the significands (with the implicit bit for normals), and normalize the
+	// smaller one:
+	//
+	__m256i M1 = _mm256_or_si256(_mm256_and_si256(magnitude1, fracMask), _mm256_slli_epi16(_mm256_min_epi16(sbfpExpo1, one), SBFP_BIT_COUNT_FRAC));
+	__m256i M2 = _mm256_or_si256(_mm256_and_si256(magnitude2, fracMask), _mm256_slli_epi16(_mm256_min_epi16(sbfpExpo2, one), SBFP_BIT_COUNT_FRAC));
+
+	__m256i MLow  = _mm256_min_epi16(M1, M2);
+	__m256i MHigh = _mm256_max_epi16(M1, M2);
+
+	__m256i log2Low = log2_avx2(MLow);
+
+	MLow  = _mm256_mullo_epi16(MLow, pow2_avx2(_mm256_sub_epi16(_mm256_set1_epi16(15), log2Low)));
+	MHigh = _mm256_slli_epi16(MHigh, 15 - SBFP_BIT_COUNT_FRAC);
+
+	//
+	// Multiply the significands, and move the leading bit of the product to bit 15. The
+	// expo of bit 15 is the sum of the expos, less the normalization of MLow:
+	//
+	__m256i product = _mm256_mulhi_epu16(MLow, MHigh);
+	__m256i carry   = _mm256_srai_epi16(product, 15);
+	__m256i sticky  = _mm256_add_epi16(_mm256_cmpeq_epi16(_mm256_mullo_epi16(MLow, MHigh), zero), one);
+
+	product = select_avx2(carry, product, _mm256_slli_epi16(product, 1));
+
+	__m256i expo = _mm256_add_epi16(_mm256_max_epi16(sbfpExpo1, one), _mm256_max_epi16(sbfpExpo2, one));
+
+	expo = _mm256_sub_epi16(_mm256_add_epi16(expo, log2Low), carry);
+	expo = _mm256_sub_epi16(expo, _mm256_set1_epi16(SBFP_BIAS + SBFP_BIT_COUNT_FRAC));
+
+	__m256i bits = pack_binary16_avx2(product, expo, sticky);
+
+	//
+	// Select zero, infinity and NaN, and concatenate the sign (an exact zero has none unless
+	// SBFP_SIGNED_ZERO):
+	//
+	__m256i isZero = _mm256_or_si256(_mm256_cmpeq_epi16(magnitude1, zero), _mm256_cmpeq_epi16(magnitude2, zero));
+	__m256i isInf  = _mm256_or_si256(_mm256_cmpeq_epi16(magnitude1, infBits), _mm256_cmpeq_epi16(magnitude2, infBits));
+	__m256i isNan  = _mm256_or_si256(_mm256_or_si256(_mm256_cmpgt_epi16(magnitude1, infBits), _mm256_cmpgt_epi16(magnitude2, infBits)),
+	                                 _mm256_and_si256(isInf, isZero));
+
+	isInf = _mm256_or_si256(isInf, _mm256_andnot_si256(isZero, _mm256_cmpeq_epi16(bits, infBits)));
+	bits  = _mm256_andnot_si256(isZero, bits);
+
+#if !SBFP_SIGNED_ZERO
+	sign = _mm256_andnot_si256(isZero, sign);
+#endif
+
+	bits = _mm256_or_si256(bits, sign);
+	bits = select_avx2(isInf, signed_inf_avx2(sign), bits);
+
+	return select_avx2(isNan, _mm256_set1_epi16(SBFP_NAN), bits);
+}
+
+//
+// Multiplies sbfp values in 16-bit lanes with AVX2, for normal operands whose products are
+// normal. Both significands then have their implicit bit, so neither needs normalizing, and
+// no lane needs the translation of special values or their selection (see multiply_avx2).
+//
+// [in]  bits1   - the multiplicands
+// [in]  bits2   - the multipliers
+// [out] isOther - all bits set in the lanes this does not cover, and all clear elsewhere
+//
+// Returns the products, in the lanes covered.
+//
+SBFP_TARGET_AVX2
+static inline __m256i multiply_normal_avx2(__m256i bits1, __m256i bits2, __m256i *isOther)
+{
+	__m256i zero     = _mm256_setzero_si256();
+	__m256i one      = _mm256_set1_epi16(1);
+	__m256i signMask = _mm256_set1_epi16((short)(1 << (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC)));
+
+	__m256i sbfpExpo1 = _mm256_srli_epi16(_mm256_andnot_si256(signMask, bits1), SBFP_BIT_COUNT_FRAC);
+	__m256i sbfpExpo2 = _mm256_srli_epi16(_mm256_andnot_si256(signMask, bits2), SBFP_BIT_COUNT_FRAC);
+
+	//
+	// Shift the fracs up to bit 14, which leaves only the lowest expo bit at bit 15, and set
+	// the implicit bit there:
+	//
+	__m256i M1 = _mm256_or_si256(_mm256_slli_epi16(bits1, 15 - SBFP_BIT_COUNT_FRAC), signMask);
+	__m256i M2 = _mm256_or_si256(_mm256_slli_epi16(bits2, 15 - SBFP_BIT_COUNT_FRAC), signMask);
+
+	__m256i product = _mm256_mulhi_epu16(M1, M2);
+	__m256i carry   = _mm256_srai_epi16(product, 15);
+	__m256i sticky  = _mm256_add_epi16(_mm256_cmpeq_epi16(_mm256_mullo_epi16(M1, M2), zero), one);
+
+	product = select_avx2(carry, product, _mm256_slli_epi16(product, 1));
+
+	__m256i expo = _mm256_sub_epi16(_mm256_add_epi16(sbfpExpo1, sbfpExpo2), _mm256_add_epi16(carry, _mm256_set1_epi16(SBFP_BIAS)));
+
+	*isOther = _mm256_or_si256(is_legacy_special_avx2(bits1), is_legacy_special_avx2(bits2));
+	*isOther = _mm256_or_si256(*isOther, is_not_normal_avx2(_mm256_min_epi16(sbfpExpo1, sbfpExpo2), _mm256_max_epi16(sbfpExpo1, sbfpExpo2), expo));
+
+	return _mm256_or_si256(pack_normal_avx2(product, expo, sticky), _mm256_and_si256(_mm256_xor_si256(bits1, bits2), signMask));
+}
+
+//
+// Adds sbfp values in 16-bit lanes with AVX2, or subtracts the second from the first (see
+// sbfp_add).
+//
+// The operands are ordered by magnitude, and the smaller one's significand is aligned to
+// the larger one's with 3 guard bits. The bits shifted out of it are kept as a sticky bit,
+// which a subtraction takes away, and which the rounding of the sum then sees, so the sum
+// rounds as the exact one would.
+//
+// [in] bits1   - the augends
+// [in] bits2   - the addends
+// [in] negate2 - 1 to subtract the addends, 0 to add them
+//
+// Returns the sums.
+//
+SBFP_TARGET_AVX2
+static inline __m256i add_avx2(__m256i bits1, __m256i bits2, int negate2)
+{
+	const int guardBits = 3;
+
+	__m256i zero     = _mm256_setzero_si256();
+	__m256i one      = _mm256_set1_epi16(1);
+	__m256i fracMask = _mm256_set1_epi16(SBFP_FRAC_MASK);
+	__m256i signMask = _mm256_set1_epi16((short)(1 << (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC)));
+	__m256i infBits  = _mm256_set1_epi16(BINARY16_POS_INF);
+
+	bits1 = to_binary16_avx2(bits1);
+	bits2 = _mm256_xor_si256(to_binary16_avx2(bits2), _mm256_and_si256(signMask, _mm256_set1_epi16((short)-negate2)));
+
+	//
+	// Extract the magnitudes, ordered so that X is the larger one, the sign of X, and
+	// whether the signs differ:
+	//
+	__m256i magnitude1 = _mm256_and_si256(bits1, _mm256_set1_epi16(SBFP_BIT_MASK >> SBFP_BIT_COUNT_SIGN));
+	__m256i magnitude2 = _mm256_and_si256(bits2, _mm256_set1_epi16(SBFP_BIT_MASK >> SBFP_BIT_COUNT_SIGN));
+
+	__m256i magnitudeX = _mm256_max_epi16(magnitude1, magnitude2);
+	__m256i magnitudeY = _mm256_min_epi16(magnitude1, magnitude2);
+
+	__m256i signX         = _mm256_and_si256(select_avx2(_mm256_cmpgt_epi16(magnitude2, magnitude1), bits2, bits1), signMask);
+	__m256i isSubtraction = _mm256_srai_epi16(_mm256_xor_si256(bits1, bits2), 15);
+
+	//
+	// Determine the significands (with the implicit bit for normals) and expos:
+	//
+	__m256i sbfpExpoX = _mm256_srli_epi16(magnitudeX, SBFP_BIT_COUNT_FRAC);
+	__m256i sbfpExpoY = _mm256_srli_epi16(magnitudeY, SBFP_BIT_COUNT_FRAC);
+
+	__m256i MX = _mm256_or_si256(_mm256_and_si256(magnitudeX, fracMask), _mm256_slli_epi16(_mm256_min_epi16(sbfpExpoX, one), SBFP_BIT_COUNT_FRAC));
+	__m256i MY = _mm256_or_si256(_mm256_and_si256(magnitudeY, fracMask), _mm256_slli_epi16(_mm256_min_epi16(sbfpExpoY, one), SBFP_BIT_COUNT_FRAC));
+
+	sbfpExpoX = _mm256_max_epi16(sbfpExpoX, one);
+	sbfpExpoY = _mm256_max_epi16(sbfpExpoY, one);
+
+	//
+	// Align MY to MX. A shift of 15 or more leaves only the sticky bit:
+	//
+	__m256i alignPower = pow2_avx2(_mm256_sub_epi16(_mm256_set1_epi16(15), _mm256_min_epi16(_mm256_sub_epi16(sbfpExpoX, sbfpExpoY), _mm256_set1_epi16(15))));
+
+	MY = _mm256_slli_epi16(MY, guardBits + 1);
+
+	__m256i sticky = _mm256_add_epi16(_mm256_cmpeq_epi16(_mm256_mullo_epi16(MY, alignPower), zero), one);
+
+	MY = _mm256_mulhi_epu16(MY, alignPower);
+	MX = _mm256_slli_epi16(MX, guardBits);
+
+	__m256i M = select_avx2(isSubtraction, _mm256_sub_epi16(_mm256_sub_epi16(MX, MY), sticky), _mm256_add_epi16(MX, MY));
+
+	//
+	// Move the leading bit of the sum to bit 15, and pack it:
+	//
+	__m256i log2Sum = log2_avx2(M);
+	__m256i expo    = _mm256_add_epi16(sbfpExpoX, _mm256_sub_epi16(log2Sum, _mm256_set1_epi16(SBFP_BIT_COUNT_FRAC + guardBits)));
+
+	__m256i bits = pack_binary16_avx2(_mm256_mullo_epi16(M, pow2_avx2(_mm256_sub_epi16(_mm256_set1_epi16(15), log2Sum))), expo, sticky);
+
+	//
+	// Concatenate the sign (an exact zero sum is negative only if both operands are, and
+	// has no sign unless SBFP_SIGNED_ZERO), and select infinity and NaN:
+	//
+	__m256i isZero = _mm256_cmpeq_epi16(M, zero);
+	__m256i isInf1 = _mm256_cmpeq_epi16(magnitude1, infBits);
+	__m256i isInf2 = _mm256_cmpeq_epi16(magnitude2, infBits);
+	__m256i isNan  = _mm256_or_si256(_mm256_or_si256(_mm256_cmpgt_epi16(magnitude1, infBits), _mm256_cmpgt_epi16(magnitude2, infBits)),
+	                                 _mm256_and_si256(_mm256_and_si256(isInf1, isInf2), isSubtraction));
+
+	__m256i isInf = _mm256_or_si256(_mm256_or_si256(isInf1, isInf2), _mm256_andnot_si256(isZero, _mm256_cmpeq_epi16(bits, infBits)));
+
+	bits = _mm256_or_si256(bits, signX);
+
+#if SBFP_SIGNED_ZERO
+	bits = select_avx2(isZero, _mm256_and_si256(_mm256_and_si256(bits1, bits2), signMask), bits);
+#else
+	bits = _mm256_andnot_si256(isZero, bits);
+#endif
+
+	bits = select_avx2(isInf, signed_inf_avx2(signX), bits);
+
+	return select_avx2(isNan, _mm256_set1_epi16(SBFP_NAN), bits);
+}
+
+//
+// Adds sbfp values in 16-bit lanes with AVX2, or subtracts the second from the first, for
+// normal operands whose sums are normal. No lane then needs the translation of special
+// values or their selection, and the leading bit of the sum is moved to bit 15 by taking
+// the frac of its float conversion (see add_avx2).
+//
+// [in]  bits1   - the augends
+// [in]  bits2   - the addends
+// [in]  negate2 - 1 to subtract the addends, 0 to add them
+// [out] isOther - all bits set in the lanes this does not cover, and all clear elsewhere
+//
+// Returns the sums, in the lanes covered.
+//
+SBFP_TARGET_AVX2
+static inline __m256i add_normal_avx2(__m256i bits1, __m256i bits2, int negate2, __m256i *isOther)
+{
+	const int guardBits = 3;
+
+	__m256i zero     = _mm256_setzero_si256();
+	__m256i one      = _mm256_set1_epi16(1);
+	__m256i signMask = _mm256_set1_epi16((short)(1 << (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC)));
+
+	*isOther = _mm256_or_si256(is_legacy_special_avx2(bits1), is_legacy_special_avx2(bits2));
+
+	bits2 = _mm256_xor_si256(bits2, _mm256_and_si256(signMask, _mm256_set1_epi16((short)-negate2)));
+
+	//
+	// Order the magnitudes, and align the smaller significand to the larger one as add_avx2
+	// does:
+	//
+	__m256i magnitude1 = _mm256_andnot_si256(signMask, bits1);
+	__m256i magnitude2 = _mm256_andnot_si256(signMask, bits2);
+
+	__m256i magnitudeX = _mm256_max_epi16(magnitude1, magnitude2);
+	__m256i magnitudeY = _mm256_min_epi16(magnitude1, magnitude2);
+
+	__m256i isSubtraction = _mm256_srai_epi16(_mm256_xor_si256(bits1, bits2), 15);
+	__m256i signX         = _mm256_and_si256(_mm256_xor_si256(bits1, _mm256_and_si256(_mm256_cmpgt_epi16(magnitude2, magnitude1), isSubtraction)), signMask);
+
+	__m256i sbfpExpoX = _mm256_srli_epi16(magnitudeX, SBFP_BIT_COUNT_FRAC);
+	__m256i sbfpExpoY = _mm256_srli_epi16(magnitudeY, SBFP_BIT_COUNT_FRAC);
+
+	//
+	// Shift the fracs up to bit 14 and set the implicit bit at bit 15 (see
+	// multiply_normal_avx2), then down to where add_avx2 has them:
+	//
+	__m256i MX = _mm256_or_si256(_mm256_slli_epi16(magnitudeX, 15 - SBFP_BIT_COUNT_FRAC), signMask);
+	__m256i MY = _mm256_or_si256(_mm256_slli_epi16(magnitudeY, 15 - SBFP_BIT_COUNT_FRAC), signMask);
+
+	__m256i alignPower = pow2_avx2(_mm256_sub_epi16(_mm256_set1_epi16(15), _mm256_min_epi16(_mm256_sub_epi16(sbfpExpoX, sbfpExpoY), _mm256_set1_epi16(15))));
+
+	MY = _mm256_srli_epi16(MY, 15 - SBFP_BIT_COUNT_FRAC - (guardBits + 1));
+
+	__m256i sticky = _mm256_add_epi16(_mm256_cmpeq_epi16(_mm256_mullo_epi16(MY, alignPower), zero), one);
+
+	MY = _mm256_mulhi_epu16(MY, alignPower);
+	MX = _mm256_srli_epi16(MX, 15 - SBFP_BIT_COUNT_FRAC - guardBits);
+
+	__m256i M = select_avx2(isSubtraction, _mm256_sub_epi16(_mm256_sub_epi16(MX, MY), sticky), _mm256_add_epi16(MX, MY));
+
+	//
+	// The float conversion of the sum is exact, and its frac is the sum shifted so that the
+	// leading bit is implicit, so the bits from bit 8 of the float up hold the normalized
+	// sum in their low 16 bits, with its implicit bit replaced by the lowest bit of the expo.
+	// A zero sum gives an expo that lies outside the range covered:
+	//
+	__m256i fltEven = _mm256_castps_si256(_mm256_cvtepi32_ps(_mm256_and_si256(M, _mm256_set1_epi32(0xFFFF))));
+	__m256i fltOdd  = _mm256_castps_si256(_mm256_cvtepi32_ps(_mm256_srli_epi32(M, 16)));
+
+	__m256i log2Sum = _mm256_blend_epi16(_mm256_srli_epi32(fltEven, FLOAT_BIT_COUNT_FRAC), _mm256_srli_epi32(fltOdd, FLOAT_BIT_COUNT_FRAC - 16), 0xAA);
+	__m256i sig     = _mm256_blend_epi16(_mm256_srli_epi32(fltEven, FLOAT_BIT_COUNT_FRAC - 15), _mm256_slli_epi32(fltOdd, 16 - (FLOAT_BIT_COUNT_FRAC - 15)), 0xAA);
+
+	__m256i expo = _mm256_add_epi16(sbfpExpoX, _mm256_sub_epi16(log2Sum, _mm256_set1_epi16(FLOAT_BIAS + SBFP_BIT_COUNT_FRAC + guardBits)));
+
+	*isOther = _mm256_or_si256(*isOther, is_not_normal_avx2(sbfpExpoY, sbfpExpoX, expo));
+
+	return _mm256_or_si256(pack_normal_avx2(_mm256_or_si256(sig, signMask), expo, sticky), signX);
+}
+
+//
+// Adds arrays of sbfp16_t values with AVX2, or subtracts the second from the first.
+//
+// [in]  sbfpValues1 - the augends
+// [in]  sbfpStride1 - 1 if the augends are contiguous, or 0 to repeat the first one
+// [in]  sbfpValues2 - the addends
+// [in]  sbfpStride2 - 1 if the addends are contiguous, or 0 to repeat the first one
+// [out] sbfpResults - the sums
+// [in]  count       - the number of elements available
+// [in]  negate2     - 1 to subtract the addends, 0 to add them
+//
+// Returns the number of elements computed, a multiple of 16.
+//
+SBFP_TARGET_AVX2
+static size_t add_arrays_avx2(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp16_t *sbfpResults, size_t count, int negate2)
+{
+	sbfp16_t repeated1[16];
+	sbfp16_t repeated2[16];
+
+	const sbfp16_t *sbfpSource1 = lane_source(sbfpValues1, sbfpStride1, repeated1, 16, count);
+	const sbfp16_t *sbfpSource2 = lane_source(sbfpValues2, sbfpStride2, repeated2, 16, count);
+
+	size_t index = 0;
+
+	while (index + 16 <= count)
+	{
+		//
+		// Compute a block of up to 64 vectors with add_normal_avx2, noting the ones it does
+		// not cover, and then those with add_avx2. The second loop reads their operands
+		// again, so the first one leaves their results unstored for in-place operation:
+		//
+		size_t   vectorCount = ((count - index) / 16 < 64) ? (count - index) / 16 : 64;
+		uint64_t isOther     = 0;
+
+		for (size_t vector = 0; vector < vectorCount; ++vector)
+		{
+			size_t at = index + vector * 16;
+
+			__m256i bits1 = _mm256_loadu_si256((const __m256i *)(sbfpSource1 + at * sbfpStride1));
+			__m256i bits2 = _mm256_loadu_si256((const __m256i *)(sbfpSource2 + at * sbfpStride2));
+
+			__m256i isOtherLane;
+			__m256i bits = add_normal_avx2(bits1, bits2, negate2, &isOtherLane);
+
+			if (_mm256_testz_si256(isOtherLane, isOtherLane))
+			{
+				_mm256_storeu_si256((__m256i *)(sbfpResults + at), bits);
+			}
+			else
+			{
+				isOther |= (uint64_t)1 << vector;
+			}
+		}
+
+		for (size_t vector = 0; isOther != 0; ++vector, isOther >>= 1)
+		{
+			if ((isOther & 1) != 0)
+			{
+				size_t at = index + vector * 16;
+
+				__m256i bits1 = _mm256_loadu_si256((const __m256i *)(sbfpSource1 + at * sbfpStride1));
+				__m256i bits2 = _mm256_loadu_si256((const __m256i *)(sbfpSource2 + at * sbfpStride2));
+
+				_mm256_storeu_si256((__m256i *)(sbfpResults + at), add_avx2(bits1, bits2, negate2));
+			}
+		}
+
+		index += vectorCount * 16;
+	}
+
+	return index;
+}
+
+//
+// Adds arrays of sbfp16_t values with AVX2 (see sbfp_add).
+//
+// [in]  sbfpValues1 - the augends
+// [in]  sbfpStride1 - 1 if the augends are contiguous, or 0 to repeat the first one
+// [in]  sbfpValues2 - the addends
+// [in]  sbfpStride2 - 1 if the addends are contiguous, or 0 to repeat the first one
+// [out] sbfpResults - the sums
+// [in]  count       - the number of elements available
+//
+// Returns the number of elements computed, a multiple of 16. The caller computes the rest.
+//
+SBFP_TARGET_AVX2
+size_t sbfp_avx2_sbfp16_add(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp16_t *sbfpResults, size_t count)
+{
+	return add_arrays_avx2(sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, count, 0);
+}
+
+//
+// Subtracts arrays of sbfp16_t values with AVX2 (see sbfp_sub).
+//
+// [in]  sbfpValues1 - the minuends
+// [in]  sbfpStride1 - 1 if the minuends are contiguous, or 0 to repeat the first one
+// [in]  sbfpValues2 - the subtrahends
+// [in]  sbfpStride2 - 1 if the subtrahends are contiguous, or 0 to repeat the first one
+// [out] sbfpResults - the differences
+// [in]  count       - the number of elements available
+//
+// Returns the number of elements computed, a multiple of 16. The caller computes the rest.
+//
+SBFP_TARGET_AVX2
+size_t sbfp_avx2_sbfp16_sub(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp16_t *sbfpResults, size_t count)
+{
+	return add_arrays_avx2(sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, count, 1);
+}
+
+//
+// Multiplies arrays of sbfp16_t values with AVX2 (see sbfp_mul).
+//
+// [in]  sbfpValues1 - the multiplicands
+// [in]  sbfpStride1 - 1 if the multiplicands are contiguous, or 0 to repeat the first one
+// [in]  sbfpValues2 - the multipliers
+// [in]  sbfpStride2 - 1 if the multipliers are contiguous, or 0 to repeat the first one
+// [out] sbfpResults - the products
+// [in]  count       - the number of elements available
+//
+// Returns the number of elements computed, a multiple of 16. The caller computes the rest.
+//
+SBFP_TARGET_AVX2
+size_t sbfp_avx2_sbfp16_mul(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp16_t *sbfpResults, size_t count)
+{
+	sbfp16_t repeated1[16];
+	sbfp16_t repeated2[16];
+
+	const sbfp16_t *sbfpSource1 = lane_source(sbfpValues1, sbfpStride1, repeated1, 16, count);
+	const sbfp16_t *sbfpSource2 = lane_source(sbfpValues2, sbfpStride2, repeated2, 16, count);
+
+	size_t index = 0;
+
+	while (index + 16 <= count)
+	{
+		//
+		// Compute a block of up to 64 vectors with multiply_normal_avx2, noting the ones it
+		// does not cover, and then those with multiply_avx2. The second loop reads their
+		// operands again, so the first one leaves their results unstored for in-place
+		// operation:
+		//
+		size_t   vectorCount = ((count - index) / 16 < 64) ? (count - index) / 16 : 64;
+		uint64_t isOther     = 0;
+
+		for (size_t vector = 0; vector < vectorCount; ++vector)
+		{
+			size_t at = index + vector * 16;
+
+			__m256i bits1 = _mm256_loadu_si256((const __m256i *)(sbfpSource1 + at * sbfpStride1));
+			__m256i bits2 = _mm256_loadu_si256((const __m256i *)(sbfpSource2 + at * sbfpStride2));
+
+			__m256i isOtherLane;
+			__m256i bits = multiply_normal_avx2(bits1, bits2, &isOtherLane);
+
+			if (_mm256_testz_si256(isOtherLane, isOtherLane))
+			{
+				_mm256_storeu_si256((__m256i *)(sbfpResults + at), bits);
+			}
+			else
+			{
+				isOther |= (uint64_t)1 << vector;
+			}
+		}
+
+		for (size_t vector = 0; isOther != 0; ++vector, isOther >>= 1)
+		{
+			if ((isOther & 1) != 0)
+			{
+				size_t at = index + vector * 16;
+
+				__m256i bits1 = _mm256_loadu_si256((const __m256i *)(sbfpSource1 + at * sbfpStride1));
+				__m256i bits2 = _mm256_loadu_si256((const __m256i *)(sbfpSource2 + at * sbfpStride2));
+
+				_mm256_storeu_si256((__m256i *)(sbfpResults + at), multiply_avx2(bits1, bits2));
+			}
+		}
+
+		index += vectorCount * 16;
+	}
+
+	return index;
+}
+
+//
+// The float-widening kernels below convert binary16 operands to float with VCVTPH2PS,
+// operate on the floats and convert back with VCVTPS2PH. A float holds the product of two
+// binary16 values exactly, so the conversion of the product rounds the exact value. A sum
+// may need rounding, so the kernels that add run with MXCSR rounding to nearest: a float
+// has more than twice the bits of a binary16 significand, so rounding to float and then to
+// binary16 gives the rounding of the exact sum.
+//
+
+//
+// Widens eight 16-bit sbfp values to floats with F16C, as the arithmetic sees them.
+//
+// [in] halves - the sbfp values
+//
+// Returns the float values.
+//
+SBFP_TARGET_F16C
+static inline __m256 widen_halves(__m128i halves)
+{
+	return _mm256_cvtph_ps(to_binary16_sse2(halves));
+}
+
+//
+// Narrows eight float results to 16-bit sbfp values with F16C, rounding them like
+// float_to_sbfp.
+//
+// [in] fltResults - the float results
+//
+// Returns the sbfp values.
+//
+SBFP_TARGET_F16C
+static inline __m128i narrow_results(__m256 fltResults)
+{
+	__m128i halves = _mm256_cvtps_ph(fltResults, _MM_FROUND_TO_NEAREST_INT);
+
+#if !SBFP_SIGNED_ZERO
+	halves = _mm_andnot_si128(zero_mask_float(fltResults), halves);
+#endif
+
+	return translate_halves(halves, fltResults);
+}
+
+//
+// Adds arrays of sbfp_t values with F16C (see sbfp_add).
+//
+// [in]  sbfpValues1 - the augends
+// [in]  sbfpValues2 - the addends
+// [out] sbfpResults - the sums
+// [in]  count       - the number of elements available
+//
+// Returns the number of elements computed, a multiple of 8. The caller computes the rest.
+//
+SBFP_TARGET_F16C
+size_t sbfp_f16c_sbfp_add(const sbfp_t *sbfpValues1, const sbfp_t *sbfpValues2, sbfp_t *sbfpResults, size_t count)
+{
+	unsigned int roundingMode = _MM_GET_ROUNDING_MODE();
+
+	_MM_SET_ROUNDING_MODE(_MM_ROUND_NEAREST);
+
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		__m256 fltValues1 = widen_halves(load_halves(sbfpValues1 + index));
+		__m256 fltValues2 = widen_halves(load_halves(sbfpValues2 + index));
+
+		store_halves(narrow_results(_mm256_add_ps(fltValues1, fltValues2)), sbfpResults + index);
+	}
+
+	_MM_SET_ROUNDING_MODE(roundingMode);
+
+	return index;
+}
+
+//
+// Subtracts arrays of sbfp_t values with F16C (see sbfp_sub).
+//
+// [in]  sbfpValues1 - the minuends
+// [in]  sbfpValues2 - the subtrahends
+// [out] sbfpResults - the differences
+// [in]  count       - the number of elements available
+//
+// Returns the number of elements computed, a multiple of 8. The caller computes the rest.
+//
+SBFP_TARGET_F16C
+size_t sbfp_f16c_sbfp_sub(const sbfp_t *sbfpValues1, const sbfp_t *sbfpValues2, sbfp_t *sbfpResults, size_t count)
+{
+	unsigned int roundingMode = _MM_GET_ROUNDING_MODE();
+
+	_MM_SET_ROUNDING_MODE(_MM_ROUND_NEAREST);
+
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		__m256 fltValues1 = widen_halves(load_halves(sbfpValues1 + index));
+		__m256 fltValues2 = widen_halves(load_halves(sbfpValues2 + index));
+
+		store_halves(narrow_results(_mm256_sub_ps(fltValues1, fltValues2)), sbfpResults + index);
+	}
+
+	_MM_SET_ROUNDING_MODE(roundingMode);
+
+	return index;
+}
+
+//
+// Multiplies arrays of sbfp_t values with F16C (see sbfp_mul).
+//
+// [in]  sbfpValues1 - the multiplicands
+// [in]  sbfpValues2 - the multipliers
+// [out] sbfpResults - the products
+// [in]  count       - the number of elements available
+//
+// Returns the number of elements computed, a multiple of 8. The caller computes the rest.
+//
+SBFP_TARGET_F16C
+size_t sbfp_f16c_sbfp_mul(const sbfp_t *sbfpValues1, const sbfp_t *sbfpValues2, sbfp_t *sbfpResults, size_t count)
+{
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		__m256 fltValues1 = widen_halves(load_halves(sbfpValues1 + index));
+		__m256 fltValues2 = widen_halves(load_halves(sbfpValues2 + index));
+
+		store_halves(narrow_results(_mm256_mul_ps(fltValues1, fltValues2)), sbfpResults + index);
+	}
+
+	return index;
+}
+
+//
+// Adds arrays of sbfp16_t values with F16C (see sbfp_add).
+//
+// [in]  sbfpValues1 - the augends
+// [in]  sbfpStride1 - 1 if the augends are contiguous, or 0 to repeat the first one
+// [in]  sbfpValues2 - the addends
+// [in]  sbfpStride2 - 1 if the addends are contiguous, or 0 to repeat the first one
+// [out] sbfpResults - the sums
+// [in]  count       - the number of elements available
+//
+// Returns the number of elements computed, a multiple of 8. The caller computes the rest.
+//
+SBFP_TARGET_F16C
+size_t sbfp_f16c_sbfp16_add(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp16_t *sbfpResults, size_t count)
+{
+	sbfp16_t repeated1[8];
+	sbfp16_t repeated2[8];
+
+	const sbfp16_t *sbfpSource1 = lane_source(sbfpValues1, sbfpStride1, repeated1, 8, count);
+	const sbfp16_t *sbfpSource2 = lane_source(sbfpValues2, sbfpStride2, repeated2, 8, count);
+
+	unsigned int roundingMode = _MM_GET_ROUNDING_MODE();
+
+	_MM_SET_ROUNDING_MODE(_MM_ROUND_NEAREST);
+
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		__m256 fltValues1 = widen_halves(_mm_loadu_si128((const __m128i *)(sbfpSource1 + index * sbfpStride1)));
+		__m256 fltValues2 = widen_halves(_mm_loadu_si128((const __m128i *)(sbfpSource2 + index * sbfpStride2)));
+
+		_mm_storeu_si128((__m128i *)(sbfpResults + index), narrow_results(_mm256_add_ps(fltValues1, fltValues2)));
+	}
+
+	_MM_SET_ROUNDING_MODE(roundingMode);
+
+	return index;
+}
+
+//
+// Subtracts arrays of sbfp16_t values with F16C (see sbfp_sub).
+//
+// [in]  sbfpValues1 - the minuends
+// [in]  sbfpStride1 - 1 if the minuends are contiguous, or 0 to repeat the first one
+// [in]  sbfpValues2 - the subtrahends
+// [in]  sbfpStride2 - 1 if the subtrahends are contiguous, or 0 to repeat the first one
+// [out] sbfpResults - the differences
+// [in]  count       - the number of elements available
+//
+// Returns the number of elements computed, a multiple of 8. The caller computes the rest.
+//
+SBFP_TARGET_F16C
+size_t sbfp_f16c_sbfp16_sub(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp16_t *sbfpResults, size_t count)
+{
+	sbfp16_t repeated1[8];
+	sbfp16_t repeated2[8];
+
+	const sbfp16_t *sbfpSource1 = lane_source(sbfpValues1, sbfpStride1, repeated1, 8, count);
+	const sbfp16_t *sbfpSource2 = lane_source(sbfpValues2, sbfpStride2, repeated2, 8, count);
+
+	unsigned int roundingMode = _MM_GET_ROUNDING_MODE();
+
+	_MM_SET_ROUNDING_MODE(_MM_ROUND_NEAREST);
+
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		__m256 fltValues1 = widen_halves(_mm_loadu_si128((const __m128i *)(sbfpSource1 + index * sbfpStride1)));
+		__m256 fltValues2 = widen_halves(_mm_loadu_si128((const __m128i *)(sbfpSource2 + index * sbfpStride2)));
+
+		_mm_storeu_si128((__m128i *)(sbfpResults + index), narrow_results(_mm256_sub_ps(fltValues1, fltValues2)));
+	}
+
+	_MM_SET_ROUNDING_MODE(roundingMode);
+
+	return index;
+}
+
+//
+// Multiplies arrays of sbfp16_t values with F16C (see sbfp_mul).
+//
+// [in]  sbfpValues1 - the multiplicands
+// [in]  sbfpStride1 - 1 if the multiplicands are contiguous, or 0 to repeat the first one
+// [in]  sbfpValues2 - the multipliers
+// [in]  sbfpStride2 - 1 if the multipliers are contiguous, or 0 to repeat the first one
+// [out] sbfpResults - the products
+// [in]  count       - the number of elements available
+//
+// Returns the number of elements computed, a multiple of 8. The caller computes the rest.
+//
+SBFP_TARGET_F16C
+size_t sbfp_f16c_sbfp16_mul(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp16_t *sbfpResults, size_t count)
+{
+	sbfp16_t repeated1[8];
+	sbfp16_t repeated2[8];
+
+	const sbfp16_t *sbfpSource1 = lane_source(sbfpValues1, sbfpStride1, repeated1, 8, count);
+	const sbfp16_t *sbfpSource2 = lane_source(sbfpValues2, sbfpStride2, repeated2, 8, count);
+
+	size_t index = 0;
+
+	for (; index + 8 <= count; index += 8)
+	{
+		__m256 fltValues1 = widen_halves(_mm_loadu_si128((const __m128i *)(sbfpSource1 + index * sbfpStride1)));
+		__m256 fltValues2 = widen_halves(_mm_loadu_si128((const __m128i *)(sbfpSource2 + index * sbfpStride2)));
+
+		_mm_storeu_si128((__m128i *)(sbfpResults + index), narrow_results(_mm256_mul_ps(fltValues1, fltValues2)));
+	}
+
+	return index;
+}
+
+//
+// The AVX-512 kernels below widen sixteen values at a time like the F16C kernels above.
+// AVX-512F has no 16-bit lane compares, so the sbfp values are kept in 32-bit lanes and the
+// special values are selected with mask registers. The sums are rounded to nearest by the
+// instruction itself, so MXCSR is left alone.
+//
+
+//
+// Translates sbfp values in 32-bit lanes to binary16 with AVX-512 (see sbfp_core_to_binary16).
+//
+// [in] bits - the sbfp values
+//
+// Returns the binary16 bits.
+//
+SBFP_TARGET_AVX512
+static inline __m512i to_binary16_avx512(__m512i bits)
+{
+#ifdef SBFP_IEEE_BINARY16
+	return bits;
+#else
+	__mmask16 isPosInf = _mm512_cmpeq_epi32_mask(bits, _mm512_set1_epi32(SBFP_LEGACY_POS_INF));
+	__mmask16 isNegInf = _mm512_cmpeq_epi32_mask(bits, _mm512_set1_epi32(SBFP_LEGACY_NEG_INF));
+	__mmask16 isNan    = _mm512_cmpeq_epi32_mask(bits, _mm512_set1_epi32(SBFP_LEGACY_NAN));
+
+	bits = _mm512_mask_mov_epi32(bits, isPosInf, _mm512_set1_epi32(BINARY16_POS_INF));
+	bits = _mm512_mask_mov_epi32(bits, isNegInf, _mm512_set1_epi32(BINARY16_NEG_INF));
+	bits = _mm512_mask_mov_epi32(bits, isNan, _mm512_set1_epi32(BINARY16_NAN));
+
+	return bits;
+#endif
+}
+
+//
+// Widens sixteen sbfp values in 32-bit lanes to floats with AVX-512, as the arithmetic sees
+// them.
+//
+// [in] bits - the sbfp values
+//
+// Returns the float values.
+//
+SBFP_TARGET_AVX512
+static inline __m512 widen_avx512(__m512i bits)
+{
+	return _mm512_cvtph_ps(_mm512_cvtepi32_epi16(to_binary16_avx512(bits)));
+}
+
+//
+// Narrows sixteen float results to sbfp values in 32-bit lanes with AVX-512, rounding
+// them like float_to_sbfp (see translate_halves).
+//
+// [in] fltResults - the float results
+//
+// Returns the sbfp values.
+//
+SBFP_TARGET_AVX512
+static inline __m512i narrow_avx512(__m512 fltResults)
+{
+	__m512i bits         = _mm512_cvtepu16_epi32(_mm512_cvtps_ph(fltResults, _MM_FROUND_TO_NEAREST_INT));
+	__m512i fltMagnitude = _mm512_and_si512(_mm512_castps_si512(fltResults), _mm512_set1_epi32(FLOAT_MAGNITUDE_MASK));
+
+#if !SBFP_SIGNED_ZERO
+	bits = _mm512_mask_mov_epi32(bits, _mm512_cmpeq_epi32_mask(fltMagnitude, _mm512_setzero_si512()), _mm512_setzero_si512());
+#endif
+
+	__m512i sbfpMagnitude = _mm512_and_si512(bits, _mm512_set1_epi32(SBFP_BIT_MASK >> SBFP_BIT_COUNT_SIGN));
+
+#if SBFP_ZERO_MIN_NORMAL
+	//
+	// Magnitudes that round to 2^-14 become the largest subnormal, or the next value up if
+	// they are above 2^-14:
+	//
+	__mmask16 isMinNormal = _mm512_cmpeq_epi32_mask(sbfpMagnitude, _mm512_set1_epi32(1 << SBFP_BIT_COUNT_FRAC));
+	__mmask16 isAbove     = _mm512_cmpgt_epi32_mask(fltMagnitude, _mm512_set1_epi32(FLOAT_SBFP_MIN_NORMAL_BITS));
+	__m512i   neighbour   = _mm512_mask_mov_epi32(_mm512_set1_epi32(SBFP_FRAC_MASK), isAbove, _mm512_set1_epi32((1 << SBFP_BIT_COUNT_FRAC) + 1));
+
+	bits = _mm512_mask_xor_epi32(bits, isMinNormal, bits, _mm512_xor_si512(sbfpMagnitude, neighbour));
+#endif
+
+	//
+	// Infinity (VCVTPS2PH rounds overflow to the binary16 infinity) and NaN:
+	//
+	__mmask16 isOverflow = _mm512_cmpeq_epi32_mask(sbfpMagnitude, _mm512_set1_epi32(BINARY16_POS_INF));
+	__mmask16 isNan      = _mm512_cmpgt_epi32_mask(fltMagnitude, _mm512_set1_epi32(FLOAT_INF_BITS));
+	__mmask16 isNegative = _mm512_test_epi32_mask(bits, _mm512_set1_epi32(1 << (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC)));
+
+	__m512i sbfpInf = _mm512_mask_mov_epi32(_mm512_set1_epi32(SBFP_POS_INF), isNegative, _mm512_set1_epi32(SBFP_NEG_INF));
+
+	bits = _mm512_mask_mov_epi32(bits, isOverflow, sbfpInf);
+	bits = _mm512_mask_mov_epi32(bits, isNan, _mm512_set1_epi32(SBFP_NAN));
+
+	return bits;
+}
+
+//
+// Applies an arithmetic operation to sixteen pairs of floats with AVX-512. A product of two
+// binary16 values is exact in a float, and a sum is rounded to nearest, so narrowing
+// either one rounds the exact result.
+//
+// [in] fltValues1 - the first operands
+// [in] fltValues2 - the second operands
+// [in] operation  - SBFP_X86_OP_ADD, SBFP_X86_OP_SUB or SBFP_X86_OP_MUL
+//
+// Returns the results.
+//
+SBFP_TARGET_AVX512
+static inline __m512 operate_avx512(__m512 fltValues1, __m512 fltValues2, int operation)
+{
+	__m512 fltResults;
+
+	if (operation == SBFP_X86_OP_ADD)
+	{
+		fltResults = _mm512_add_round_ps(fltValues1, fltValues2, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+	}
+	else if (operation == SBFP_X86_OP_SUB)
+	{
+		fltResults = _mm512_sub_round_ps(fltValues1, fltValues2, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+	}
+	else
+	{
+		fltResults = _mm512_mul_ps(fltValues1, fltValues2);
+	}
+
+	return fltResults;
+}
+
+//
+// Applies an arithmetic operation to arrays of sbfp_t values with AVX-512.
+//
+// [in]  sbfpValues1 - the first operands
+// [in]  sbfpValues2 - the second operands
+// [out] sbfpResults - the results
+// [in]  count       - the number of elements available
+// [in]  operation   - SBFP_X86_OP_ADD, SBFP_X86_OP_SUB or SBFP_X86_OP_MUL
+//
+// Returns the number of elements computed, a multiple of 16.
+//
+SBFP_TARGET_AVX512
+static inline size_t operate_sbfp_avx512(const sbfp_t *sbfpValues1, const sbfp_t *sbfpValues2, sbfp_t *sbfpResults, size_t count,
+	int operation)
+{
+	__m512i sbfpMask = _mm512_set1_epi32(SBFP_BIT_MASK);
+
+	size_t index = 0;
+
+	for (; index + 16 <= count; index += 16)
+	{
+		__m512 fltValues1 = widen_avx512(_mm512_and_si512(_mm512_loadu_si512(sbfpValues1 + index), sbfpMask));
+		__m512 fltValues2 = widen_avx512(_mm512_and_si512(_mm512_loadu_si512(sbfpValues2 + index), sbfpMask));
+
+		_mm512_storeu_si512(sbfpResults + index, narrow_avx512(operate_avx512(fltValues1, fltValues2, operation)));
+	}
+
+	return index;
+}
+
+//
+// Applies an arithmetic operation to arrays of sbfp16_t values with AVX-512.
+//
+// [in]  sbfpValues1 - the first operands
+// [in]  sbfpStride1 - 1 if the first operands are contiguous, or 0 to repeat the first one
+// [in]  sbfpValues2 - the second operands
+// [in]  sbfpStride2 - 1 if the second operands are contiguous, or 0 to repeat the first one
+// [out] sbfpResults - the results
+// [in]  count       - the number of elements available
+// [in]  operation   - SBFP_X86_OP_ADD, SBFP_X86_OP_SUB or SBFP_X86_OP_MUL
+//
+// Returns the number of elements computed, a multiple of 16.
+//
+SBFP_TARGET_AVX512
+static inline size_t operate_sbfp16_avx512(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2,
+	ptrdiff_t sbfpStride2, sbfp16_t *sbfpResults, size_t count, int operation)
+{
+	sbfp16_t repeated1[16];
+	sbfp16_t repeated2[16];
+
+	const sbfp16_t *sbfpSource1 = lane_source(sbfpValues1, sbfpStride1, repeated1, 16, count);
+	const sbfp16_t *sbfpSource2 = lane_source(sbfpValues2, sbfpStride2, repeated2, 16, count);
+
+	size_t index = 0;
+
+	for (; index + 16 <= count; index += 16)
+	{
+		__m512 fltValues1 = widen_avx512(_mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i *)(sbfpSource1 + index * sbfpStride1))));
+		__m512 fltValues2 = widen_avx512(_mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i *)(sbfpSource2 + index * sbfpStride2))));
+
+		__m512i bits = narrow_avx512(operate_avx512(fltValues1, fltValues2, operation));
+
+		_mm256_storeu_si256((__m256i *)(sbfpResults + index), _mm512_cvtepi32_epi16(bits));
+	}
+
+	return index;
+}
+
+//
+// Adds arrays of sbfp_t values with AVX-512 (see sbfp_add).
+//
+// [in]  sbfpValues1 - the augends
+// [in]  sbfpValues2 - the addends
+// [out] sbfpResults - the sums
+// [in]  count       - the number of elements available
+//
+// Returns the number of elements computed, a multiple of 16. The caller computes the rest.
+//
+SBFP_TARGET_AVX512
+size_t sbfp_avx512_sbfp_add(const sbfp_t *sbfpValues1, const sbfp_t *sbfpValues2, sbfp_t *sbfpResults, size_t count)
+{
+	return operate_sbfp_avx512(sbfpValues1, sbfpValues2, sbfpResults, count, SBFP_X86_OP_ADD);
+}
+
+//
+// Subtracts arrays of sbfp_t values with AVX-512 (see sbfp_sub).
+//
+// [in]  sbfpValues1 - the minuends
+// [in]  sbfpValues2 - the subtrahends
+// [out] sbfpResults - the differences
+// [in]  count       - the number of elements available
+//
+// Returns the number of elements computed, a multiple of 16. The caller computes the rest.
+//
+SBFP_TARGET_AVX512
+size_t sbfp_avx512_sbfp_sub(const sbfp_t *sbfpValues1, const sbfp_t *sbfpValues2, sbfp_t *sbfpResults, size_t count)
+{
+	return operate_sbfp_avx512(sbfpValues1, sbfpValues2, sbfpResults, count, SBFP_X86_OP_SUB);
+}
+
+//
+// Multiplies arrays of sbfp_t values with AVX-512 (see sbfp_mul).
+//
+// [in]  sbfpValues1 - the multiplicands
+// [in]  sbfpValues2 - the multipliers
+// [out] sbfpResults - the products
+// [in]  count       - the number of elements available
+//
+// Returns the number of elements computed, a multiple of 16. The caller computes the rest.
+//
+SBFP_TARGET_AVX512
+size_t sbfp_avx512_sbfp_mul(const sbfp_t *sbfpValues1, const sbfp_t *sbfpValues2, sbfp_t *sbfpResults, size_t count)
+{
+	return operate_sbfp_avx512(sbfpValues1, sbfpValues2, sbfpResults, count, SBFP_X86_OP_MUL);
+}
+
+//
+// Adds arrays of sbfp16_t values with AVX-512 (see sbfp_add).
+//
+// [in]  sbfpValues1 - the augends
+// [in]  sbfpStride1 - 1 if the augends are contiguous, or 0 to repeat the first one
+// [in]  sbfpValues2 - the addends
+// [in]  sbfpStride2 - 1 if the addends are contiguous, or 0 to repeat the first one
+// [out] sbfpResults - the sums
+// [in]  count       - the number of elements available
+//
+// Returns the number of elements computed, a multiple of 16. The caller computes the rest.
+//
+SBFP_TARGET_AVX512
+size_t sbfp_avx512_sbfp16_add(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp16_t *sbfpResults, size_t count)
+{
+	return operate_sbfp16_avx512(sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, count, SBFP_X86_OP_ADD);
+}
+
+//
+// Subtracts arrays of sbfp16_t values with AVX-512 (see sbfp_sub).
+//
+// [in]  sbfpValues1 - the minuends
+// [in]  sbfpStride1 - 1 if the minuends are contiguous, or 0 to repeat the first one
+// [in]  sbfpValues2 - the subtrahends
+// [in]  sbfpStride2 - 1 if the subtrahends are contiguous, or 0 to repeat the first one
+// [out] sbfpResults - the differences
+// [in]  count       - the number of elements available
+//
+// Returns the number of elements computed, a multiple of 16. The caller computes the rest.
+//
+SBFP_TARGET_AVX512
+size_t sbfp_avx512_sbfp16_sub(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp16_t *sbfpResults, size_t count)
+{
+	return operate_sbfp16_avx512(sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, count, SBFP_X86_OP_SUB);
+}
+
+//
+// Multiplies arrays of sbfp16_t values with AVX-512 (see sbfp_mul).
+//
+// [in]  sbfpValues1 - the multiplicands
+// [in]  sbfpStride1 - 1 if the multiplicands are contiguous, or 0 to repeat the first one
+// [in]  sbfpValues2 - the multipliers
+// [in]  sbfpStride2 - 1 if the multipliers are contiguous, or 0 to repeat the first one
+// [out] sbfpResults - the products
+// [in]  count       - the number of elements available
+//
+// Returns the number of elements computed, a multiple of 16. The caller computes the rest.
+//
+SBFP_TARGET_AVX512
+size_t sbfp_avx512_sbfp16_mul(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp16_t *sbfpResults, size_t count)
+{
+	return operate_sbfp16_avx512(sbfpValues1, sbfpStride1, sbfpValues2, sbfpStride2, sbfpResults, count, SBFP_X86_OP_MUL);
+}
+
+#endif
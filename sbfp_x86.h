@@ -0,0 +1,162 @@
+//
+// sbfp_x86.h
+//
+// This file contains declarations for the x86 SIMD backends of the bulk SBFP functions.
+// It is internal to the library and not meant to be included by callers.
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2021 Luke Andrews.  All Rights Reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify, merge,
+// publish, distribute, sub-license, and/or sell copies of the Software, and to permit persons
+// to whom the Software is furnished to do so, subject to the following conditions:
+//
+// * The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+// PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR 
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+#ifndef SBFP_X86_H
+#define SBFP_X86_H
+
+#include "sbfp_lib.h"
+#include <stddef.h>
+
+#if !defined(SBFP_PORTABLE) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SBFP_X86 1
+#endif
+
+#ifdef SBFP_X86
+
+// Backends, from the least to the most capable (see resolve_kernels in sbfp_x86.c):
+#define SBFP_BACKEND_SCALAR 0
+#define SBFP_BACKEND_SSE2   1
+#define SBFP_BACKEND_AVX2   2
+#define SBFP_BACKEND_F16C   3
+#define SBFP_BACKEND_AVX512 4
+#define SBFP_BACKEND_COUNT  5
+
+//
+// The kernels of the bulk functions, resolved once when the library is loaded. A NULL
+// kernel leaves every element to the portable code. Each kernel returns the number of
+// elements it computed, and the caller computes the rest.
+//
+typedef struct
+{
+	size_t (*double_to_sbfp)(const double *dblValues, sbfp_t *sbfpValues, size_t count);
+	size_t (*sbfp_to_double)(const sbfp_t *sbfpValues, double *dblValues, size_t count);
+	size_t (*float_to_sbfp)(const float *fltValues, sbfp_t *sbfpValues, size_t count);
+	size_t (*sbfp_to_float)(const sbfp_t *sbfpValues, float *fltValues, size_t count);
+	size_t (*double_to_sbfp16)(const double *dblValues, sbfp16_t *sbfpValues, size_t count);
+	size_t (*sbfp16_to_double)(const sbfp16_t *sbfpValues, double *dblValues, size_t count);
+	size_t (*float_to_sbfp16)(const float *fltValues, sbfp16_t *sbfpValues, size_t count);
+	size_t (*sbfp16_to_float)(const sbfp16_t *sbfpValues, float *fltValues, size_t count);
+	size_t (*float_to_e4m3)(const float *fltValues, sbfp8_t *sbfp8Values, size_t count);
+	size_t (*e4m3_to_float)(const sbfp8_t *sbfp8Values, float *fltValues, size_t count);
+	size_t (*float_to_e5m2)(const float *fltValues, sbfp8_t *sbfp8Values, size_t count);
+	size_t (*e5m2_to_float)(const sbfp8_t *sbfp8Values, float *fltValues, size_t count);
+	size_t (*float_to_bf16)(const float *fltValues, bf16_t *bf16Values, size_t count);
+	size_t (*float_to_bf16_rne)(const float *fltValues, bf16_t *bf16Values, size_t count);
+	size_t (*bf16_to_float)(const bf16_t *bf16Values, float *fltValues, size_t count);
+	size_t (*sbfp_to_bf16)(const sbfp_t *sbfpValues, bf16_t *bf16Values, size_t count);
+	size_t (*bf16_to_sbfp)(const bf16_t *bf16Values, sbfp_t *sbfpValues, size_t count);
+	size_t (*sbfp16_to_bf16)(const sbfp16_t *sbfpValues, bf16_t *bf16Values, size_t count);
+	size_t (*bf16_to_sbfp16)(const bf16_t *bf16Values, sbfp16_t *sbfpValues, size_t count);
+
+	size_t (*sbfp_add)(const sbfp_t *sbfpValues1, const sbfp_t *sbfpValues2, sbfp_t *sbfpResults, size_t count);
+	size_t (*sbfp_sub)(const sbfp_t *sbfpValues1, const sbfp_t *sbfpValues2, sbfp_t *sbfpResults, size_t count);
+	size_t (*sbfp_mul)(const sbfp_t *sbfpValues1, const sbfp_t *sbfpValues2, sbfp_t *sbfpResults, size_t count);
+
+	size_t (*bf16_add)(const bf16_t *bf16Values1, const bf16_t *bf16Values2, bf16_t *bf16Results, size_t count);
+	size_t (*bf16_sub)(const bf16_t *bf16Values1, const bf16_t *bf16Values2, bf16_t *bf16Results, size_t count);
+	size_t (*bf16_mul)(const bf16_t *bf16Values1, const bf16_t *bf16Values2, bf16_t *bf16Results, size_t count);
+
+	size_t (*sbfp16_add)(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+		sbfp16_t *sbfpResults, size_t count);
+	size_t (*sbfp16_sub)(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+		sbfp16_t *sbfpResults, size_t count);
+	size_t (*sbfp16_mul)(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+		sbfp16_t *sbfpResults, size_t count);
+} sbfp_x86_kernels_t;
+
+extern sbfp_x86_kernels_t sbfpX86Kernels;
+
+const char *sbfp_x86_backend_name(void);
+
+size_t sbfp_f16c_double_to_sbfp(const double *dblValues, sbfp_t *sbfpValues, size_t count);
+size_t sbfp_f16c_sbfp_to_double(const sbfp_t *sbfpValues, double *dblValues, size_t count);
+size_t sbfp_f16c_float_to_sbfp(const float *fltValues, sbfp_t *sbfpValues, size_t count);
+size_t sbfp_f16c_sbfp_to_float(const sbfp_t *sbfpValues, float *fltValues, size_t count);
+size_t sbfp_f16c_double_to_sbfp16(const double *dblValues, sbfp16_t *sbfpValues, size_t count);
+size_t sbfp_f16c_sbfp16_to_double(const sbfp16_t *sbfpValues, double *dblValues, size_t count);
+size_t sbfp_f16c_float_to_sbfp16(const float *fltValues, sbfp16_t *sbfpValues, size_t count);
+size_t sbfp_f16c_sbfp16_to_float(const sbfp16_t *sbfpValues, float *fltValues, size_t count);
+
+size_t sbfp_f16c_sbfp_add(const sbfp_t *sbfpValues1, const sbfp_t *sbfpValues2, sbfp_t *sbfpResults, size_t count);
+size_t sbfp_f16c_sbfp_sub(const sbfp_t *sbfpValues1, const sbfp_t *sbfpValues2, sbfp_t *sbfpResults, size_t count);
+size_t sbfp_f16c_sbfp_mul(const sbfp_t *sbfpValues1, const sbfp_t *sbfpValues2, sbfp_t *sbfpResults, size_t count);
+size_t sbfp_f16c_sbfp16_add(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp16_t *sbfpResults, size_t count);
+size_t sbfp_f16c_sbfp16_sub(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp16_t *sbfpResults, size_t count);
+size_t sbfp_f16c_sbfp16_mul(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp16_t *sbfpResults, size_t count);
+
+size_t sbfp_avx2_double_to_sbfp(const double *dblValues, sbfp_t *sbfpValues, size_t count);
+size_t sbfp_avx2_sbfp_to_double(const sbfp_t *sbfpValues, double *dblValues, size_t count);
+size_t sbfp_avx2_float_to_sbfp(const float *fltValues, sbfp_t *sbfpValues, size_t count);
+size_t sbfp_avx2_sbfp_to_float(const sbfp_t *sbfpValues, float *fltValues, size_t count);
+size_t sbfp_avx2_double_to_sbfp16(const double *dblValues, sbfp16_t *sbfpValues, size_t count);
+size_t sbfp_avx2_sbfp16_to_double(const sbfp16_t *sbfpValues, double *dblValues, size_t count);
+size_t sbfp_avx2_float_to_sbfp16(const float *fltValues, sbfp16_t *sbfpValues, size_t count);
+size_t sbfp_avx2_sbfp16_to_float(const sbfp16_t *sbfpValues, float *fltValues, size_t count);
+size_t sbfp_avx2_float_to_e4m3(const float *fltValues, sbfp8_t *sbfp8Values, size_t count);
+size_t sbfp_avx2_e4m3_to_float(const sbfp8_t *sbfp8Values, float *fltValues, size_t count);
+size_t sbfp_avx2_float_to_e5m2(const float *fltValues, sbfp8_t *sbfp8Values, size_t count);
+size_t sbfp_avx2_e5m2_to_float(const sbfp8_t *sbfp8Values, float *fltValues, size_t count);
+size_t sbfp_avx2_float_to_bf16(const float *fltValues, bf16_t *bf16Values, size_t count);
+size_t sbfp_avx2_float_to_bf16_rne(const float *fltValues, bf16_t *bf16Values, size_t count);
+size_t sbfp_avx2_bf16_to_float(const bf16_t *bf16Values, float *fltValues, size_t count);
+size_t sbfp_avx2_sbfp_to_bf16(const sbfp_t *sbfpValues, bf16_t *bf16Values, size_t count);
+size_t sbfp_avx2_bf16_to_sbfp(const bf16_t *bf16Values, sbfp_t *sbfpValues, size_t count);
+size_t sbfp_avx2_sbfp16_to_bf16(const sbfp16_t *sbfpValues, bf16_t *bf16Values, size_t count);
+size_t sbfp_avx2_bf16_to_sbfp16(const bf16_t *bf16Values, sbfp16_t *sbfpValues, size_t count);
+size_t sbfp_avx2_bf16_add(const bf16_t *bf16Values1, const bf16_t *bf16Values2, bf16_t *bf16Results, size_t count);
+size_t sbfp_avx2_bf16_sub(const bf16_t *bf16Values1, const bf16_t *bf16Values2, bf16_t *bf16Results, size_t count);
+size_t sbfp_avx2_bf16_mul(const bf16_t *bf16Values1, const bf16_t *bf16Values2, bf16_t *bf16Results, size_t count);
+
+size_t sbfp_sse2_sbfp16_add(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp16_t *sbfpResults, size_t count);
+size_t sbfp_sse2_sbfp16_sub(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp16_t *sbfpResults, size_t count);
+size_t sbfp_sse2_sbfp16_mul(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp16_t *sbfpResults, size_t count);
+
+size_t sbfp_avx2_sbfp16_add(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp16_t *sbfpResults, size_t count);
+size_t sbfp_avx2_sbfp16_sub(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp16_t *sbfpResults, size_t count);
+size_t sbfp_avx2_sbfp16_mul(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp16_t *sbfpResults, size_t count);
+
+size_t sbfp_avx512_sbfp_add(const sbfp_t *sbfpValues1, const sbfp_t *sbfpValues2, sbfp_t *sbfpResults, size_t count);
+size_t sbfp_avx512_sbfp_sub(const sbfp_t *sbfpValues1, const sbfp_t *sbfpValues2, sbfp_t *sbfpResults, size_t count);
+size_t sbfp_avx512_sbfp_mul(const sbfp_t *sbfpValues1, const sbfp_t *sbfpValues2, sbfp_t *sbfpResults, size_t count);
+size_t sbfp_avx512_sbfp16_add(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp16_t *sbfpResults, size_t count);
+size_t sbfp_avx512_sbfp16_sub(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp16_t *sbfpResults, size_t count);
+size_t sbfp_avx512_sbfp16_mul(const sbfp16_t *sbfpValues1, ptrdiff_t sbfpStride1, const sbfp16_t *sbfpValues2, ptrdiff_t sbfpStride2,
+	sbfp16_t *sbfpResults, size_t count);
+
+#endif
+
+#endif
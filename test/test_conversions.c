@@ -0,0 +1,314 @@
+//
+// test/test_conversions.c
+//
+// This file checks the bulk conversions between double, float and sbfp against the scalar
+// ones, with whichever backend is in use (see sbfp_backend). Every one of the 65,536 sbfp
+// patterns is decoded, and each finite sbfp magnitude is encoded with both signs, together
+// with the midpoints between it and the next one up and the doubles and floats on either
+// side of them. A large random set of doubles and floats follows, half of them near the
+// sbfp range and half with random bits. The SBFP_BACKEND environment variable selects the
+// backend to check.
+//
+// Build and run from the repository root:
+//
+//     cc -O2 -I. test/test_conversions.c sbfp_lib.c sbfp_fp8.c sbfp_bf16.c sbfp_x86.c -lm -o test_conversions
+//     SBFP_BACKEND=avx2 ./test_conversions
+//
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2021 Luke Andrews.  All Rights Reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify, merge,
+// publish, distribute, sub-license, and/or sell copies of the Software, and to permit persons
+// to whom the Software is furnished to do so, subject to the following conditions:
+//
+// * The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+// PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+#include "sbfp_const.h"
+#include "sbfp_lib.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// Values converted per call of a bulk function, and random values in all:
+#define TEST_BLOCK_COUNT  (1 << 16)
+#define TEST_RANDOM_COUNT (1 << 24)
+
+static double   testDoubles[TEST_BLOCK_COUNT];
+static float    testFloats[TEST_BLOCK_COUNT];
+static sbfp_t   testResults[TEST_BLOCK_COUNT];
+static sbfp16_t testResults16[TEST_BLOCK_COUNT];
+
+static size_t testCount;
+static long   testFailures;
+
+//
+// Gives the next value of a xorshift sequence, for random inputs that are the same on
+// every run.
+//
+// Returns the next value.
+//
+static uint64_t next_random(void)
+{
+	static uint64_t state = 88172645463325252ULL;
+
+	state ^= state << 13;
+	state ^= state >> 7;
+	state ^= state << 17;
+
+	return state;
+}
+
+//
+// Reports a result that differs from the scalar one, for the first few failures.
+//
+// [in] what     - the name of the bulk function
+// [in] input    - the bits of the input
+// [in] result   - the bits of the bulk result
+// [in] expected - the bits of the scalar result
+//
+static void report(const char *what, uint64_t input, uint64_t result, uint64_t expected)
+{
+	if (testFailures++ < 20)
+	{
+		printf("%s(0x%llx) gave 0x%llx, expected 0x%llx\n", what, (unsigned long long)input, (unsigned long long)result,
+			(unsigned long long)expected);
+	}
+}
+
+//
+// Converts the buffered doubles and floats with the bulk functions, checks the results
+// against the scalar conversions and empties the buffers.
+//
+static void check_buffered(void)
+{
+	double_to_sbfp_n(testDoubles, 1, testResults, 1, testCount);
+	double_to_sbfp16_n(testDoubles, 1, testResults16, 1, testCount);
+
+	for (size_t index = 0; index < testCount; ++index)
+	{
+		sbfp_t expected = double_to_sbfp(testDoubles[index]);
+
+		uint64_t dblBits;
+		memcpy(&dblBits, &testDoubles[index], sizeof(dblBits));
+
+		if (testResults[index] != expected)
+		{
+			report("double_to_sbfp_n", dblBits, (uint64_t)testResults[index], (uint64_t)expected);
+		}
+
+		if (testResults16[index] != (sbfp16_t)expected)
+		{
+			report("double_to_sbfp16_n", dblBits, testResults16[index], (uint64_t)expected);
+		}
+	}
+
+	float_to_sbfp_n(testFloats, 1, testResults, 1, testCount);
+	float_to_sbfp16_n(testFloats, 1, testResults16, 1, testCount);
+
+	for (size_t index = 0; index < testCount; ++index)
+	{
+		sbfp_t expected = float_to_sbfp(testFloats[index]);
+
+		uint32_t fltBits;
+		memcpy(&fltBits, &testFloats[index], sizeof(fltBits));
+
+		if (testResults[index] != expected)
+		{
+			report("float_to_sbfp_n", fltBits, (uint64_t)testResults[index], (uint64_t)expected);
+		}
+
+		if (testResults16[index] != (sbfp16_t)expected)
+		{
+			report("float_to_sbfp16_n", fltBits, testResults16[index], (uint64_t)expected);
+		}
+	}
+
+	testCount = 0;
+}
+
+//
+// Adds a double value to the buffers, and the float nearest to it. Full buffers are checked.
+//
+// [in] dblValue - the value
+//
+static void add_value(double dblValue)
+{
+	testDoubles[testCount] = dblValue;
+	testFloats[testCount]  = (float)dblValue;
+
+	if (++testCount == TEST_BLOCK_COUNT)
+	{
+		check_buffered();
+	}
+}
+
+//
+// Gives the magnitude of a finite sbfp pattern, computed rather than decoded, so that
+// 2^-14 is given in the original encoding too.
+//
+// [in] magnitude - the pattern without its sign, from 0 to 0x7BFF
+//
+// Returns the magnitude.
+//
+static double magnitude_value(int magnitude)
+{
+	int expo = magnitude >> SBFP_BIT_COUNT_FRAC;
+	int frac = magnitude & SBFP_FRAC_MASK;
+
+	return (expo == 0) ? ldexp(frac, 1 - SBFP_BIAS - SBFP_BIT_COUNT_FRAC) :
+		ldexp(frac | (1 << SBFP_BIT_COUNT_FRAC), expo - SBFP_BIAS - SBFP_BIT_COUNT_FRAC);
+}
+
+//
+// Checks the bulk decoding of every sbfp pattern against the scalar decoding, bit for bit.
+//
+static void check_decoding(void)
+{
+	static sbfp_t   sbfpValues[1 << 16];
+	static sbfp16_t sbfpValues16[1 << 16];
+	static double   dblResults[1 << 16];
+	static float    fltResults[1 << 16];
+
+	for (int bits = 0; bits < (1 << 16); ++bits)
+	{
+		sbfpValues[bits]   = bits;
+		sbfpValues16[bits] = (sbfp16_t)bits;
+	}
+
+	for (int pass = 0; pass < 2; ++pass)
+	{
+		if (pass == 0)
+		{
+			sbfp_to_double_n(sbfpValues, 1, dblResults, 1, 1 << 16);
+			sbfp_to_float_n(sbfpValues, 1, fltResults, 1, 1 << 16);
+		}
+		else
+		{
+			sbfp16_to_double_n(sbfpValues16, 1, dblResults, 1, 1 << 16);
+			sbfp16_to_float_n(sbfpValues16, 1, fltResults, 1, 1 << 16);
+		}
+
+		for (int bits = 0; bits < (1 << 16); ++bits)
+		{
+			double dblExpected = sbfp_to_double(bits);
+			float  fltExpected = sbfp_to_float(bits);
+
+			uint64_t dblResultBits, dblExpectedBits;
+			uint32_t fltResultBits, fltExpectedBits;
+
+			memcpy(&dblResultBits, &dblResults[bits], sizeof(double));
+			memcpy(&dblExpectedBits, &dblExpected, sizeof(double));
+			memcpy(&fltResultBits, &fltResults[bits], sizeof(float));
+			memcpy(&fltExpectedBits, &fltExpected, sizeof(float));
+
+			if (dblResultBits != dblExpectedBits)
+			{
+				report((pass == 0) ? "sbfp_to_double_n" : "sbfp16_to_double_n", (uint64_t)bits, dblResultBits, dblExpectedBits);
+			}
+
+			if (fltResultBits != fltExpectedBits)
+			{
+				report((pass == 0) ? "sbfp_to_float_n" : "sbfp16_to_float_n", (uint64_t)bits, fltResultBits, fltExpectedBits);
+			}
+		}
+	}
+}
+
+int main(void)
+{
+	printf("backend %s\n", sbfp_backend());
+
+	check_decoding();
+
+	//
+	// Every finite magnitude and the midpoint above it, both signs, and their neighbours:
+	//
+	for (int magnitude = 0; magnitude <= BINARY16_MAX; ++magnitude)
+	{
+		double dblValue = magnitude_value(magnitude);
+		double dblNext  = (magnitude < BINARY16_MAX) ? magnitude_value(magnitude + 1) : 65536.0;
+		double dblMid   = (dblValue + dblNext) / 2.0;
+
+		const double dblInputs[] =
+		{
+			dblValue, nextafter(dblValue, 0.0), nextafter(dblValue, INFINITY),
+			dblMid, nextafter(dblMid, 0.0), nextafter(dblMid, INFINITY),
+			(double)nextafterf((float)dblMid, 0.0F), (double)nextafterf((float)dblMid, INFINITY)
+		};
+
+		for (size_t input = 0; input < sizeof(dblInputs) / sizeof(dblInputs[0]); ++input)
+		{
+			add_value(dblInputs[input]);
+			add_value(-dblInputs[input]);
+		}
+	}
+
+	//
+	// Zeros, infinities, NaN with payloads in the high and low bits, and the overflow limit:
+	//
+	const uint64_t specialBits[] =
+	{
+		0x0000000000000000ULL, 0x8000000000000000ULL, 0x7FF0000000000000ULL, 0xFFF0000000000000ULL,
+		0x7FF8000000000000ULL, 0xFFF8000000000000ULL, 0x7FF0000000000001ULL, 0x7FF0000020000000ULL,
+		0x0000000000000001ULL, 0x7FEFFFFFFFFFFFFFULL, 0x40EFFE0000000000ULL, 0x40EFFDFFFFFFFFFFULL
+	};
+
+	for (size_t special = 0; special < sizeof(specialBits) / sizeof(specialBits[0]); ++special)
+	{
+		double dblValue;
+		memcpy(&dblValue, &specialBits[special], sizeof(dblValue));
+
+		add_value(dblValue);
+	}
+
+	//
+	// Random values: half with random bits, and half with expos around the sbfp range,
+	// whose floats are converted rather than rounded from the doubles:
+	//
+	for (long count = 0; count < TEST_RANDOM_COUNT; ++count)
+	{
+		uint64_t random = next_random();
+
+		if ((count & 1) != 0)
+		{
+			random = (random & 0x800FFFFFFFFFFFFFULL) | ((uint64_t)(DOUBLE_BIAS - 40 + (int)((random >> 52) % 60)) << 52);
+		}
+
+		double dblValue;
+		memcpy(&dblValue, &random, sizeof(dblValue));
+
+		uint32_t fltBits = (uint32_t)(random >> 11) ^ (uint32_t)random;
+
+		if ((count & 1) != 0)
+		{
+			fltBits = (fltBits & 0x807FFFFFU) | ((uint32_t)(FLOAT_BIAS - 30 + (int)((random >> 32) % 50)) << 23);
+		}
+
+		testDoubles[testCount] = dblValue;
+		memcpy(&testFloats[testCount], &fltBits, sizeof(fltBits));
+
+		if (++testCount == TEST_BLOCK_COUNT)
+		{
+			check_buffered();
+		}
+	}
+
+	check_buffered();
+
+	printf("%ld failure(s)\n", testFailures);
+
+	return (testFailures == 0) ? 0 : 1;
+}
@@ -0,0 +1,173 @@
+//
+// test/test_div.c
+//
+// This file checks sbfp_div, whose reciprocal table must give the correctly rounded
+// quotient for every divisor. Every dividend is divided by every divisor, and the quotient
+// must be the exact quotient rounded by double_to_sbfp_round: a double holds more than twice
+// the significant bits of an sbfp value, so rounding the double quotient again gives the
+// same result. The functions without a mode are checked for every pair, and the other
+// modes for every 16th dividend. sbfp_div_n and sbfp16_div_n must give the scalar results,
+// with the divisor repeated by a stride of 0.
+//
+// Build and run from the repository root:
+//
+//     cc -O2 -I. test/test_div.c sbfp_lib.c sbfp_fp8.c sbfp_bf16.c sbfp_x86.c -lm -o test_div
+//     ./test_div
+//
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2021 Luke Andrews.  All Rights Reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify, merge,
+// publish, distribute, sub-license, and/or sell copies of the Software, and to permit persons
+// to whom the Software is furnished to do so, subject to the following conditions:
+//
+// * The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+// PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+#include "sbfp_const.h"
+#include "sbfp_lib.h"
+#include <math.h>
+#include <stdio.h>
+
+static sbfp_t   testDividends[1 << 16];
+static sbfp16_t testDividends16[1 << 16];
+static double   testValues[1 << 16]; // the values of the patterns, indexed by pattern
+static sbfp_t   testQuotients[1 << 16];
+static sbfp16_t testQuotients16[1 << 16];
+
+static long testFailures;
+
+//
+// Reports a quotient that differs from the expected one, for the first few failures.
+//
+// [in] what     - the name of the function
+// [in] mode     - the rounding mode, or -1 for the function without a mode
+// [in] dividend - the dividend
+// [in] divisor  - the divisor
+// [in] quotient - the quotient given
+// [in] expected - the quotient expected
+//
+static void report(const char *what, int mode, int dividend, int divisor, int quotient, int expected)
+{
+	if (testFailures++ < 20)
+	{
+		printf("%s (mode %d): 0x%04X / 0x%04X gave 0x%04X, expected 0x%04X\n", what, mode, (unsigned)dividend, (unsigned)divisor,
+			(unsigned)quotient, (unsigned)expected);
+	}
+}
+
+//
+// Gives the value of an IEEE binary16 pattern.
+//
+// [in] bits - the pattern
+//
+// Returns the value.
+//
+static double binary16_value(int bits)
+{
+	int expo = (bits >> SBFP_BIT_COUNT_FRAC) & SBFP_EXPO_MASK;
+	int frac = bits & SBFP_FRAC_MASK;
+
+	double dblValue = (expo == SBFP_EXPO_MASK) ? ((frac == 0) ? INFINITY : NAN) :
+		(expo == 0) ? ldexp(frac, 1 - SBFP_BIAS - SBFP_BIT_COUNT_FRAC) :
+		ldexp(frac | (1 << SBFP_BIT_COUNT_FRAC), expo - SBFP_BIAS - SBFP_BIT_COUNT_FRAC);
+
+	return ((bits >> (SBFP_BIT_COUNT_EXPO + SBFP_BIT_COUNT_FRAC)) & 1) ? -dblValue : dblValue;
+}
+
+//
+// Checks a quotient against the exact quotient rounded in a given mode.
+//
+// [in] mode     - the rounding mode, or -1 for the function without a mode
+// [in] dividend - the dividend
+// [in] divisor  - the divisor
+// [in] quotient - the quotient given
+//
+static void check_quotient(int mode, int dividend, int divisor, sbfp_t quotient)
+{
+	double dblQuotient = testValues[dividend] / testValues[divisor];
+	sbfp_t expected    = double_to_sbfp_round((mode < 0) ? SBFP_ROUND_NEAREST_EVEN : mode, dblQuotient);
+
+	if (quotient != expected)
+	{
+		report((mode < 0) ? "sbfp_div" : "sbfp_div_round", mode, dividend, divisor, quotient, expected);
+	}
+}
+
+int main(void)
+{
+	static const int modes[] =
+	{
+		SBFP_ROUND_TOWARD_ZERO, SBFP_ROUND_UPWARD, SBFP_ROUND_DOWNWARD, SBFP_ROUND_TRUNCATE
+	};
+
+	//
+	// The values of the patterns, as the arithmetic reads them, which in the original
+	// encoding is as its translation to binary16:
+	//
+	for (int bits = 0; bits < (1 << 16); ++bits)
+	{
+		testDividends[bits]   = bits;
+		testDividends16[bits] = (sbfp16_t)bits;
+	}
+
+#ifdef SBFP_IEEE_BINARY16
+	sbfp_to_sbfp16_n(testDividends, 1, testQuotients16, 1, 1 << 16);
+#else
+	sbfp_legacy_to_binary16_n(testDividends16, 1, testQuotients16, 1, 1 << 16);
+#endif
+
+	for (int bits = 0; bits < (1 << 16); ++bits)
+	{
+		testValues[bits] = binary16_value(testQuotients16[bits]);
+	}
+
+	for (int divisor = 0; divisor < (1 << 16); ++divisor)
+	{
+		sbfp_t   divisors[1]   = { divisor };
+		sbfp16_t divisors16[1] = { (sbfp16_t)divisor };
+
+		sbfp_div_n(testDividends, 1, divisors, 0, testQuotients, 1, 1 << 16);
+		sbfp16_div_n(testDividends16, 1, divisors16, 0, testQuotients16, 1, 1 << 16);
+
+		for (int dividend = 0; dividend < (1 << 16); ++dividend)
+		{
+			sbfp_t quotient = sbfp_div(dividend, divisor);
+
+			check_quotient(-1, dividend, divisor, quotient);
+
+			if (testQuotients[dividend] != quotient)
+			{
+				report("sbfp_div_n", -1, dividend, divisor, testQuotients[dividend], quotient);
+			}
+
+			if (testQuotients16[dividend] != (sbfp16_t)quotient)
+			{
+				report("sbfp16_div_n", -1, dividend, divisor, testQuotients16[dividend], quotient);
+			}
+		}
+
+		for (size_t mode = 0; mode < sizeof(modes) / sizeof(modes[0]); ++mode)
+		{
+			for (int dividend = divisor & 15; dividend < (1 << 16); dividend += 16)
+			{
+				check_quotient(modes[mode], dividend, divisor, sbfp_div_round(modes[mode], dividend, divisor));
+			}
+		}
+	}
+
+	printf("%ld failure(s)\n", testFailures);
+
+	return (testFailures == 0) ? 0 : 1;
+}
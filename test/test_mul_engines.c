@@ -0,0 +1,71 @@
+//
+// test/test_mul_engines.c
+//
+// This file checks that the two multiplication engines (see sbfp_mul_init) give the same
+// results. Every one of the 2^32 pairs of sbfp patterns is multiplied with the arithmetic
+// engine and with the table engine, and the products must match bit for bit. The engine
+// is switched once per multiplicand, as a caller may switch it at any time.
+//
+// Build and run from the repository root:
+//
+//     cc -O2 -I. test/test_mul_engines.c sbfp_lib.c sbfp_fp8.c sbfp_bf16.c sbfp_x86.c -lm -o test_mul_engines
+//     ./test_mul_engines
+//
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2021 Luke Andrews.  All Rights Reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify, merge,
+// publish, distribute, sub-license, and/or sell copies of the Software, and to permit persons
+// to whom the Software is furnished to do so, subject to the following conditions:
+//
+// * The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+// PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+#include "sbfp_const.h"
+#include "sbfp_lib.h"
+#include <stdio.h>
+
+int main(void)
+{
+	static sbfp_t products[1 << 16];
+
+	long failures = 0;
+
+	for (int bits1 = 0; bits1 < (1 << 16); ++bits1)
+	{
+		sbfp_mul_init(SBFP_MUL_ENGINE_ARITHMETIC);
+
+		for (int bits2 = 0; bits2 < (1 << 16); ++bits2)
+		{
+			products[bits2] = sbfp_mul(bits1, bits2);
+		}
+
+		sbfp_mul_init(SBFP_MUL_ENGINE_TABLE);
+
+		for (int bits2 = 0; bits2 < (1 << 16); ++bits2)
+		{
+			sbfp_t product = sbfp_mul(bits1, bits2);
+
+			if (product != products[bits2] && failures++ < 20)
+			{
+				printf("sbfp_mul(0x%04X, 0x%04X) gave 0x%04X with the table, 0x%04X with arithmetic\n", (unsigned)bits1,
+					(unsigned)bits2, (unsigned)product, (unsigned)products[bits2]);
+			}
+		}
+	}
+
+	printf("%ld failure(s)\n", failures);
+
+	return (failures == 0) ? 0 : 1;
+}
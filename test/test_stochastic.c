@@ -0,0 +1,133 @@
+//
+// test/test_stochastic.c
+//
+// This file checks that stochastic rounding is unbiased. Each value is converted many
+// times, as a double and as a float, and the mean of the results must match the value to
+// within the spread that the number of conversions allows. The values include some far
+// below the smallest sbfp subnormal, which must almost never round up.
+//
+// Build and run from the repository root:
+//
+//     cc -O2 -I. test/test_stochastic.c sbfp_lib.c sbfp_fp8.c sbfp_bf16.c sbfp_x86.c -lm -o test_stochastic
+//     ./test_stochastic
+//
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2021 Luke Andrews.  All Rights Reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this
+// software and associated documentation files (the "Software"), to deal in the Software
+// without restriction, including without limitation the rights to use, copy, modify, merge,
+// publish, distribute, sub-license, and/or sell copies of the Software, and to permit persons
+// to whom the Software is furnished to do so, subject to the following conditions:
+//
+// * The above copyright notice and this permission notice shall be included in all copies or
+// substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+// PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR 
+// OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+#include "sbfp_const.h"
+#include "sbfp_lib.h"
+#include <math.h>
+#include <stdio.h>
+
+// Conversions per value:
+#define TEST_COUNT (1 << 22)
+
+static double testDoubles[TEST_COUNT];
+static float  testFloats[TEST_COUNT];
+static sbfp_t testResults[TEST_COUNT];
+
+//
+// Checks the mean of stochastic conversions of a given positive value against the value.
+// A result is either the value truncated or the next sbfp value up, the latter with a
+// probability of the value's fraction of the gap between them, so the mean may differ from
+// the value by six standard deviations of that choice, plus one gap per TEST_COUNT.
+//
+// [in] what     - the name of the conversion, for the report
+// [in] dblValue - the value, which both conversions hold exactly
+// [in] results  - the results of converting it TEST_COUNT times
+//
+// Returns 0 if the mean matches, or 1 if it does not.
+//
+static int check_mean(const char *what, double dblValue, const sbfp_t *results)
+{
+	int status = 0;
+
+	double dblLow  = sbfp_to_double(double_to_sbfp_round(SBFP_ROUND_TOWARD_ZERO, dblValue));
+	double dblHigh = sbfp_to_double(double_to_sbfp_round(SBFP_ROUND_UPWARD, dblValue));
+	double dblGap  = dblHigh - dblLow;
+
+	double dblSum = 0.0;
+
+	for (size_t index = 0; index < TEST_COUNT; ++index)
+	{
+		dblSum += sbfp_to_double(results[index]);
+	}
+
+	double dblMean = dblSum / TEST_COUNT;
+
+	if (dblGap > 0.0)
+	{
+		double p         = (dblValue - dblLow) / dblGap;
+		double tolerance = dblGap * (6.0 * sqrt(p * (1.0 - p) / TEST_COUNT) + 1.0 / TEST_COUNT);
+
+		if (fabs(dblMean - dblValue) > tolerance)
+		{
+			status = 1;
+		}
+
+		printf("%-6s %-14a mean/value %.6f  probability of rounding up %.3g  %s\n", what, dblValue,
+			dblMean / dblValue, p, (status == 0) ? "ok" : "FAILED");
+	}
+
+	return status;
+}
+
+int main(void)
+{
+	int failures = 0;
+
+	//
+	// Values far below the sbfp range (including the smallest double subnormal and float
+	// subnormals), in the sbfp subnormals, and in the normals:
+	//
+	static const double dblValues[] =
+	{
+		1e-30, 4.9406564584124654e-324, 0x1p-140, 0x1p-126, 0x1p-40, 0x1p-33, 0x1p-26, 0x1.8p-25,
+		3e-8, 1e-6, 0.1, 1000.3
+	};
+
+	sbfp_seed_stochastic(1);
+
+	for (size_t value = 0; value < sizeof(dblValues) / sizeof(dblValues[0]); ++value)
+	{
+		double dblValue = dblValues[value];
+		float  fltValue = (float)dblValue;
+
+		for (size_t index = 0; index < TEST_COUNT; ++index)
+		{
+			testDoubles[index] = dblValue;
+			testFloats[index]  = fltValue;
+		}
+
+		double_to_sbfp_stochastic_n(testDoubles, 1, testResults, 1, TEST_COUNT);
+		failures += check_mean("double", dblValue, testResults);
+
+		if (fltValue != 0.0F)
+		{
+			float_to_sbfp_stochastic_n(testFloats, 1, testResults, 1, TEST_COUNT);
+			failures += check_mean("float", (double)fltValue, testResults);
+		}
+	}
+
+	printf("%d failure(s)\n", failures);
+
+	return (failures == 0) ? 0 : 1;
+}